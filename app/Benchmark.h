@@ -0,0 +1,117 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+#include <PDPC/Common/Log.h>
+#include <PDPC/Common/Timer.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Benchmark harness shared by the pdpcBenchmark* apps
+
+//! \brief pair_hash mixes a query and a value with the splitmix64 finalizer
+inline uint64_t pair_hash(uint64_t query, uint64_t value)
+{
+    uint64_t z = query * 0x9E3779B97F4A7C15ull + value;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+//!
+//! \brief neighbor_hash hashes a neighbor of a query, the sum of the hashes
+//! of the neighbors does not depend on their order
+//!
+inline uint64_t neighbor_hash(pdpc::Index query, pdpc::Index neighbor)
+{
+    return pair_hash(uint64_t(query), uint64_t(neighbor));
+}
+
+//!
+//! \brief distance_hash hashes the squared distance of a neighbor to a query
+//!
+//! The distances are hashed rather than the indices so that neighbors at the
+//! same distance as the k-th one, which depend on the visiting order, do not
+//! change the hash.
+//!
+inline uint64_t distance_hash(pdpc::Index query, pdpc::Scalar squared_distance)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &squared_distance, sizeof(bits));
+    return pair_hash(uint64_t(query), bits);
+}
+
+//!
+//! \brief benchmark_queries runs the queries of the given points with f and
+//! prints the throughput
+//!
+//! f(q, count, hash) adds the neighbor count and the sum of the neighbor
+//! hashes of the query q. The first benchmark of a series sets the reference
+//! time and hash.
+//!
+template<class FuncT>
+void benchmark_queries(const std::string& name, const std::vector<pdpc::Index>& queries, int repeat,
+                       pdpc::Scalar& reference_time, uint64_t& reference_hash, FuncT&& f)
+{
+    using pdpc::Scalar;
+
+    const int query_count = queries.size();
+
+    Scalar   time  = std::numeric_limits<Scalar>::max();
+    uint64_t count = 0;
+    uint64_t hash  = 0;
+    for(int r=0; r<repeat; ++r)
+    {
+        count = 0;
+        hash  = 0;
+        pdpc::Timer timer;
+        #pragma omp parallel for reduction(+:count,hash) schedule(dynamic,256)
+        for(int q=0; q<query_count; ++q)
+            f(queries[q], count, hash);
+        time = std::min(time, Scalar(timer.time_sec()));
+    }
+
+    if(reference_time < 0)
+    {
+        reference_time = time;
+        reference_hash = hash;
+    }
+
+    pdpc::info() << "  " << name << ": " << query_count / time << " queries/s"
+                 << " (speedup " << reference_time / time << ", " << Scalar(count) / std::max(1, query_count) << " neighbors/query"
+                 << (hash == reference_hash ? ", same neighbors" : ", DIFFERENT NEIGHBORS") << ")";
+}
+
+//!
+//! \brief benchmark_batch runs f, which answers query_count queries at once
+//! and returns the sum of their neighbor hashes, and prints its time
+//!
+template<class FuncT>
+void benchmark_batch(const std::string& name, pdpc::Index query_count, int repeat,
+                     pdpc::Scalar& reference_time, uint64_t& reference_hash, FuncT&& f)
+{
+    using pdpc::Scalar;
+
+    Scalar   time = std::numeric_limits<Scalar>::max();
+    uint64_t hash = 0;
+    for(int r=0; r<repeat; ++r)
+    {
+        pdpc::Timer timer;
+        hash = f();
+        time = std::min(time, Scalar(timer.time_sec()));
+    }
+
+    if(reference_time < 0)
+    {
+        reference_time = time;
+        reference_hash = hash;
+    }
+
+    pdpc::info() << "  " << name << ": " << time << " s, " << query_count / time << " queries/s"
+                 << " (speedup " << reference_time / time
+                 << (hash == reference_hash ? ", same neighbors" : ", DIFFERENT NEIGHBORS") << ")";
+}
@@ -0,0 +1,126 @@
+#include <PDPC/Common/Option.h>
+#include <PDPC/Common/Log.h>
+#include <PDPC/Common/Timer.h>
+#include <PDPC/PointCloud/Loader.h>
+#include <PDPC/PointCloud/PointCloud.h>
+#include <PDPC/SpacePartitioning/KdTree.h>
+#include <PDPC/SpacePartitioning/HashGrid.h>
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace pdpc;
+
+int main(int argc, char **argv)
+{
+    Option opt(argc, argv);
+    const std::string  in_input   = opt.get_string("input", "i").set_default("")     .set_brief("Input point cloud (.ply/.obj), random points by default");
+    const int          in_count   = opt.get_int(   "count", "n").set_default(1000000).set_brief("Count of random points");
+    const int          in_repeat  = opt.get_int(   "repeat"    ).set_default(3)      .set_brief("Repetition count (the best time is kept)");
+    const int          in_queries = opt.get_int(   "queries", "q").set_default(100000).set_brief("Count of query points");
+    std::vector<float> in_radii   = opt.get_floats("radii"     ).set_brief("Range query radii as factors of the mean nearest neighbor distance ([ 2 4 8 16 ] by default)");
+    const bool         in_v       = opt.get_bool(  "verbose", "v").set_default(false).set_brief("Add verbose messages");
+
+    bool ok = opt.ok();
+    if(!ok) return 1;
+
+    PointCloud points;
+    if(in_input.empty())
+    {
+        points.set_random(in_count);
+    }
+    else
+    {
+        ok = Loader::Load(in_input, points, in_v);
+        if(!ok) return 1;
+    }
+
+    const int repeat = std::max(1, in_repeat);
+
+    KdTree kdtree;
+    Scalar kdtree_time = std::numeric_limits<Scalar>::max();
+    for(int r=0; r<repeat; ++r)
+    {
+        Timer timer;
+        kdtree.build(points.points_ptr());
+        kdtree_time = std::min(kdtree_time, Scalar(timer.time_sec()));
+    }
+    info() << points.size() << " points, kd-tree built in " << kdtree_time << " s";
+
+    // queries spread over the points
+    const int point_count = points.size();
+    std::vector<Index> queries(std::min(in_queries, point_count));
+    for(int q=0; q<int(queries.size()); ++q)
+        queries[q] = Index(int64_t(q) * point_count / queries.size());
+
+    Scalar spacing = 0;
+    #pragma omp parallel for reduction(+:spacing)
+    for(int q=0; q<int(queries.size()); ++q)
+        spacing += kdtree.nearest_neighbor(queries[q]).search().distance();
+    spacing /= std::max(1, int(queries.size()));
+
+    if(in_radii.empty()) in_radii = {2, 4, 8, 16};
+
+    info() << queries.size() << " queries, mean nearest neighbor distance = " << spacing;
+
+    for(float factor : in_radii)
+    {
+        const Scalar radius = factor * spacing;
+
+        // the cells have the size of the radius
+        HashGrid grid;
+        Scalar grid_time = std::numeric_limits<Scalar>::max();
+        for(int r=0; r<repeat; ++r)
+        {
+            Timer timer;
+            grid.build(points.points_ptr(), radius);
+            grid_time = std::min(grid_time, Scalar(timer.time_sec()));
+        }
+        info() << "range queries, r = " << radius << ", hash grid built in " << grid_time << " s"
+               << " (" << grid.cell_count() << " cells)";
+
+        Scalar   reference_time = -1;
+        uint64_t reference_hash = 0;
+
+        benchmark_queries("kd-tree", queries, repeat, reference_time, reference_hash,
+                        [&](Index q, uint64_t& count, uint64_t& hash)
+        {
+            for(Index j : kdtree.range_neighbors(q, radius))
+            {
+                hash += neighbor_hash(q, j);
+                ++count;
+            }
+        });
+        benchmark_queries("kd-tree visitor", queries, repeat, reference_time, reference_hash,
+                        [&](Index q, uint64_t& count, uint64_t& hash)
+        {
+            kdtree.for_each_in_range(q, radius, [&](Index j, Scalar)
+            {
+                hash += neighbor_hash(q, j);
+                ++count;
+            });
+        });
+        benchmark_queries("hash grid", queries, repeat, reference_time, reference_hash,
+                        [&](Index q, uint64_t& count, uint64_t& hash)
+        {
+            for(Index j : grid.range_neighbors(q, radius))
+            {
+                hash += neighbor_hash(q, j);
+                ++count;
+            }
+        });
+        benchmark_queries("hash grid visitor", queries, repeat, reference_time, reference_hash,
+                        [&](Index q, uint64_t& count, uint64_t& hash)
+        {
+            grid.for_each_in_range(q, radius, [&](Index j, Scalar)
+            {
+                hash += neighbor_hash(q, j);
+                ++count;
+            });
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,264 @@
+#include <PDPC/Common/Option.h>
+#include <PDPC/Common/Log.h>
+#include <PDPC/Common/Timer.h>
+#include <PDPC/Common/Cpu.h>
+#include <PDPC/PointCloud/Loader.h>
+#include <PDPC/PointCloud/PointCloud.h>
+#include <PDPC/SpacePartitioning/KdTree.h>
+
+#include <algorithm>
+#include <limits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace pdpc;
+
+bool same_tree(const KdTree& kdtree, const KdTree& other);
+
+//!
+//! \brief benchmark_queries runs the queries from the given points and prints
+//! the throughput of each instruction set of the leaf scan kernel
+//!
+//! range_radius > 0 runs range queries, k > 0 runs k-nearest queries.
+//!
+void benchmark_queries(const KdTree& kdtree, const std::vector<Index>& queries,
+                       Scalar range_radius, int k, int repeat);
+
+int main(int argc, char **argv)
+{
+    Option opt(argc, argv);
+    const std::string in_input  = opt.get_string("input", "i").set_default("")     .set_brief("Input point cloud (.ply/.obj), random points by default");
+    const int         in_count  = opt.get_int(   "count", "n").set_default(1000000).set_brief("Count of random points");
+    const int         in_repeat = opt.get_int(   "repeat"    ).set_default(3)      .set_brief("Repetition count (the best time is kept)");
+    const int         in_queries = opt.get_int(  "queries", "q").set_default(100000).set_brief("Count of query points (0 to only benchmark the build)");
+    std::vector<float> in_radii  = opt.get_floats("radii"     ).set_brief("Range query radii as factors of the mean nearest neighbor distance ([ 2 4 8 ] by default)");
+    std::vector<int>   in_knn    = opt.get_ints(  "knn"       ).set_brief("Neighbors counts of the k-nearest queries ([ 10 50 ] by default)");
+    const bool        in_v      = opt.get_bool(  "verbose", "v").set_default(false).set_brief("Add verbose messages");
+
+    bool ok = opt.ok();
+    if(!ok) return 1;
+
+    PointCloud points;
+    if(in_input.empty())
+    {
+        points.set_random(in_count);
+    }
+    else
+    {
+        ok = Loader::Load(in_input, points, in_v);
+        if(!ok) return 1;
+    }
+
+    // powers of 2 up to the max thread count
+#ifdef _OPENMP
+    const int thread_max = omp_get_max_threads();
+#else
+    const int thread_max = 1;
+#endif
+    std::vector<int> thread_counts;
+    for(int thread_count=1; thread_count<thread_max; thread_count*=2)
+        thread_counts.push_back(thread_count);
+    thread_counts.push_back(thread_max);
+
+    info() << points.size() << " points, up to " << thread_max << " threads";
+
+    KdTree reference;
+    Scalar reference_time = 0;
+    for(int thread_count : thread_counts)
+    {
+#ifdef _OPENMP
+        omp_set_num_threads(thread_count);
+#endif
+
+        KdTree kdtree;
+        Scalar time = std::numeric_limits<Scalar>::max();
+        for(int r=0; r<std::max(1, in_repeat); ++r)
+        {
+            Timer timer;
+            kdtree.build(points.points_ptr());
+            time = std::min(time, Scalar(timer.time_sec()));
+        }
+
+        if(thread_count == 1)
+        {
+            reference      = kdtree;
+            reference_time = time;
+        }
+
+        info() << "  " << thread_count << " threads: " << time << " s"
+               << " (speedup " << reference_time / time << ", " << kdtree.node_count() << " nodes"
+               << (same_tree(kdtree, reference) ? ", same tree" : ", DIFFERENT TREE") << ")";
+    }
+#ifdef _OPENMP
+    omp_set_num_threads(thread_max);
+#endif
+
+    if(in_queries <= 0) return 0;
+
+    // queries spread over the points
+    const int point_count = points.size();
+    std::vector<Index> queries(std::min(in_queries, point_count));
+    for(int q=0; q<int(queries.size()); ++q)
+        queries[q] = Index(int64_t(q) * point_count / queries.size());
+
+    Scalar spacing = 0;
+    #pragma omp parallel for reduction(+:spacing)
+    for(int q=0; q<int(queries.size()); ++q)
+        spacing += reference.nearest_neighbor(queries[q]).search().distance();
+    spacing /= std::max(1, int(queries.size()));
+
+    if(in_radii.empty()) in_radii = {2, 4, 8};
+    if(in_knn.empty())   in_knn   = {10, 50};
+
+    info() << queries.size() << " queries, mean nearest neighbor distance = " << spacing
+           << ", cpu instruction set = " << simd_level_name(cpu_simd_level());
+
+    for(float factor : in_radii)
+        benchmark_queries(reference, queries, factor * spacing, 0, in_repeat);
+    for(int k : in_knn)
+        benchmark_queries(reference, queries, 0, k, in_repeat);
+
+    return 0;
+}
+
+void benchmark_queries(const KdTree& kdtree, const std::vector<Index>& queries,
+                       Scalar range_radius, int k, int repeat)
+{
+    const int query_count = queries.size();
+
+    if(range_radius > 0)
+        info() << "range queries, r = " << range_radius;
+    else
+        info() << k << "-nearest queries";
+
+    const SimdLevel cpu_level = cpu_simd_level();
+    const SimdLevel levels[] = {SimdLevel::None, SimdLevel::AVX2, SimdLevel::AVX512};
+
+    Scalar   reference_time = 0;
+    uint64_t reference_hash = 0;
+    for(SimdLevel level : levels)
+    {
+        if(level > cpu_level) break;
+        set_simd_level(level);
+
+        Scalar   time  = std::numeric_limits<Scalar>::max();
+        uint64_t count = 0;
+        uint64_t hash  = 0;
+        for(int r=0; r<std::max(1, repeat); ++r)
+        {
+            count = 0;
+            hash  = 0;
+            Timer timer;
+            #pragma omp parallel for reduction(+:count,hash) schedule(dynamic,256)
+            for(int q=0; q<query_count; ++q)
+            {
+                // the neighbors and their order are hashed to compare the instruction sets
+                uint64_t h = queries[q];
+                if(range_radius > 0)
+                {
+                    for(Index j : kdtree.range_neighbors(queries[q], range_radius))
+                    {
+                        h = h * 1000003 + j;
+                        ++count;
+                    }
+                }
+                else
+                {
+                    for(Index j : kdtree.k_nearest_neighbors(queries[q], k))
+                    {
+                        h = h * 1000003 + j;
+                        ++count;
+                    }
+                }
+                hash += h;
+            }
+            time = std::min(time, Scalar(timer.time_sec()));
+        }
+
+        if(level == SimdLevel::None)
+        {
+            reference_time = time;
+            reference_hash = hash;
+        }
+
+        info() << "  " << simd_level_name(level) << ": " << query_count / time << " queries/s"
+               << " (speedup " << reference_time / time << ", " << Scalar(count) / std::max(1, query_count) << " neighbors/query"
+               << (hash == reference_hash ? ", same neighbors" : ", DIFFERENT NEIGHBORS") << ")";
+    }
+    set_simd_level(cpu_level);
+
+    // same range queries with the visitor traversal
+    if(range_radius > 0)
+    {
+        Scalar   time  = std::numeric_limits<Scalar>::max();
+        uint64_t count = 0;
+        uint64_t hash  = 0;
+        for(int r=0; r<std::max(1, repeat); ++r)
+        {
+            count = 0;
+            hash  = 0;
+            Timer timer;
+            #pragma omp parallel for reduction(+:count,hash) schedule(dynamic,256)
+            for(int q=0; q<query_count; ++q)
+            {
+                uint64_t h = queries[q];
+                kdtree.for_each_in_range(queries[q], range_radius, [&h,&count](Index j, Scalar)
+                {
+                    h = h * 1000003 + j;
+                    ++count;
+                });
+                hash += h;
+            }
+            time = std::min(time, Scalar(timer.time_sec()));
+        }
+
+        info() << "  visitor " << simd_level_name(cpu_level) << ": " << query_count / time << " queries/s"
+               << " (speedup " << reference_time / time << ", " << Scalar(count) / std::max(1, query_count) << " neighbors/query"
+               << (hash == reference_hash ? ", same neighbors" : ", DIFFERENT NEIGHBORS") << ")";
+    }
+
+    // same queries in one batch
+    Scalar time = std::numeric_limits<Scalar>::max();
+    NeighborLists lists;
+    for(int r=0; r<std::max(1, repeat); ++r)
+    {
+        Timer timer;
+        lists = range_radius > 0 ? kdtree.batch_range(queries, range_radius) : kdtree.batch_knn(queries, k);
+        time = std::min(time, Scalar(timer.time_sec()));
+    }
+
+    uint64_t hash = 0;
+    for(int q=0; q<query_count; ++q)
+    {
+        uint64_t h = queries[q];
+        for(Index j : lists.neighbors(q))
+            h = h * 1000003 + j;
+        hash += h;
+    }
+
+    info() << "  batch " << simd_level_name(cpu_level) << ": " << query_count / time << " queries/s"
+           << " (speedup " << reference_time / time << ", " << Scalar(lists.neighbor_count()) / std::max(1, query_count) << " neighbors/query"
+           << (hash == reference_hash ? ", same neighbors" : ", DIFFERENT NEIGHBORS") << ")";
+}
+
+bool same_tree(const KdTree& kdtree, const KdTree& other)
+{
+    if(kdtree.index_data() != other.index_data() || kdtree.node_count() != other.node_count())
+        return false;
+
+    for(int n=0; n<kdtree.node_count(); ++n)
+    {
+        const KdTreeNode& node1 = kdtree.node_data()[n];
+        const KdTreeNode& node2 = other.node_data()[n];
+        if(node1.leaf != node2.leaf)
+            return false;
+        if(node1.leaf && (node1.start != node2.start || node1.size != node2.size))
+            return false;
+        if(!node1.leaf && (node1.dim != node2.dim || node1.splitValue != node2.splitValue ||
+                           node1.firstChildId != node2.firstChildId))
+            return false;
+    }
+    return true;
+}
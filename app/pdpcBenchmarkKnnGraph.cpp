@@ -0,0 +1,159 @@
+#include <PDPC/Common/Option.h>
+#include <PDPC/Common/Log.h>
+#include <PDPC/Common/Timer.h>
+#include <PDPC/PointCloud/Loader.h>
+#include <PDPC/PointCloud/PointCloud.h>
+#include <PDPC/SpacePartitioning/KdTree.h>
+#include <PDPC/SpacePartitioning/KnnGraph.h>
+
+#include "Benchmark.h"
+
+#include <algorithm>
+
+using namespace pdpc;
+
+//!
+//! \brief list_hash sums the hashes of the neighbors of lists, whose query q
+//! is the point queries[q]
+//!
+uint64_t list_hash(const NeighborLists& lists, const std::vector<Index>& queries);
+
+int main(int argc, char **argv)
+{
+    Option opt(argc, argv);
+    const std::string in_input   = opt.get_string("input", "i").set_default("")     .set_brief("Input point cloud (.ply/.obj), random points by default");
+    const int         in_count   = opt.get_int(   "count", "n").set_default(1000000).set_brief("Count of random points");
+    const int         in_repeat  = opt.get_int(   "repeat"    ).set_default(3)      .set_brief("Repetition count (the best time is kept)");
+    std::vector<int>  in_knn     = opt.get_ints(  "knn"       ).set_brief("Neighbors counts ([ 10 20 30 40 50 ] by default)");
+    const int         in_queries = opt.get_int(   "queries", "q").set_default(10000).set_brief("Count of range queries on the kNN graph of the largest k");
+    const float       in_radius  = opt.get_float( "radius", "r").set_default(2)     .set_brief("Radius of the range queries as a factor of the mean nearest neighbor distance");
+    const bool        in_v       = opt.get_bool(  "verbose", "v").set_default(false).set_brief("Add verbose messages");
+
+    bool ok = opt.ok();
+    if(!ok) return 1;
+
+    PointCloud points;
+    if(in_input.empty())
+    {
+        points.set_random(in_count);
+    }
+    else
+    {
+        ok = Loader::Load(in_input, points, in_v);
+        if(!ok) return 1;
+    }
+
+    const int repeat = std::max(1, in_repeat);
+
+    KdTree kdtree;
+    kdtree.build(points.points_ptr());
+
+    const Index point_count = points.size();
+    info() << point_count << " points";
+
+    if(in_knn.empty()) in_knn = {10, 20, 30, 40, 50};
+
+    for(int k : in_knn)
+    {
+        info() << "k = " << k;
+
+        Scalar   reference_time = -1;
+        uint64_t reference_hash = 0;
+
+        // one independent query per point, in the order of the points
+        benchmark_batch("per-point queries", point_count, repeat, reference_time, reference_hash, [&]()
+        {
+            uint64_t hash = 0;
+            #pragma omp parallel for reduction(+:hash) schedule(dynamic,256)
+            for(Index q=0; q<point_count; ++q)
+            {
+                auto query = kdtree.k_nearest_neighbors(q, k);
+                for(const IndexSquaredDistance& neighbor : query.search())
+                {
+                    if(neighbor.index >= 0)
+                        hash += distance_hash(q, neighbor.squared_distance);
+                }
+            }
+            return hash;
+        });
+        benchmark_batch("batch in leaf order", point_count, repeat, reference_time, reference_hash, [&]()
+        {
+            return list_hash(kdtree.batch_knn(kdtree.index_data(), k, true), kdtree.index_data());
+        });
+        benchmark_batch("all kNN", point_count, repeat, reference_time, reference_hash, [&]()
+        {
+            return list_hash(kdtree.all_knn(k, true), kdtree.index_data());
+        });
+    }
+
+    // range queries on the graph of the largest k
+    {
+        KnnGraph graph(*std::max_element(in_knn.begin(), in_knn.end()));
+        graph.build(kdtree);
+
+        std::vector<int> queries(std::min(in_queries, int(point_count)));
+        for(int q=0; q<int(queries.size()); ++q)
+            queries[q] = int(int64_t(q) * point_count / queries.size());
+
+        Scalar spacing = 0;
+        #pragma omp parallel for reduction(+:spacing)
+        for(int q=0; q<int(queries.size()); ++q)
+            spacing += kdtree.nearest_neighbor(queries[q]).search().distance();
+        spacing /= std::max(1, int(queries.size()));
+
+        const Scalar radius = in_radius * spacing;
+        const std::vector<Index> query_indices(queries.begin(), queries.end());
+        info() << "kNN graph range queries, k = " << graph.k() << ", r = " << radius;
+
+        Scalar   reference_time = -1;
+        uint64_t reference_hash = 0;
+
+        const Vector3Array& pts = graph.point_data();
+        benchmark_batch("new query per point", queries.size(), repeat, reference_time, reference_hash, [&]()
+        {
+            uint64_t hash = 0;
+            #pragma omp parallel for reduction(+:hash) schedule(dynamic,64)
+            for(int q=0; q<int(queries.size()); ++q)
+            {
+                for(int j : graph.range_neighbors(queries[q], radius))
+                    hash += distance_hash(queries[q], (pts[j] - pts[queries[q]]).squaredNorm());
+            }
+            return hash;
+        });
+        benchmark_batch("reused query", queries.size(), repeat, reference_time, reference_hash, [&]()
+        {
+            uint64_t hash = 0;
+            #pragma omp parallel reduction(+:hash)
+            {
+                auto query = graph.range_query(radius);
+                #pragma omp for schedule(dynamic,64)
+                for(int q=0; q<int(queries.size()); ++q)
+                {
+                    query.set_index(queries[q]);
+                    for(int j : query)
+                        hash += distance_hash(queries[q], (pts[j] - pts[queries[q]]).squaredNorm());
+                }
+            }
+            return hash;
+        });
+        benchmark_batch("batch", queries.size(), repeat, reference_time, reference_hash, [&]()
+        {
+            return list_hash(graph.batch_range(queries, radius, true), query_indices);
+        });
+    }
+
+    return 0;
+}
+
+uint64_t list_hash(const NeighborLists& lists, const std::vector<Index>& queries)
+{
+    uint64_t hash = 0;
+    #pragma omp parallel for reduction(+:hash)
+    for(int q=0; q<lists.query_count(); ++q)
+    {
+        const Scalar* squared_distances = lists.squared_distances(q);
+        for(int j=0; j<lists.size(q); ++j)
+            hash += distance_hash(queries[q], squared_distances[j]);
+    }
+    return hash;
+}
@@ -0,0 +1,167 @@
+#include <PDPC/Common/Option.h>
+#include <PDPC/Common/Log.h>
+#include <PDPC/Common/Timer.h>
+#include <PDPC/PointCloud/Loader.h>
+#include <PDPC/PointCloud/PointCloud.h>
+#include <PDPC/SpacePartitioning/KdTree.h>
+#include <PDPC/SpacePartitioning/Octree.h>
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace pdpc;
+
+int main(int argc, char **argv)
+{
+    Option opt(argc, argv);
+    const std::string  in_input   = opt.get_string("input", "i").set_default("")     .set_brief("Input point cloud (.ply/.obj), random points by default");
+    const int          in_count   = opt.get_int(   "count", "n").set_default(1000000).set_brief("Count of random points");
+    const int          in_repeat  = opt.get_int(   "repeat"    ).set_default(3)      .set_brief("Repetition count (the best time is kept)");
+    const int          in_queries = opt.get_int(   "queries", "q").set_default(100000).set_brief("Count of query points");
+    std::vector<float> in_radii   = opt.get_floats("radii"     ).set_brief("Range query radii as factors of the mean nearest neighbor distance ([ 2 4 8 ] by default)");
+    std::vector<int>   in_knn     = opt.get_ints(  "knn"       ).set_brief("Neighbors counts of the k-nearest queries ([ 10 50 ] by default)");
+    const bool         in_v       = opt.get_bool(  "verbose", "v").set_default(false).set_brief("Add verbose messages");
+
+    bool ok = opt.ok();
+    if(!ok) return 1;
+
+    PointCloud points;
+    if(in_input.empty())
+    {
+        points.set_random(in_count);
+    }
+    else
+    {
+        ok = Loader::Load(in_input, points, in_v);
+        if(!ok) return 1;
+    }
+
+    const int repeat = std::max(1, in_repeat);
+
+    KdTree kdtree;
+    Scalar kdtree_time = std::numeric_limits<Scalar>::max();
+    for(int r=0; r<repeat; ++r)
+    {
+        Timer timer;
+        kdtree.build(points.points_ptr());
+        kdtree_time = std::min(kdtree_time, Scalar(timer.time_sec()));
+    }
+
+    Octree octree;
+    Scalar octree_time = std::numeric_limits<Scalar>::max();
+    for(int r=0; r<repeat; ++r)
+    {
+        Timer timer;
+        octree.build(points.points_ptr());
+        octree_time = std::min(octree_time, Scalar(timer.time_sec()));
+    }
+
+    info() << points.size() << " points";
+    info() << "  kd-tree built in " << kdtree_time << " s (" << kdtree.node_count() << " nodes)";
+    info() << "  octree built in " << octree_time << " s (" << octree.node_count() << " nodes, speedup " << kdtree_time / octree_time << ")";
+
+    // queries spread over the points
+    const int point_count = points.size();
+    std::vector<Index> queries(std::min(in_queries, point_count));
+    for(int q=0; q<int(queries.size()); ++q)
+        queries[q] = Index(int64_t(q) * point_count / queries.size());
+
+    Scalar spacing = 0;
+    #pragma omp parallel for reduction(+:spacing)
+    for(int q=0; q<int(queries.size()); ++q)
+        spacing += kdtree.nearest_neighbor(queries[q]).search().distance();
+    spacing /= std::max(1, int(queries.size()));
+
+    if(in_radii.empty()) in_radii = {2, 4, 8};
+    if(in_knn.empty())   in_knn   = {10, 50};
+
+    info() << queries.size() << " queries, mean nearest neighbor distance = " << spacing;
+
+    for(float factor : in_radii)
+    {
+        const Scalar radius = factor * spacing;
+        info() << "range queries, r = " << radius;
+
+        Scalar   reference_time = -1;
+        uint64_t reference_hash = 0;
+
+        benchmark_queries("kd-tree", queries, repeat, reference_time, reference_hash,
+                          [&](Index q, uint64_t& count, uint64_t& hash)
+        {
+            for(Index j : kdtree.range_neighbors(q, radius))
+            {
+                hash += neighbor_hash(q, j);
+                ++count;
+            }
+        });
+        benchmark_queries("octree", queries, repeat, reference_time, reference_hash,
+                          [&](Index q, uint64_t& count, uint64_t& hash)
+        {
+            for(Index j : octree.range_neighbors(q, radius))
+            {
+                hash += neighbor_hash(q, j);
+                ++count;
+            }
+        });
+        benchmark_queries("octree visitor", queries, repeat, reference_time, reference_hash,
+                          [&](Index q, uint64_t& count, uint64_t& hash)
+        {
+            octree.for_each_in_range(q, radius, [&](Index j, Scalar)
+            {
+                hash += neighbor_hash(q, j);
+                ++count;
+            });
+        });
+    }
+
+    for(int k : in_knn)
+    {
+        info() << k << "-nearest queries";
+
+        Scalar   reference_time = -1;
+        uint64_t reference_hash = 0;
+
+        benchmark_queries("kd-tree", queries, repeat, reference_time, reference_hash,
+                          [&](Index q, uint64_t& count, uint64_t& hash)
+        {
+            for(Index j : kdtree.k_nearest_neighbors(q, k))
+            {
+                hash += neighbor_hash(q, j);
+                ++count;
+            }
+        });
+        benchmark_queries("octree", queries, repeat, reference_time, reference_hash,
+                          [&](Index q, uint64_t& count, uint64_t& hash)
+        {
+            for(Index j : octree.k_nearest_neighbors(q, k))
+            {
+                hash += neighbor_hash(q, j);
+                ++count;
+            }
+        });
+    }
+
+    {
+        info() << "nearest queries";
+
+        Scalar   reference_time = -1;
+        uint64_t reference_hash = 0;
+
+        benchmark_queries("kd-tree", queries, repeat, reference_time, reference_hash,
+                          [&](Index q, uint64_t& count, uint64_t& hash)
+        {
+            hash += neighbor_hash(q, kdtree.nearest_neighbor(q).search().get());
+            ++count;
+        });
+        benchmark_queries("octree", queries, repeat, reference_time, reference_hash,
+                          [&](Index q, uint64_t& count, uint64_t& hash)
+        {
+            hash += neighbor_hash(q, octree.nearest_neighbor(q).search().get());
+            ++count;
+        });
+    }
+
+    return 0;
+}
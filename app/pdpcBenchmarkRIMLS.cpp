@@ -0,0 +1,107 @@
+#include <PDPC/Common/Option.h>
+#include <PDPC/Common/Log.h>
+#include <PDPC/Common/Timer.h>
+#include <PDPC/PointCloud/Loader.h>
+#include <PDPC/PointCloud/PointCloud.h>
+#include <PDPC/SpacePartitioning/KdTree.h>
+#include <PDPC/RIMLS/RIMLSOperator.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace pdpc;
+
+// single-threaded cost of one RIMLS configuration on the same points
+template<RIMLSOutputs Outputs>
+void benchmark(const char* name,
+               const PointCloud& points,
+               const std::vector<int>& indices,
+               Scalar scale,
+               int batched,
+               int repeat)
+{
+    RIMLSOperatorT<Outputs> mls;
+    mls.set_scale(scale);
+    mls.set_step_max(10);
+    mls.set_convergence_ratio_min(0.01);
+    mls.set_reweighting_step(5);
+    mls.set_batched(batched);
+
+    int stable_count = 0;
+    Scalar checksum = 0;
+
+    Timer timer;
+    for(int r=0; r<repeat; ++r)
+    {
+        for(int i : indices)
+        {
+            Vector3 p = points[i];
+            mls.compute(points, p);
+            if(mls.stable())
+            {
+                ++stable_count;
+                checksum += mls.normal().z();
+            }
+        }
+    }
+    const auto millisec = timer.time_milli_sec();
+    const int  count    = std::max(1, int(indices.size()) * repeat);
+
+    info() << "  " << name << (batched ? " (batched)" : "")
+           << ": " << Scalar(1000 * millisec) / count << " us/point"
+           << " (" << stable_count << " stable, checksum " << checksum << ")";
+}
+
+int main(int argc, char **argv)
+{
+    Option opt(argc, argv);
+    const std::string in_input  = opt.get_string("input", "i").set_required()  .set_brief("Input point cloud (.ply/.obj)");
+    const Scalar      in_scale  = opt.get_float( "scale", "s").set_default(5)  .set_brief("Scale (factor of the local point spacing)");
+    const int         in_k      = opt.get_int(   "knn",   "k").set_default(10) .set_brief("Nearest neighbors count for the local point spacing");
+    const int         in_count  = opt.get_int(   "count", "n").set_default(2000).set_brief("Count of evaluated points");
+    const int         in_repeat = opt.get_int(   "repeat"    ).set_default(1)  .set_brief("Repetition count");
+    const bool        in_v      = opt.get_bool(  "verbose", "v").set_default(false).set_brief("Add verbose messages");
+
+    bool ok = opt.ok();
+    if(!ok) return 1;
+
+    PointCloud points;
+    ok = Loader::Load(in_input, points, in_v);
+    if(!ok) return 1;
+    const int point_count = points.size();
+
+    if(!points.has_normals())
+    {
+        error() << "Normal vectors are required!";
+        return 1;
+    }
+
+    points.build_kdtree();
+
+    // median distance to the k-th neighbor
+    std::vector<Scalar> dist_k(point_count, 0);
+    #pragma omp parallel for
+    for(int i=0; i<point_count; ++i)
+    {
+        dist_k[i] = std::sqrt(points.kdtree().k_nearest_neighbors(i, in_k).search().bottom().squared_distance);
+    }
+    std::nth_element(dist_k.begin(), dist_k.begin() + point_count/2, dist_k.end());
+    const Scalar scale = in_scale * dist_k[point_count/2];
+
+    std::vector<int> indices(point_count);
+    std::iota(indices.begin(), indices.end(), 0);
+    std::shuffle(indices.begin(), indices.end(), std::mt19937(0));
+    indices.resize(std::min(point_count, in_count));
+
+    info() << indices.size() << " points at scale " << scale;
+
+    for(int batched=0; batched<2; ++batched)
+    {
+        benchmark<RIMLSNormal    >("normal", points, indices, scale, batched, in_repeat);
+        benchmark<RIMLSCurvatures>("normal + curvatures", points, indices, scale, batched, in_repeat);
+        benchmark<RIMLSScaleSpace>("normal + curvatures + scale der.", points, indices, scale, batched, in_repeat);
+    }
+
+    return 0;
+}
@@ -0,0 +1,214 @@
+#include <PDPC/Common/Option.h>
+#include <PDPC/Common/Log.h>
+#include <PDPC/Common/File.h>
+#include <PDPC/PointCloud/Loader.h>
+#include <PDPC/PointCloud/PointCloud.h>
+#include <PDPC/MultiScaleFeatures/MultiScaleFeatures.h>
+#include <PDPC/Segmentation/SeededKNNGraphRegionGrowing.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+using namespace pdpc;
+
+bool load_features(const std::string& filename, MultiScaleFeatures& features, bool v);
+
+void region_growing(const PointCloud& points,
+                    const MultiScaleFeatures& features,
+                    int j, int k,
+                    Scalar threshold_angle,
+                    Scalar threshold_curva,
+                    Segmentation& seg);
+
+//!
+//! \brief matched_ratio returns the ratio of the points labeled in seg that
+//! are in the region of other which overlaps the most their own region
+//!
+Scalar matched_ratio(const Segmentation& seg, const Segmentation& other);
+
+int main(int argc, char **argv)
+{
+    Option opt(argc, argv);
+    const std::string in_input     = opt.get_string("input",     "i").set_brief("Input point cloud (.ply/.obj)"    ).set_required();
+    const std::string in_features  = opt.get_string("features",  "f").set_brief("Reference features (.txt/.bin)"   ).set_required();
+    const std::string in_features2 = opt.get_string("features2", "g").set_brief("Compared features (.txt/.bin), the quantized reference features by default").set_default("");
+    const std::string in_output    = opt.get_string("output",    "o").set_brief("Output name of the quantized features (not saved by default)").set_default("");
+
+    const int    in_storage = opt.get_int(  "storage", "q").set_default(1) .set_brief("Storage of the quantized features (0 = float, 1 = 16-bit normals, 2 = 32-bit normals)");
+    const int    in_k       = opt.get_int(  "knn",     "k").set_default(10).set_brief("Region growing nearest neighbors count");
+    const Scalar in_theta   = opt.get_float("theta"       ).set_default(5.).set_brief("Region growing angular threshold (degrees)");
+    const Scalar in_phi     = opt.get_float("phi"         ).set_default(1.).set_brief("Region growing curvature threshold");
+
+    const bool in_v = opt.get_bool("verbose", "v").set_default(false).set_brief("Add verbose messages");
+
+    bool ok = opt.ok();
+    if(!ok) return 1;
+
+    PointCloud points;
+    ok = Loader::Load(in_input, points, in_v);
+    if(!ok) return 1;
+    const int point_count = points.size();
+
+    MultiScaleFeatures features;
+    ok = load_features(in_features, features, in_v);
+    if(!ok) return 1;
+
+    MultiScaleFeatures features2;
+    if(in_features2.empty())
+    {
+        features2 = features;
+        features2.set_storage(MultiScaleFeatures::Storage(in_storage));
+        if(!in_output.empty()) features2.save(in_output + "_features.bin", in_v);
+    }
+    else
+    {
+        ok = load_features(in_features2, features2, in_v);
+        if(!ok) return 1;
+    }
+
+    if(features.m_point_count != point_count || features2.m_point_count != point_count)
+    {
+        error().iff(in_v) << "Point counts do not match: " << features.m_point_count << ", "
+                          << features2.m_point_count << " != " << point_count;
+        return 1;
+    }
+    if(features.m_scale_count != features2.m_scale_count)
+    {
+        error().iff(in_v) << "Scale counts do not match: " << features.m_scale_count << " != " << features2.m_scale_count;
+        return 1;
+    }
+    const int scale_count = features.m_scale_count;
+
+    // the const accessors also decode quantized features
+    const MultiScaleFeatures& f1 = features;
+    const MultiScaleFeatures& f2 = features2;
+
+    const Scalar threshold_angle = std::cos(in_theta / 180. * M_PI);
+    const Scalar threshold_curva = in_phi;
+
+    points.build_knn_graph(in_k);
+
+    info() << "scale: angle mean/max (degrees), plane dev mean/max, regions, matched points ratio";
+
+    Scalar matched_mean = 0;
+    for(int j=0; j<scale_count; ++j)
+    {
+        // 1. Features deviation -----------------------------------------------
+        Scalar angle_mean = 0;
+        Scalar angle_max  = 0;
+        Scalar dev_mean   = 0;
+        Scalar dev_max    = 0;
+
+        #pragma omp parallel for reduction(+:angle_mean,dev_mean) reduction(max:angle_max,dev_max)
+        for(int i=0; i<point_count; ++i)
+        {
+            const Vector3 n1 = f1.normal(i,j);
+            const Vector3 n2 = f2.normal(i,j);
+            if(!n1.isZero() && !n2.isZero())
+            {
+                const Scalar dot   = std::min(Scalar(1), std::abs(n1.dot(n2)));
+                const Scalar angle = std::acos(dot) * Scalar(180. / M_PI);
+                angle_mean += angle;
+                angle_max   = std::max(angle_max, angle);
+            }
+            const Scalar dev = std::abs(f1.plane_dev(i,j) - f2.plane_dev(i,j));
+            dev_mean += dev;
+            dev_max   = std::max(dev_max, dev);
+        }
+        angle_mean /= std::max(1, point_count);
+        dev_mean   /= std::max(1, point_count);
+
+        // 2. Segmentation change ----------------------------------------------
+        Segmentation seg1(point_count);
+        Segmentation seg2(point_count);
+        region_growing(points, f1, j, in_k, threshold_angle, threshold_curva, seg1);
+        region_growing(points, f2, j, in_k, threshold_angle, threshold_curva, seg2);
+
+        const Scalar matched = std::min(matched_ratio(seg1, seg2), matched_ratio(seg2, seg1));
+        matched_mean += matched;
+
+        info() << j+1 << "/" << scale_count << ": "
+               << angle_mean << " / " << angle_max << ", "
+               << dev_mean   << " / " << dev_max   << ", "
+               << seg1.region_count() << " vs " << seg2.region_count() << ", "
+               << matched;
+    }
+    info() << "mean matched points ratio = " << matched_mean / std::max(1, scale_count);
+
+    return 0;
+}
+
+bool load_features(const std::string& filename, MultiScaleFeatures& features, bool v)
+{
+    if(get_extension(filename) == "bin")
+        return features.map(filename, v);
+    else
+        return features.load(filename, v);
+}
+
+// same region growing as pdpcSegmentation, before the filtering of the regions
+void region_growing(const PointCloud& points,
+                    const MultiScaleFeatures& features,
+                    int j, int k,
+                    Scalar threshold_angle,
+                    Scalar threshold_curva,
+                    Segmentation& seg)
+{
+    const int point_count = points.size();
+
+    std::vector<Scalar> mean_planarity_dev(point_count, 0.);
+    for(int i=0; i<point_count; ++i)
+    {
+        mean_planarity_dev[i] = features.plane_dev(i,j);
+        for(int n : points.knn_graph().k_nearest_neighbors(i))
+        {
+            mean_planarity_dev[i] += features.plane_dev(n,j);
+        }
+        mean_planarity_dev[i] /= (k + 1);
+    }
+
+    std::vector<int> seeds;
+    SeededKNNGraphRegionGrowing::compute(points, seg,
+    [&features,&seeds,j,threshold_angle,threshold_curva](int rg_l, int rg_i, int rg_j) -> bool
+    {
+        const int idx_seed = seeds[rg_l];
+        PDPC_UNUSED(rg_i);
+        return features.normal(idx_seed,j).dot(features.normal(rg_j,j)) > threshold_angle &&
+               features.plane_dev(rg_j,j) < threshold_curva;
+    },
+    [&mean_planarity_dev](int rg_i, int rg_j) -> bool
+    {
+        return mean_planarity_dev[rg_i] > mean_planarity_dev[rg_j];
+    },
+    [&seeds](int rg_l, int rg_i)
+    {
+        PDPC_UNUSED(rg_l);
+        seeds.push_back(rg_i);
+    });
+}
+
+Scalar matched_ratio(const Segmentation& seg, const Segmentation& other)
+{
+    // overlap[l][l_other] = points count in both regions
+    std::vector<std::unordered_map<int,int>> overlap(seg.region_count());
+    int labeled_count = 0;
+    for(int i=0; i<seg.size(); ++i)
+    {
+        if(seg[i] == Segmentation::invalid()) continue;
+        ++overlap[seg[i]][other[i]];
+        ++labeled_count;
+    }
+
+    int matched_count = 0;
+    for(const auto& counts : overlap)
+    {
+        int best = 0;
+        for(const auto& count : counts)
+        {
+            if(count.first != Segmentation::invalid())
+                best = std::max(best, count.second);
+        }
+        matched_count += best;
+    }
+    return labeled_count == 0 ? Scalar(1) : Scalar(matched_count) / labeled_count;
+}
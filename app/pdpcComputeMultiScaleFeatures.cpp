@@ -1,17 +1,36 @@
 #include <PDPC/Common/Option.h>
 #include <PDPC/Common/Log.h>
+#include <PDPC/Common/Cpu.h>
+#include <PDPC/Common/File.h>
+#include <PDPC/Common/std_vector_algo.h>
 #include <PDPC/PointCloud/Loader.h>
 #include <PDPC/PointCloud/PointCloud.h>
 #include <PDPC/SpacePartitioning/KdTree.h>
 #include <PDPC/ScaleSpace/ScaleSampling.h>
 #include <PDPC/MultiScaleFeatures/MultiScaleFeatures.h>
-#include <PDPC/RIMLS/RIMLSOperator.h>
+#include <PDPC/MultiScaleFeatures/MultiScaleFeaturesWriter.h>
+#include <PDPC/MultiScaleFeatures/MultiScaleFeaturesEngine.h>
+#include <PDPC/MultiScaleFeatures/MultiScaleFeaturesTiling.h>
 
 #include <algorithm>
-#include <numeric>
+#include <cstdlib>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace pdpc;
 
+//!
+//! \brief launch_workers runs this program in worker_count processes, each
+//! computing a shard of the tiles with the given scales
+//!
+bool launch_workers(int argc, char** argv, int worker_count, const std::string& scales_filename, bool v);
+
 int main(int argc, char **argv)
 {
     Option opt(argc, argv);
@@ -24,11 +43,35 @@ int main(int argc, char **argv)
     const int    in_k      = opt.get_int(  "knn",         "k"     ).set_default(10).set_brief("Nearest neighbors count for the minimal scale");
 
     const Scalar in_alpha = opt.get_float("alpha", "a").set_default(0.1).set_brief("Sub-sampling factor for the multi-resolution");
+    const int    in_seed  = opt.get_int(  "seed"     ).set_default(0)  .set_brief("Seed of the Poisson disk sampling");
 
     const Scalar in_mls_eps    = opt.get_float( "mls_eps"   ).set_default(0.01).set_brief("MLS convergence threshold (factor of the scale)");
     const int    in_mls_max    = opt.get_int(   "mls_max"   ).set_default(10)  .set_brief("MLS step max");
     const Scalar in_irls_sigma = opt.get_float( "irls_sigma").set_default(1.0) .set_brief("IRLS factor");
     const int    in_irls_step  = opt.get_int(   "irls_step" ).set_default(5)   .set_brief("IRLS step");
+    const Scalar in_mls_cache  = opt.get_float( "mls_cache" ).set_default(0)   .set_brief("Neighbor cache radius inflation (factor of the scale, 0 to disable)");
+    const int    in_mls_batch  = opt.get_int(   "mls_batch" ).set_default(1)   .set_brief("Compute the reweighting steps with the SIMD kernel (0 to add the neighbors one by one)");
+    const int    in_mls_warm   = opt.get_int(   "mls_warm"  ).set_default(0)   .set_brief("Start the MLS projection of a scale from the previous one (0 = input point, 1 = projected point)");
+    const int    in_simd       = opt.get_int(   "simd"      ).set_default(-1)  .set_brief("Instruction set of the SIMD kernel (0 = none, 1 = avx2, 2 = avx512, -1 = best)");
+    const bool   in_mls_grid   = opt.get_bool(  "mls_grid"  ).set_default(false).set_brief("Query the neighbors of each scale in a hash grid instead of the kd-tree");
+
+    const Scalar in_prop_ratio = opt.get_float("prop_ratio").set_default(0).set_brief("Evaluate only the samples when they are less than this ratio of the points (0 to disable)");
+    const int    in_prop_k     = opt.get_int(  "prop_knn"  ).set_default(4).set_brief("Nearest samples count used to interpolate the other points (1 = nearest)");
+    const int    in_prop_check = opt.get_int(  "prop_check").set_default(1000).set_brief("Count of interpolated points also evaluated to report the deviation");
+
+    const int in_block  = opt.get_int("block" ).set_default(256).set_brief("Points count of a task");
+    const int in_stream = opt.get_int("stream").set_default(0)  .set_brief("Write each scale to the binary features file when it is computed (1) instead of keeping all of them in memory (0)");
+    const int in_quant  = opt.get_int("quantize").set_default(0)  .set_brief("Save binary quantized features (0 = float, 1 = 16-bit normals and half curvatures, 2 = 32-bit normals and half curvatures)");
+    const Scalar in_ckp    = opt.get_float("checkpoint").set_default(600).set_brief("Minimal time in seconds between two checkpoints of the streamed features (negative to disable)");
+    const bool   in_resume = opt.get_bool( "resume"    ).set_default(false).set_brief("Resume the streamed features from the last checkpoint");
+    const int    in_tile   = opt.get_int(  "tile"      ).set_default(0)    .set_brief("Compute the binary features by tiles of at most this points count with a halo of the max scale, which needs a small -smax (0 to disable)");
+    const bool   in_reorder = opt.get_bool("reorder"   ).set_default(false).set_brief("Store the points in the order of the kd-tree leaves during the computation");
+
+    const std::string in_scales = opt.get_string("scales").set_default("").set_brief("Scales file (.txt) to use instead of computing them");
+    const int  in_workers     = opt.get_int( "workers"    ).set_default(0)    .set_brief("Compute the tiles in this count of local worker processes, then merge them");
+    const int  in_shard       = opt.get_int( "shard"      ).set_default(0)    .set_brief("Index of the shard of tiles computed by this process, in [0, shard_count)");
+    const int  in_shard_count = opt.get_int( "shard_count").set_default(1)    .set_brief("Count of processes sharing the tiles (the tile files are kept for -merge)");
+    const bool in_merge       = opt.get_bool("merge"      ).set_default(false).set_brief("Only merge the tile files written by the shards");
 
     const bool in_v = opt.get_bool("verbose", "v").set_default(false).set_brief("Add verbose messages");
 
@@ -46,150 +89,215 @@ int main(int argc, char **argv)
         return 1;
     }
 
-    points.build_kdtree();
+    // the features are still saved in the input order
+    std::vector<int> order;
+    if(in_reorder)
+    {
+        order = points.spatial_order();
+        points.reorder(order);
+    }
 
     // 1. Scales ---------------------------------------------------------------
-    info().iff(in_v) << "Computing " << in_scount << " scales";
-
-    std::vector<Scalar> dist_k(point_count, 0);
-
-    #pragma omp parallel for
-    for(int i=0; i<point_count; ++i)
+    ScaleSampling scales;
+    if(!in_scales.empty())
     {
-        const Scalar squared_dist = points.kdtree().k_nearest_neighbors(i, in_k).search().bottom().squared_distance;
-        dist_k[i] = std::sqrt(squared_dist);
+        // shared by all the shards of a computation
+        ok = scales.load(in_scales, in_v);
+        if(!ok) return 1;
     }
-    std::sort(dist_k.begin(), dist_k.end());
-    const Scalar local_point_spacing = dist_k[0.50*(point_count-1)]; // median
-    const Scalar aabb_diag = points.aabb_diag();
+    else
+    {
+        info().iff(in_v) << "Computing " << in_scount << " scales";
 
-    const int    scale_count = in_scount;
-    const Scalar scale_min   = in_smin * local_point_spacing;
-    const Scalar scale_max   = in_smax * aabb_diag;
+        points.build_kdtree();
 
-    ScaleSampling scales;
-    scales.log_sample(scale_min, scale_max, scale_count);
+        std::vector<Scalar> dist_k(point_count, 0);
 
-    info().iff(in_v) << "  min   = " << scale_min;
-    info().iff(in_v) << "  max   = " << scale_max;
+        #pragma omp parallel for
+        for(int i=0; i<point_count; ++i)
+        {
+            const Scalar squared_dist = points.kdtree().k_nearest_neighbors(i, in_k).search().bottom().squared_distance;
+            dist_k[i] = std::sqrt(squared_dist);
+        }
+        std::sort(dist_k.begin(), dist_k.end());
+        const Scalar local_point_spacing = dist_k[0.50*(point_count-1)]; // median
+        const Scalar aabb_diag = points.aabb_diag();
 
-    // 2. Features -------------------------------------------------------------
-    info().iff(in_v) << "Computing features";
+        const int    scale_count = in_scount;
+        const Scalar scale_min   = in_smin * local_point_spacing;
+        const Scalar scale_max   = in_smax * aabb_diag;
+
+        scales.log_sample(scale_min, scale_max, scale_count);
 
-    MultiScaleFeatures features(point_count, scale_count);
+        info().iff(in_v) << "  min   = " << scale_min;
+        info().iff(in_v) << "  max   = " << scale_max;
+    }
 
-    // sampling stuff
-    std::vector<bool> is_free(point_count);
-    std::vector<int> sampling(point_count);
-    std::vector<int> sampling2(point_count);
-    std::vector<int> rank(point_count);
+    // 2. Features -------------------------------------------------------------
+    if(in_simd >= 0) set_simd_level(SimdLevel(in_simd));
+    info().iff(in_v) << "Computing features (simd = " << simd_level_name(simd_level()) << ")";
+
+    MultiScaleFeaturesEngine engine;
+    engine.mls().set_step_max(in_mls_max);
+    engine.mls().set_convergence_ratio_min(in_mls_eps);
+    engine.mls().set_reweighting_step(in_irls_step);
+    engine.mls().set_reweighting_sigma(in_irls_sigma);
+    engine.mls().set_cache_inflation(in_mls_cache);
+    engine.mls().set_batched(in_mls_batch);
+    engine.set_alpha(in_alpha);
+    engine.set_seed(in_seed);
+    engine.set_block_size(in_block);
+    engine.set_interpolation(in_prop_ratio, in_prop_k, in_prop_check);
+    engine.set_warm_start(MultiScaleFeaturesEngine::WarmStart(in_mls_warm));
+    engine.set_hash_grid(in_mls_grid);
+    engine.set_verbose(in_v);
+
+    if((in_stream || in_tile > 0) && in_quant)
+    {
+        warning().iff(in_v) << "Streamed features are not quantized";
+    }
 
-    // start with the full indices
-    std::iota(sampling.begin(), sampling.end(), 0);
+    if(in_workers > 1)
+    {
+        const std::string scales_filename = in_output + "_scales.txt";
+        ok = scales.save(scales_filename, in_v);
+        ok = ok && launch_workers(argc, argv, in_workers, scales_filename, in_v);
+        if(!ok) return 1;
+    }
 
-    // for each scale
-    for(int j=0; j<scale_count; ++j)
+    const int  shard_count = std::max(1, in_workers > 1 ? in_workers : in_shard_count);
+    const bool is_shard    = shard_count > 1 && in_workers <= 1 && !in_merge;
+    if(in_tile > 0 || shard_count > 1 || in_merge)
     {
-        info().iff(in_v) << j+1 << "/" << scale_count;
+        if(in_resume) warning().iff(in_v) << "Tiled features cannot be resumed";
 
-        const Scalar scale  = scales[j];
+        // one tile per shard by default
+        MultiScaleFeaturesTiling tiling;
+        tiling.set_tile_size(in_tile > 0 ? in_tile : (point_count + shard_count - 1) / shard_count);
+        tiling.set_halo(scales.max());
+        tiling.set_verbose(in_v);
+        tiling.set_order(order);
 
-        // 2.1 poisson disk sampling -------------------------------------------
+        const std::string filename = in_output + "_features.bin";
+        if(in_merge || in_workers > 1)
         {
-            if(j == 0)
-            {
-                std::iota(sampling.begin(), sampling.end(), 0);
-                // kdtree already built
-            }
-            else
-            {
-                rank.resize(sampling.size());
-                std::iota(rank.begin(), rank.end(), 0);
-                std::random_shuffle(rank.begin(), rank.end());
-                std::fill(is_free.begin(), is_free.end(), true);
-
-                sampling2.clear();
-
-                const Scalar radius = in_alpha * scale;
-
-#if 1
-                // first version (less efficient because assume heterogeneous scale sampling)
-                for(int idx_sample : rank)
-                {
-                    const int idx_point = sampling[idx_sample];
-                    bool free = true;
-                    for(int idx_nei : points.kdtree().range_neighbors(idx_point, radius))
-                    {
-                        if(!is_free[idx_nei])
-                        {
-                            free = false;
-                            break;
-                        }
-                    }
-
-                    if(free)
-                    {
-                        sampling2.emplace_back(idx_point);
-                        is_free[idx_point] = false;
-
-                        for(int idx_nei : points.kdtree().range_neighbors(idx_point, radius)) is_free[idx_nei] = false;
-                    }
-                }
-#else
-                // second version (more efficient because assume homogeneous scale sampling)
-                // (these two versions do not give the same results)
-                for(int idx_sample : rank)
-                {
-                    const int idx_point = sampling[idx_sample];
-                    if(is_free[idx_point])
-                    {
-                        sampling2.emplace_back(idx_point);
-                        is_free[idx_point] = false;
-
-                        for(int idx_nei : points.kdtree().range_neighbors(idx_point, 2*radius)) // factor 2 !!!!
-                            is_free[idx_nei] = false;
-                    }
-                }
-#endif
-                std::swap(sampling, sampling2);
-                points.kdtree().rebuild(sampling);
-            }
-//            debug() << sampling.size() << " points sampled";
+            tiling.split(points);
+            ok = tiling.merge(point_count, scales.size(), filename);
         }
-
-        // 2.2 Features --------------------------------------------------------
+        else if(is_shard)
+        {
+            tiling.split(points);
+            for(int t=in_shard; ok && t<tiling.tile_count(); t+=shard_count)
+                ok = tiling.compute_tile(points, scales, engine, t, filename);
+        }
+        else
         {
-            RIMLSOperator mls;
-            mls.set_scale(scale);
-            mls.set_step_max(in_mls_max);
-            mls.set_convergence_ratio_min(in_mls_eps);
-            mls.set_reweighting_step(in_irls_step);
-            mls.set_reweighting_sigma(in_irls_sigma);
-
-            #pragma omp parallel for firstprivate(mls)
-            for(int i=0; i<point_count; ++i)
-            {
-                Vector3 p = points[i];
-                mls.compute(points, p);
-
-                if(mls.stable())
-                {
-                    features.normal(i,j) = mls.fit().normal();
-                    features.k1(i,j) = mls.fit().k1() * scale; // normalized curvature
-                    features.k2(i,j) = mls.fit().k2() * scale;
-                }
-                else
-                {
-                    features.normal(i,j) = Vector3::Zero();
-                    features.k1(i,j) = 0;
-                    features.k2(i,j) = 0;
-                }
-            } // for i
+            ok = tiling.compute(points, scales, engine, filename);
         }
-    } // for j
+        if(!ok) return 1;
+    }
+    else if(in_stream || in_resume)
+    {
+        const std::string filename   = in_output + "_features.bin";
+        const std::string checkpoint = in_output + "_checkpoint.bin";
+        if(in_ckp >= 0) engine.set_checkpoint(checkpoint, in_ckp);
+
+        // the scales of the checkpoint are already in the features file
+        const bool resume = in_resume && file_exists(checkpoint) && file_exists(filename);
+        engine.set_resume(resume);
+        if(!points.has_kdtree()) points.build_kdtree();
+
+        MultiScaleFeaturesWriter writer;
+        ok = resume ? writer.reopen(filename, point_count, scales.size(), in_v)
+                    : writer.open(  filename, point_count, scales.size(), in_v);
+        if(!ok) return 1;
+        writer.set_order(order);
+        ok = engine.compute(points, scales, writer);
+        ok = writer.close() && ok;
+        if(!ok) return 1;
+    }
+    else
+    {
+        if(!points.has_kdtree()) points.build_kdtree();
 
-    features.save(in_output + "_features.txt");
-    scales.save(  in_output + "_scales.txt");
+        MultiScaleFeatures features;
+        engine.compute(points, scales, features);
+        if(in_reorder) features.reorder(inverse_permutation(order));
+        if(in_quant)
+        {
+            features.set_storage(MultiScaleFeatures::Storage(in_quant));
+            features.save(in_output + "_features.bin", in_v);
+        }
+        else
+        {
+            features.save(in_output + "_features.txt");
+        }
+    }
+    // the scales file is read by the other shards
+    if(!is_shard && in_workers <= 1) scales.save(in_output + "_scales.txt");
 
     return 0;
 }
+
+bool launch_workers(int argc, char** argv, int worker_count, const std::string& scales_filename, bool v)
+{
+    // the workers get the same arguments, without the launcher ones
+    std::vector<std::string> args;
+    for(int a=0; a<argc; ++a)
+    {
+        const std::string arg = argv[a];
+        if(arg == "-workers") {++a; continue;}
+        if(arg == "-scales" || arg == "-shard" || arg == "-shard_count") {++a; continue;}
+        args.push_back(arg);
+    }
+    args.insert(args.end(), {"-scales", scales_filename, "-shard_count", std::to_string(worker_count), "-shard", ""});
+
+    // the cores are shared by the workers
+    if(!std::getenv("OMP_NUM_THREADS"))
+    {
+#ifdef _OPENMP
+        const int core_count = omp_get_num_procs();
+#else
+        const int core_count = std::thread::hardware_concurrency();
+#endif
+        const int thread_count = std::max(1, core_count / worker_count);
+        setenv("OMP_NUM_THREADS", std::to_string(thread_count).c_str(), 1);
+    }
+
+    info().iff(v) << "Launching " << worker_count << " workers";
+
+    std::vector<pid_t> pids;
+    for(int k=0; k<worker_count; ++k)
+    {
+        args.back() = std::to_string(k);
+        std::vector<char*> c_args;
+        for(std::string& arg : args) c_args.push_back(&arg[0]);
+        c_args.push_back(nullptr);
+
+        const pid_t pid = fork();
+        if(pid == 0)
+        {
+            execvp(c_args[0], c_args.data());
+            _exit(127);
+        }
+        if(pid < 0)
+        {
+            error().iff(v) << "Failed to launch worker " << k;
+            break;
+        }
+        pids.push_back(pid);
+    }
+
+    bool ok = int(pids.size()) == worker_count;
+    for(int k=0; k<int(pids.size()); ++k)
+    {
+        int status = 0;
+        waitpid(pids[k], &status, 0);
+        if(!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            error().iff(v) << "Worker " << k << " failed";
+            ok = false;
+        }
+    }
+    return ok;
+}
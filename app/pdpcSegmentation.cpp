@@ -1,5 +1,6 @@
 #include <PDPC/Common/Option.h>
 #include <PDPC/Common/Log.h>
+#include <PDPC/Common/File.h>
 #include <PDPC/Common/Algorithms/has_duplicate.h>
 #include <PDPC/PointCloud/Loader.h>
 #include <PDPC/PointCloud/PointCloud.h>
@@ -77,10 +78,17 @@ int main(int argc, char **argv)
     ok = scales.load(in_scales, in_v);
     const int scale_count = scales.size();
 
-    MultiScaleFeatures features;
-    ok = features.load(in_features, in_v);
+    // binary features are mapped so that only the segmented scales are read
+    MultiScaleFeatures features_data;
+    if(get_extension(in_features) == "bin")
+        ok = features_data.map(in_features, in_v);
+    else
+        ok = features_data.load(in_features, in_v);
     if(!ok) return 1;
 
+    // the const accessors also decode quantized features
+    const MultiScaleFeatures& features = features_data;
+
     if(features.m_point_count != point_count)
     {
         error().iff(in_v) << "Point counts do not match: " << features.m_point_count << " != " << point_count;
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <PDPC/Common/Assert.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace pdpc {
+
+//!
+//! \brief parallel_radix_sort sorts the keys with their values by increasing
+//! key, considering only the given number of lowest bits of the keys
+//!
+//! This is a stable LSD radix sort with 8-bit digits: each pass counts the
+//! digits of one chunk of keys per thread and scatters the chunks at the
+//! offsets of their digits. The passes of digits shared by all the keys are
+//! skipped. The result does not depend on the thread count.
+//!
+template<class T>
+void parallel_radix_sort(std::vector<std::uint64_t>& keys, std::vector<T>& values, int bits = 64);
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+template<class T>
+void parallel_radix_sort(std::vector<std::uint64_t>& keys, std::vector<T>& values, int bits)
+{
+    PDPC_DEBUG_ASSERT(keys.size() == values.size());
+
+    constexpr int digit_bits  = 8;
+    constexpr int digit_count = 1 << digit_bits;
+    using Histogram = std::array<long, digit_count>;
+
+    const long size = keys.size();
+
+#ifdef _OPENMP
+    const int chunk_count = omp_in_parallel() || size < 4096 ? 1 : omp_get_max_threads();
+#else
+    const int chunk_count = 1;
+#endif
+
+    std::vector<long> bounds(chunk_count + 1);
+    for(int c=0; c<=chunk_count; ++c)
+        bounds[c] = c * size / chunk_count;
+
+    std::vector<std::uint64_t> tmp_keys(size);
+    std::vector<T>             tmp_values(size);
+    std::vector<Histogram>     histograms(chunk_count);
+
+    for(int shift=0; shift<bits; shift+=digit_bits)
+    {
+        // 1. digit count of each chunk
+        #pragma omp parallel for
+        for(int c=0; c<chunk_count; ++c)
+        {
+            Histogram& histogram = histograms[c];
+            histogram.fill(0);
+            for(long i=bounds[c]; i<bounds[c+1]; ++i)
+                ++histogram[(keys[i] >> shift) & (digit_count - 1)];
+        }
+
+        // 2. offsets of each digit of each chunk
+        long offset = 0;
+        bool skip   = false;
+        for(int d=0; d<digit_count; ++d)
+        {
+            long digit_size = 0;
+            for(int c=0; c<chunk_count; ++c)
+            {
+                const long count = histograms[c][d];
+                histograms[c][d] = offset;
+                offset     += count;
+                digit_size += count;
+            }
+            skip = skip || digit_size == size;
+        }
+        if(skip) continue;
+
+        // 3. stable scatter
+        #pragma omp parallel for
+        for(int c=0; c<chunk_count; ++c)
+        {
+            Histogram& position = histograms[c];
+            for(long i=bounds[c]; i<bounds[c+1]; ++i)
+            {
+                const long pos = position[(keys[i] >> shift) & (digit_count - 1)]++;
+                tmp_keys[pos]   = keys[i];
+                tmp_values[pos] = values[i];
+            }
+        }
+        keys.swap(tmp_keys);
+        values.swap(tmp_values);
+    }
+}
+
+} // namespace pdpc
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace pdpc {
+
+//!
+//! \brief parallel_sort sorts the range [first,last) by sorting one chunk per
+//! thread and merging the chunks pairwise
+//!
+//! As std::sort it is not stable, but the result does not depend on the
+//! thread count if comp defines a strict total order.
+//!
+template<class RandomIt, class Compare>
+void parallel_sort(RandomIt first, RandomIt last, Compare comp);
+
+template<class RandomIt>
+void parallel_sort(RandomIt first, RandomIt last);
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+template<class RandomIt, class Compare>
+void parallel_sort(RandomIt first, RandomIt last, Compare comp)
+{
+    const long size = std::distance(first, last);
+
+#ifdef _OPENMP
+    const int chunk_count = omp_in_parallel() ? 1 : omp_get_max_threads();
+#else
+    const int chunk_count = 1;
+#endif
+
+    if(chunk_count <= 1 || size < 4096 * chunk_count)
+    {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    std::vector<long> bounds(chunk_count + 1);
+    for(int c=0; c<=chunk_count; ++c)
+        bounds[c] = c * size / chunk_count;
+
+    #pragma omp parallel for
+    for(int c=0; c<chunk_count; ++c)
+    {
+        std::sort(first + bounds[c], first + bounds[c+1], comp);
+    }
+
+    for(int step=1; step<chunk_count; step*=2)
+    {
+        #pragma omp parallel for
+        for(int c=0; c<chunk_count-step; c+=2*step)
+        {
+            const int c_end = std::min(c + 2*step, chunk_count);
+            std::inplace_merge(first + bounds[c],
+                               first + bounds[c+step],
+                               first + bounds[c_end],
+                               comp);
+        }
+    }
+}
+
+template<class RandomIt>
+void parallel_sort(RandomIt first, RandomIt last)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    parallel_sort(first, last, std::less<T>());
+}
+
+} // namespace pdpc
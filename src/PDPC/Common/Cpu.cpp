@@ -0,0 +1,55 @@
+#include <PDPC/Common/Cpu.h>
+
+#include <algorithm>
+
+namespace pdpc {
+
+namespace {
+
+SimdLevel detect_simd_level()
+{
+#ifdef PDPC_SIMD_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f"))
+        return SimdLevel::AVX512;
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return SimdLevel::AVX2;
+#endif
+    return SimdLevel::None;
+}
+
+SimdLevel& current_simd_level()
+{
+    static SimdLevel level = cpu_simd_level();
+    return level;
+}
+
+} // namespace
+
+SimdLevel cpu_simd_level()
+{
+    static const SimdLevel level = detect_simd_level();
+    return level;
+}
+
+SimdLevel simd_level()
+{
+    return current_simd_level();
+}
+
+void set_simd_level(SimdLevel level)
+{
+    current_simd_level() = std::min(level, cpu_simd_level());
+}
+
+const char* simd_level_name(SimdLevel level)
+{
+    switch(level)
+    {
+    case SimdLevel::AVX2:   return "avx2";
+    case SimdLevel::AVX512: return "avx512";
+    default:                return "none";
+    }
+}
+
+} // namespace pdpc
@@ -0,0 +1,36 @@
+#pragma once
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define PDPC_SIMD_X86
+#endif
+
+namespace pdpc {
+
+//!
+//! \brief The SimdLevel enum lists the instruction sets the SIMD kernels are
+//! compiled for, ordered by increasing width
+//!
+enum class SimdLevel
+{
+    None   = 0,
+    AVX2   = 1,
+    AVX512 = 2
+};
+
+//! \brief cpu_simd_level returns the best instruction set supported by the cpu
+SimdLevel cpu_simd_level();
+
+//! \brief simd_level returns the instruction set used by the SIMD kernels
+SimdLevel simd_level();
+
+//!
+//! \brief set_simd_level restricts the SIMD kernels to a given instruction set
+//!
+//! The level is clamped to cpu_simd_level().
+//! This is not thread-safe and should be called before any computation.
+//!
+void set_simd_level(SimdLevel level);
+
+const char* simd_level_name(SimdLevel level);
+
+} // namespace pdpc
@@ -3,11 +3,20 @@
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 #include <vector>
+#include <cstdint>
 
 namespace pdpc
 {
 
 using Scalar = float;
+
+//! \brief Index is the type of the point indices of the kd-tree and its queries (64-bit with PDPC_INDEX_64)
+#ifdef PDPC_INDEX_64
+using Index = std::int64_t;
+#else
+using Index = int;
+#endif
+
 using Vector2 = Eigen::Matrix<Scalar,2,1>;
 using Vector3 = Eigen::Matrix<Scalar,3,1>;
 using Vector4 = Eigen::Matrix<Scalar,4,1>;
@@ -1,5 +1,7 @@
 #include <PDPC/Common/File.h>
 
+#include <fstream>
+
 namespace pdpc {
 
 std::string get_extension(const std::string& path)
@@ -38,4 +40,9 @@ std::string get_filename(const std::string& path)
     }
 }
 
+bool file_exists(const std::string& path)
+{
+    return std::ifstream(path).good();
+}
+
 } // namespace pdpc
@@ -6,5 +6,6 @@ namespace pdpc {
 
 std::string get_extension(const std::string& path);
 std::string get_filename(const std::string& path);
+bool        file_exists(const std::string& path);
 
 } // namespace pdpc
@@ -0,0 +1,77 @@
+#include <PDPC/Common/MappedFile.h>
+#include <PDPC/Common/Log.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace pdpc {
+
+MappedFile::MappedFile() :
+    m_data(nullptr),
+    m_size(0),
+    m_open(false)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    this->close();
+}
+
+bool MappedFile::open(const std::string& filename, bool v)
+{
+    this->close();
+
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if(fd < 0)
+    {
+        error().iff(v) << "Failed to open file " << filename;
+        return false;
+    }
+
+    struct stat st;
+    if(::fstat(fd, &st) != 0)
+    {
+        error().iff(v) << "Failed to get the size of file " << filename;
+        ::close(fd);
+        return false;
+    }
+
+    // an empty file cannot be mapped
+    if(st.st_size > 0)
+    {
+        void* data = ::mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if(data == MAP_FAILED)
+        {
+            error().iff(v) << "Failed to map file " << filename;
+            ::close(fd);
+            return false;
+        }
+        m_data = static_cast<char*>(data);
+        m_size = st.st_size;
+    }
+
+    // the mapping stays valid once the file is closed
+    ::close(fd);
+    m_open = true;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if(m_data)
+        ::munmap(m_data, m_size);
+
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+
+bool MappedFile::is_open() const
+{
+    return m_open;
+}
+
+} // namespace pdpc
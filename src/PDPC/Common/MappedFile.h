@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+namespace pdpc {
+
+//!
+//! \brief The MappedFile class maps a whole file in memory so that the OS only
+//! pages in the parts that are read
+//!
+//! The mapping is private: writing to data() modifies a copy-on-write page of
+//! the process and never the file.
+//!
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile& other) = delete;
+    MappedFile& operator = (const MappedFile& other) = delete;
+
+public:
+    bool open(const std::string& filename, bool verbose = true);
+    void close();
+
+public:
+    bool is_open() const;
+
+    inline const char* data() const {return m_data;}
+    inline       char* data()       {return m_data;}
+    inline std::size_t size() const {return m_size;}
+
+protected:
+    char*       m_data;
+    std::size_t m_size;
+    bool        m_open;
+};
+
+} // namespace pdpc
@@ -0,0 +1,191 @@
+#include <PDPC/Common/TextFile.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace pdpc {
+
+namespace {
+
+constexpr long MinChunkSize = 1 << 20;
+constexpr int  MaxNumberSize = 63;
+
+inline bool is_blank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline bool is_space(char c)
+{
+    return is_blank(c) || c == '\n' || c == '\v' || c == '\f';
+}
+
+inline bool is_digit(char c)
+{
+    return '0' <= c && c <= '9';
+}
+
+//! \brief copy_number copies the chars of the number at p into a null-terminated buffer
+inline const char* copy_number(const char* p, const char* end, char* buffer, int& size)
+{
+    size = 0;
+    while(p != end && !is_space(*p) && size < MaxNumberSize)
+        buffer[size++] = *p++;
+    buffer[size] = '\0';
+    return (size == 0 || (p != end && !is_space(*p))) ? nullptr : p;
+}
+
+} // namespace
+
+TextFile::TextFile() :
+    m_file(),
+    m_chunks(),
+    m_line_count(0)
+{
+}
+
+bool TextFile::open(const std::string& filename, bool v)
+{
+    this->close();
+    if(!m_file.open(filename, v))
+        return false;
+
+    const char* data = m_file.data();
+    const long  size = m_file.size();
+
+#ifdef _OPENMP
+    const int thread_count = omp_get_max_threads();
+#else
+    const int thread_count = 1;
+#endif
+    const int chunk_count = std::max(1L, std::min(long(8 * thread_count), size / MinChunkSize));
+
+    // each chunk starts after an end of line
+    std::vector<long> bounds(chunk_count + 1);
+    bounds[0]           = 0;
+    bounds[chunk_count] = size;
+    for(int c=1; c<chunk_count; ++c)
+    {
+        const long  pos = std::max(bounds[c-1], c * size / chunk_count);
+        const char* eol = static_cast<const char*>(std::memchr(data + pos, '\n', size - pos));
+        bounds[c] = eol ? (eol - data + 1) : size;
+    }
+
+    m_chunks.resize(chunk_count);
+
+    #pragma omp parallel for
+    for(int c=0; c<chunk_count; ++c)
+    {
+        Chunk& chunk = m_chunks[c];
+        chunk.begin      = data + bounds[c];
+        chunk.end        = data + bounds[c+1];
+        chunk.line_count = std::count(chunk.begin, chunk.end, '\n');
+
+        // the last line of the file may have no end of line
+        if(chunk.begin != chunk.end && chunk.end[-1] != '\n')
+            ++chunk.line_count;
+    }
+
+    for(int c=0; c<chunk_count; ++c)
+    {
+        m_chunks[c].first_line = m_line_count;
+        m_line_count += m_chunks[c].line_count;
+    }
+    return true;
+}
+
+void TextFile::close()
+{
+    m_file.close();
+    m_chunks.clear();
+    m_line_count = 0;
+}
+
+bool TextFile::line(int l, const char*& begin, const char*& end) const
+{
+    for(const Chunk& chunk : m_chunks)
+    {
+        if(l >= chunk.first_line + chunk.line_count)
+            continue;
+
+        begin = chunk.begin;
+        for(int k=chunk.first_line; k<l; ++k)
+            begin = static_cast<const char*>(std::memchr(begin, '\n', chunk.end - begin)) + 1;
+
+        const char* eol = static_cast<const char*>(std::memchr(begin, '\n', chunk.end - begin));
+        end = eol ? eol : chunk.end;
+        return true;
+    }
+    return false;
+}
+
+// Parsing ---------------------------------------------------------------------
+
+const char* TextFile::parse(const char* p, const char* end, int& value)
+{
+    p = skip_blanks(p, end);
+
+    bool negative = false;
+    if(p != end && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        ++p;
+    }
+    if(p == end || !is_digit(*p))
+        return nullptr;
+
+    long long x = 0;
+    while(p != end && is_digit(*p))
+    {
+        x = 10 * x + (*p - '0');
+        if(x > -static_cast<long long>(INT_MIN))
+            return nullptr;
+        ++p;
+    }
+    if(!negative && x > INT_MAX)
+        return nullptr;
+
+    value = negative ? int(-x) : int(x);
+    return p;
+}
+
+const char* TextFile::parse(const char* p, const char* end, float& value)
+{
+    char buffer[MaxNumberSize + 1];
+    int  size = 0;
+    p = copy_number(skip_blanks(p, end), end, buffer, size);
+    if(!p)
+        return nullptr;
+
+    char* last = nullptr;
+    value = std::strtof(buffer, &last);
+    return (last == buffer + size) ? p : nullptr;
+}
+
+const char* TextFile::parse(const char* p, const char* end, double& value)
+{
+    char buffer[MaxNumberSize + 1];
+    int  size = 0;
+    p = copy_number(skip_blanks(p, end), end, buffer, size);
+    if(!p)
+        return nullptr;
+
+    char* last = nullptr;
+    value = std::strtod(buffer, &last);
+    return (last == buffer + size) ? p : nullptr;
+}
+
+const char* TextFile::skip_blanks(const char* p, const char* end)
+{
+    while(p != end && is_blank(*p))
+        ++p;
+    return p;
+}
+
+} // namespace pdpc
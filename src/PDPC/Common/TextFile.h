@@ -0,0 +1,76 @@
+#pragma once
+
+#include <PDPC/Common/MappedFile.h>
+
+#include <vector>
+
+namespace pdpc {
+
+//!
+//! \brief The TextFile class maps a text file and splits it in line-aligned
+//! chunks so that its lines can be parsed in parallel
+//!
+//! The chunks are found when the file is opened, by counting the lines of each
+//! chunk in parallel. A last line without end of line is a line, an empty file
+//! has no line.
+//!
+class TextFile
+{
+public:
+    TextFile();
+
+public:
+    bool open(const std::string& filename, bool verbose = true);
+    void close();
+
+    inline bool is_open() const {return m_file.is_open();}
+    inline int line_count() const {return m_line_count;}
+
+    //!
+    //! \brief line gives the characters of the line l, without the end of line
+    //!
+    //! Complexity = O(size / chunk count)
+    //!
+    bool line(int l, const char*& begin, const char*& end) const;
+
+    //!
+    //! \brief for_each_line calls f(int l, const char* begin, const char* end) -> bool
+    //! for each line l >= first_line, in parallel, and returns false if any
+    //! call returned false
+    //!
+    template<class FuncT>
+    bool for_each_line(FuncT&& f, int first_line = 0) const;
+
+    // Parsing -----------------------------------------------------------------
+public:
+    //!
+    //! \brief parse reads a value after the blanks at p and returns the position
+    //! after it, or nullptr if there is no valid value
+    //!
+    //! Floating points are converted as by std::strtof/strtod, i.e. as by
+    //! std::istream::operator>>.
+    //!
+    static const char* parse(const char* p, const char* end, int& value);
+    static const char* parse(const char* p, const char* end, float& value);
+    static const char* parse(const char* p, const char* end, double& value);
+
+    //! \brief skip_blanks returns the position of the first non blank char from p
+    static const char* skip_blanks(const char* p, const char* end);
+
+protected:
+    struct Chunk
+    {
+        const char* begin;
+        const char* end;
+        int         first_line;
+        int         line_count;
+    };
+
+    MappedFile         m_file;
+    std::vector<Chunk> m_chunks;
+    int                m_line_count;
+};
+
+} // namespace pdpc
+
+#include <PDPC/Common/TextFile.hpp>
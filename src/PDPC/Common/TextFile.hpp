@@ -0,0 +1,38 @@
+#include <PDPC/Common/TextFile.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace pdpc {
+
+template<class FuncT>
+bool TextFile::for_each_line(FuncT&& f, int first_line) const
+{
+    const int chunk_count = m_chunks.size();
+    std::vector<char> ok(chunk_count, true);
+
+    #pragma omp parallel for schedule(dynamic)
+    for(int c=0; c<chunk_count; ++c)
+    {
+        const Chunk& chunk = m_chunks[c];
+        if(chunk.first_line + chunk.line_count <= first_line)
+            continue;
+
+        const char* begin = chunk.begin;
+        for(int l=chunk.first_line; l<chunk.first_line+chunk.line_count; ++l)
+        {
+            const char* eol = static_cast<const char*>(std::memchr(begin, '\n', chunk.end - begin));
+            const char* end = eol ? eol : chunk.end;
+            if(l >= first_line && !f(l, begin, end))
+            {
+                ok[c] = false;
+                break;
+            }
+            begin = end + 1;
+        }
+    }
+
+    return std::all_of(ok.begin(), ok.end(), [](char chunk_ok){return chunk_ok;});
+}
+
+} // namespace pdpc
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <PDPC/Common/Cpu.h>
+
+#ifdef PDPC_SIMD_X86
+
+#include <immintrin.h>
+
+#define PDPC_TARGET_AVX512 __attribute__((target("avx512f")))
+
+namespace pdpc {
+namespace internal {
+
+//!
+//! \brief avx512_all_lanes enables all the lanes of the zero-masked intrinsics
+//!
+//! GCC 12 implements the unmasked forms of several AVX-512 intrinsics (e.g.
+//! _mm512_min_ps, _mm512_mul_round_ps, _mm512_reduce_add_ps or
+//! _mm512_castps512_ps256) with a self-initialized undefined vector, which
+//! -Wall reports as uninitialized. The kernels use the zero-masked forms
+//! instead, which compute the same values.
+//!
+constexpr __mmask16 avx512_all_lanes = 0xFFFF;
+
+//!
+//! \brief hsum_avx512 returns the sum of the lanes of v
+//!
+//! The halves are added, then the halves of the halves, as
+//! _mm512_reduce_add_ps does, so that the sum is the same.
+//!
+PDPC_TARGET_AVX512 inline float hsum_avx512(__m512 v)
+{
+    const __m256 lo = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xF, _mm512_castps_pd(v), 0));
+    const __m256 hi = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xF, _mm512_castps_pd(v), 1));
+    const __m256 h  = _mm256_add_ps(hi, lo);
+
+    __m128 s = _mm_add_ps(_mm256_extractf128_ps(h, 1), _mm256_castps256_ps128(h));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_movehdup_ps(s));
+    return _mm_cvtss_f32(s);
+}
+
+} // namespace internal
+} // namespace pdpc
+
+#endif // PDPC_SIMD_X86
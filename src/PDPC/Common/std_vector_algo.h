@@ -1,5 +1,7 @@
 #pragma once
 
+#include <PDPC/Common/Assert.h>
+
 #include <vector>
 #include <algorithm>
 
@@ -20,6 +22,13 @@ inline void keep(const std::vector<T,A>& vec, std::vector<T,A>& res, const std::
 template<typename T, class A>
 inline void keep(const std::vector<T,A>& vec, std::vector<T,A>& res, const std::vector<bool>& to_keep);
 
+//! \brief permute reorders vec so that vec[i] is the previous vec[order[i]]
+template<typename T, class A>
+inline void permute(std::vector<T,A>& vec, const std::vector<int>& order);
+
+//! \brief inverse_permutation returns inverse such that inverse[order[i]] = i
+inline std::vector<int> inverse_permutation(const std::vector<int>& order);
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -113,5 +122,28 @@ void keep(const std::vector<T,A>& vec, std::vector<T,A>& res, const std::vector<
     }
 }
 
+template<typename T, class A>
+void permute(std::vector<T,A>& vec, const std::vector<int>& order)
+{
+    PDPC_DEBUG_ASSERT(vec.size() == order.size());
+
+    std::vector<T,A> res(vec.size());
+    for(size_t i = 0; i < order.size(); ++i)
+    {
+        res[i] = std::move(vec[order[i]]);
+    }
+    vec.swap(res);
+}
+
+std::vector<int> inverse_permutation(const std::vector<int>& order)
+{
+    std::vector<int> inverse(order.size());
+    for(size_t i = 0; i < order.size(); ++i)
+    {
+        inverse[order[i]] = i;
+    }
+    return inverse;
+}
+
 } // namespace pdpc
 
@@ -0,0 +1,95 @@
+#include <PDPC/MultiScaleFeatures/FeatureInterpolation.h>
+#include <PDPC/MultiScaleFeatures/MultiScaleFeatures.h>
+#include <PDPC/PointCloud/PointCloud.h>
+#include <PDPC/SpacePartitioning/KdTree.h>
+
+namespace pdpc {
+
+void FeatureInterpolation::interpolate(const PointCloud& points,
+                                       const MultiScaleFeatures& features,
+                                       int i, int j, int k, Scalar scale,
+                                       Vector3& normal,
+                                       Vector2& curvatures)
+{
+    interpolate(points, points.kdtree(), features, i, j, k, scale, normal, curvatures);
+}
+
+void FeatureInterpolation::interpolate(const PointCloud& points,
+                                       const KdTree& kdtree,
+                                       const MultiScaleFeatures& features,
+                                       int i, int j, int k, Scalar scale,
+                                       Vector3& normal,
+                                       Vector2& curvatures)
+{
+    interpolate(points, kdtree, j, features, i, j, k, scale, normal, curvatures);
+}
+
+void FeatureInterpolation::interpolate(const PointCloud& points,
+                                       const KdTree& kdtree,
+                                       int level,
+                                       const MultiScaleFeatures& features,
+                                       int i, int j, int k, Scalar scale,
+                                       Vector3& normal,
+                                       Vector2& curvatures)
+{
+    const Vector3& point = points[i];
+    const Scalar squared_scale = scale * scale;
+
+    normal     = Vector3::Zero();
+    curvatures = Vector2::Zero();
+
+    auto query = kdtree.k_nearest_neighbors(point, k);
+    query.set_level(kdtree.has_levels() ? level : 0);
+
+    Scalar sum_w     = 0;
+    int    idx_first = -1;
+    for(int idx_sample : query)
+    {
+        if(idx_sample < 0 || features.normal(idx_sample,j).isZero()) continue;
+
+        if(idx_first == -1) idx_first = idx_sample;
+
+        const Scalar d = (point - points[idx_sample]).squaredNorm() / squared_scale;
+        if(d < 1)
+        {
+            const Scalar w = (1 - d) * (1 - d);
+            normal     += w * features.normal(idx_sample,j);
+            curvatures += w * features.curvatures(idx_sample,j);
+            sum_w      += w;
+        }
+    }
+
+    if(sum_w > 0 && !normal.isZero())
+    {
+        normal.normalize();
+        curvatures /= sum_w;
+    }
+    else if(idx_first != -1)
+    {
+        // all the stable samples are farther than the scale
+        normal     = features.normal(idx_first,j);
+        curvatures = features.curvatures(idx_first,j);
+    }
+    else
+    {
+        normal     = Vector3::Zero();
+        curvatures = Vector2::Zero();
+    }
+}
+
+void FeatureInterpolation::interpolate(const PointCloud& points,
+                                       MultiScaleFeatures& features,
+                                       const std::vector<bool>& is_computed,
+                                       int j, int k, Scalar scale)
+{
+    const int point_count = points.size();
+
+    #pragma omp parallel for
+    for(int i=0; i<point_count; ++i)
+    {
+        if(is_computed[i]) continue;
+        interpolate(points, features, i, j, k, scale, features.normal(i,j), features.curvatures(i,j));
+    }
+}
+
+} // namespace pdpc
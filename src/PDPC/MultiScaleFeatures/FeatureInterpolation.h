@@ -0,0 +1,67 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+
+namespace pdpc {
+
+class PointCloud;
+class KdTree;
+class MultiScaleFeatures;
+
+//!
+//! \brief The FeatureInterpolation class fills the features of a given scale
+//! from the features of the sample points the kd-tree is built on
+//!
+class FeatureInterpolation
+{
+public:
+    //!
+    //! \brief interpolate blends the normals and curvatures of the k nearest
+    //! samples of the point i using a smooth kernel of support the scale
+    //!
+    //! The samples are the points of the level j of the kd-tree (see
+    //! KdTree::build_levels), or all the points of the kd-tree if it has no
+    //! levels.
+    //!
+    //! With k = 1 the features of the nearest sample are copied.
+    //! Unstable samples (null normal) are ignored and the point gets a null
+    //! normal if no stable sample is found.
+    //!
+    static void interpolate(const PointCloud& points,
+                            const MultiScaleFeatures& features,
+                            int i, int j, int k, Scalar scale,
+                            Vector3& normal,
+                            Vector2& curvatures);
+
+    //! \brief interpolate uses the given kd-tree built on the points instead of the one of the point cloud
+    static void interpolate(const PointCloud& points,
+                            const KdTree& kdtree,
+                            const MultiScaleFeatures& features,
+                            int i, int j, int k, Scalar scale,
+                            Vector3& normal,
+                            Vector2& curvatures);
+
+    //!
+    //! \brief interpolate takes the samples at the given level of the kd-tree
+    //! and their features at the scale j of features, e.g. when features only
+    //! stores the current scale
+    //!
+    static void interpolate(const PointCloud& points,
+                            const KdTree& kdtree,
+                            int level,
+                            const MultiScaleFeatures& features,
+                            int i, int j, int k, Scalar scale,
+                            Vector3& normal,
+                            Vector2& curvatures);
+
+    //!
+    //! \brief interpolate fills the features at scale j of all the points
+    //! that are not flagged as computed
+    //!
+    static void interpolate(const PointCloud& points,
+                            MultiScaleFeatures& features,
+                            const std::vector<bool>& is_computed,
+                            int j, int k, Scalar scale);
+};
+
+} // namespace pdpc
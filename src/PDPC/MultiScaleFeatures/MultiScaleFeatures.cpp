@@ -1,15 +1,94 @@
 #include <PDPC/MultiScaleFeatures/MultiScaleFeatures.h>
+#include <PDPC/MultiScaleFeatures/MultiScaleFeaturesFormat.h>
+#include <PDPC/Common/MappedFile.h>
+#include <PDPC/Common/TextFile.h>
 #include <PDPC/Common/Log.h>
 
 #include <fstream>
+#include <cstring>
 
 namespace pdpc {
 
+namespace {
+
+MultiScaleFeatures::Storage storage_of(uint32_t dtype)
+{
+    switch(dtype)
+    {
+    case MultiScaleFeaturesFormat::DTypeOct16Half: return MultiScaleFeatures::StorageOct16;
+    case MultiScaleFeaturesFormat::DTypeOct32Half: return MultiScaleFeatures::StorageOct32;
+    default:                                       return MultiScaleFeatures::StorageFloat;
+    }
+}
+
+} // namespace
+
 MultiScaleFeatures::MultiScaleFeatures(int point_count, int scale_count) :
     m_point_count(point_count),
     m_scale_count(scale_count),
-    m_normals(point_count * scale_count),
-    m_curvatures(point_count * scale_count)
+    m_normals(std::size_t(point_count) * scale_count),
+    m_curvatures(std::size_t(point_count) * scale_count),
+    m_storage(StorageFloat),
+    m_packed_normals(),
+    m_packed_curvatures(),
+    m_normals_data(m_normals.data()),
+    m_curvatures_data(m_curvatures.data()),
+    m_packed_normals_data(nullptr),
+    m_packed_curvatures_data(nullptr),
+    m_mapped_file(nullptr)
+{
+}
+
+MultiScaleFeatures::MultiScaleFeatures(const MultiScaleFeatures& other) :
+    MultiScaleFeatures()
+{
+    *this = other;
+}
+
+MultiScaleFeatures::MultiScaleFeatures(MultiScaleFeatures&& other) :
+    MultiScaleFeatures()
+{
+    *this = std::move(other);
+}
+
+MultiScaleFeatures& MultiScaleFeatures::operator = (const MultiScaleFeatures& other)
+{
+    if(this == &other)
+        return *this;
+
+    // the copy of mapped features owns its arrays
+    this->allocate(other.m_point_count, other.m_scale_count, other.m_storage);
+    if(m_scale_count > 0)
+    {
+        const uint64_t count = uint64_t(m_point_count) * m_scale_count;
+        std::memcpy(this->normals_slab(0),    other.normals_slab(0),    count * MultiScaleFeaturesFormat::normal_size(dtype()));
+        std::memcpy(this->curvatures_slab(0), other.curvatures_slab(0), count * MultiScaleFeaturesFormat::curvatures_size(dtype()));
+    }
+    return *this;
+}
+
+MultiScaleFeatures& MultiScaleFeatures::operator = (MultiScaleFeatures&& other)
+{
+    if(this == &other)
+        return *this;
+
+    m_point_count            = other.m_point_count;
+    m_scale_count            = other.m_scale_count;
+    m_normals                = std::move(other.m_normals);
+    m_curvatures             = std::move(other.m_curvatures);
+    m_storage                = other.m_storage;
+    m_packed_normals         = std::move(other.m_packed_normals);
+    m_packed_curvatures      = std::move(other.m_packed_curvatures);
+    m_normals_data           = other.m_normals_data;
+    m_curvatures_data        = other.m_curvatures_data;
+    m_packed_normals_data    = other.m_packed_normals_data;
+    m_packed_curvatures_data = other.m_packed_curvatures_data;
+    m_mapped_file            = std::move(other.m_mapped_file);
+    other.clear();
+    return *this;
+}
+
+MultiScaleFeatures::~MultiScaleFeatures()
 {
 }
 
@@ -43,17 +122,31 @@ bool MultiScaleFeatures::save(const std::string& filename, bool v) const
     else
     {
         const std::string filename_bin = (ext == "bin") ? (filename) : (filename + ".bin");
-        std::ofstream ofs(filename_bin);
+        std::ofstream ofs(filename_bin, std::ios::out | std::ios::binary | std::ios::trunc);
         if(!ofs.is_open())
         {
             error().iff(v) << "Failed to open output features file " << filename_bin;
             return false;
         }
 
-        ofs.write(reinterpret_cast<const char*>(&m_point_count), sizeof(int));
-        ofs.write(reinterpret_cast<const char*>(&m_scale_count), sizeof(int));
-        ofs.write(reinterpret_cast<const char*>(m_normals.data()),    3 * sizeof(Scalar) * m_normals.size());
-        ofs.write(reinterpret_cast<const char*>(m_curvatures.data()), 2 * sizeof(Scalar) * m_curvatures.size());
+        const auto dtype = MultiScaleFeaturesFormat::DType(this->dtype());
+        const auto normals_bytes    = m_point_count * MultiScaleFeaturesFormat::normal_size(dtype);
+        const auto curvatures_bytes = m_point_count * MultiScaleFeaturesFormat::curvatures_size(dtype);
+
+        MultiScaleFeaturesFormat::write_header(ofs, m_point_count, m_scale_count, dtype);
+        for(int j=0; j<m_scale_count; ++j)
+        {
+            const auto offsets = MultiScaleFeaturesFormat::offsets(m_point_count, m_scale_count, j, dtype);
+            ofs.seekp(offsets.normals);
+            ofs.write(this->normals_slab(j), normals_bytes);
+            ofs.seekp(offsets.curvatures);
+            ofs.write(this->curvatures_slab(j), curvatures_bytes);
+        }
+        if(!ofs.good())
+        {
+            error().iff(v) << "Failed to write features file " << filename_bin;
+            return false;
+        }
 
         info().iff(v) << m_point_count << "x" << m_scale_count
                       << " features saved to " << filename_bin;
@@ -69,47 +162,108 @@ bool MultiScaleFeatures::load(const std::string& filename, bool v)
     const std::string ext = filename.substr(filename.find_last_of(".") + 1);
     if(ext == "txt")
     {
-        std::ifstream ifs(filename);
-        if(!ifs.is_open())
+        TextFile file;
+        if(!file.open(filename, false))
         {
             error().iff(v) << "Failed to open input features file " << filename;
             return false;
         }
 
-        ifs >> m_point_count;
-        ifs >> m_scale_count;
+        // header line then one line per point
+        int point_count = 0;
+        int scale_count = 0;
+        const char* begin = nullptr;
+        const char* end   = nullptr;
+        if(!file.line(0, begin, end) ||
+           !(begin = TextFile::parse(begin, end, point_count)) ||
+           !(begin = TextFile::parse(begin, end, scale_count)) ||
+           file.line_count() < point_count + 1)
+        {
+            error().iff(v) << "Failed to read the header of features file " << filename;
+            return false;
+        }
 
-        this->resize(m_point_count, m_scale_count);
+        this->resize(point_count, scale_count);
 
-        for(int i=0; i<m_point_count; ++i)
+        const bool ok = file.for_each_line([this](int l, const char* p, const char* end) -> bool
         {
-            for(int j=0; j<m_scale_count; ++j)
+            const int i = l - 1;
+            if(i >= m_point_count)
+                return true;
+
+            for(int j=0; j<m_scale_count && p; ++j)
             {
-                ifs >> normal(i,j)[0];
-                ifs >> normal(i,j)[1];
-                ifs >> normal(i,j)[2];
-                ifs >> k1(i,j);
-                ifs >> k2(i,j);
+                Vector3& n = normal(i,j);
+                Vector2& k = curvatures(i,j);
+                p = TextFile::parse(p, end, n[0]);
+                if(p) p = TextFile::parse(p, end, n[1]);
+                if(p) p = TextFile::parse(p, end, n[2]);
+                if(p) p = TextFile::parse(p, end, k[0]);
+                if(p) p = TextFile::parse(p, end, k[1]);
             }
+            return p != nullptr;
+        }, 1);
+
+        if(!ok)
+        {
+            error().iff(v) << "Failed to read features file " << filename;
+            this->clear();
+            return false;
         }
         return true;
     }
     else if(ext == "bin")
     {
-        std::ifstream ifs(filename);
+        std::ifstream ifs(filename, std::ios::in | std::ios::binary);
         if(!ifs.is_open())
         {
             error().iff(v) << "Failed to open input features file " << filename;
             return false;
         }
 
-        ifs.read(reinterpret_cast<char*>(&m_point_count), sizeof(int));
-        ifs.read(reinterpret_cast<char*>(&m_scale_count), sizeof(int));
+        char magic[8] = {0};
+        ifs.read(magic, sizeof(magic));
+        ifs.clear();
+        ifs.seekg(0);
 
-        this->resize(m_point_count, m_scale_count);
+        if(MultiScaleFeaturesFormat::has_magic(magic, sizeof(magic)))
+        {
+            MultiScaleFeaturesFormat::Header header;
+            std::vector<MultiScaleFeaturesFormat::Offsets> offsets;
+            if(!MultiScaleFeaturesFormat::read_header(ifs, header, offsets, filename, v))
+                return false;
 
-        ifs.read(reinterpret_cast<char*>(m_normals.data()),    3 * sizeof(Scalar) * m_normals.size());
-        ifs.read(reinterpret_cast<char*>(m_curvatures.data()), 2 * sizeof(Scalar) * m_curvatures.size());
+            this->allocate(header.point_count, header.scale_count, storage_of(header.dtype));
+
+            const auto normals_bytes    = m_point_count * MultiScaleFeaturesFormat::normal_size(header.dtype);
+            const auto curvatures_bytes = m_point_count * MultiScaleFeaturesFormat::curvatures_size(header.dtype);
+            for(int j=0; j<m_scale_count; ++j)
+            {
+                ifs.seekg(offsets[j].normals);
+                ifs.read(this->normals_slab(j), normals_bytes);
+                ifs.seekg(offsets[j].curvatures);
+                ifs.read(this->curvatures_slab(j), curvatures_bytes);
+            }
+        }
+        else
+        {
+            warning().iff(v) << "Features file " << filename << " has no header (raw binary of a previous version)";
+
+            ifs.read(reinterpret_cast<char*>(&m_point_count), sizeof(int));
+            ifs.read(reinterpret_cast<char*>(&m_scale_count), sizeof(int));
+
+            this->resize(m_point_count, m_scale_count);
+
+            ifs.read(reinterpret_cast<char*>(m_normals.data()),    3 * sizeof(Scalar) * m_normals.size());
+            ifs.read(reinterpret_cast<char*>(m_curvatures.data()), 2 * sizeof(Scalar) * m_curvatures.size());
+        }
+
+        if(!ifs.good())
+        {
+            error().iff(v) << "Failed to read features file " << filename;
+            this->clear();
+            return false;
+        }
 
         info().iff(v) << m_point_count << "x" << m_scale_count
                       << " features loaded from " << filename;
@@ -122,20 +276,228 @@ bool MultiScaleFeatures::load(const std::string& filename, bool v)
     return true;
 }
 
+bool MultiScaleFeatures::map(const std::string& filename, bool v)
+{
+    this->clear();
+
+    auto file = std::unique_ptr<MappedFile>(new MappedFile());
+    if(!file->open(filename, v))
+        return false;
+
+    if(!MultiScaleFeaturesFormat::has_magic(file->data(), file->size()))
+    {
+        error().iff(v) << "Features file " << filename << " has no header and cannot be mapped";
+        return false;
+    }
+
+    MultiScaleFeaturesFormat::Header header;
+    std::vector<MultiScaleFeaturesFormat::Offsets> offsets;
+    if(!MultiScaleFeaturesFormat::read_header(file->data(), file->size(), header, offsets, filename, v))
+        return false;
+
+    // the scales must follow each other as they are read at index(i,j)
+    const auto normals_bytes    = header.point_count * MultiScaleFeaturesFormat::normal_size(header.dtype);
+    const auto curvatures_bytes = header.point_count * MultiScaleFeaturesFormat::curvatures_size(header.dtype);
+    for(uint64_t j=1; j<header.scale_count; ++j)
+    {
+        if(offsets[j].normals    != offsets[0].normals    + j * normals_bytes ||
+           offsets[j].curvatures != offsets[0].curvatures + j * curvatures_bytes)
+        {
+            error().iff(v) << "Features file " << filename << " has non contiguous scales and cannot be mapped";
+            return false;
+        }
+    }
+
+    m_point_count = header.point_count;
+    m_scale_count = header.scale_count;
+    m_storage     = storage_of(header.dtype);
+    if(m_scale_count > 0)
+    {
+        char* normals    = file->data() + offsets[0].normals;
+        char* curvatures = file->data() + offsets[0].curvatures;
+        if(m_storage == StorageFloat)
+        {
+            m_normals_data    = reinterpret_cast<Vector3*>(normals);
+            m_curvatures_data = reinterpret_cast<Vector2*>(curvatures);
+        }
+        else
+        {
+            m_packed_normals_data    = reinterpret_cast<uint16_t*>(normals);
+            m_packed_curvatures_data = reinterpret_cast<uint16_t*>(curvatures);
+        }
+    }
+    m_mapped_file = std::move(file);
+
+    info().iff(v) << m_point_count << "x" << m_scale_count
+                  << " features mapped from " << filename;
+    return true;
+}
+
+bool MultiScaleFeatures::is_mapped() const
+{
+    return m_mapped_file != nullptr;
+}
+
 void MultiScaleFeatures::clear()
 {
     m_point_count = 0;
     m_scale_count = 0;
     m_normals.clear();
     m_curvatures.clear();
+    m_storage = StorageFloat;
+    m_packed_normals.clear();
+    m_packed_curvatures.clear();
+    m_mapped_file = nullptr;
+    this->reset_data();
 }
 
 void MultiScaleFeatures::resize(int point_count, int scale_count)
 {
+    this->allocate(point_count, scale_count, StorageFloat);
+}
+
+void MultiScaleFeatures::set_storage(Storage storage)
+{
+    if(storage == m_storage)
+        return;
+
+    MultiScaleFeatures features;
+    features.allocate(m_point_count, m_scale_count, storage);
+
+    // the const accessors decode any storage
+    const MultiScaleFeatures& self = *this;
+
+    #pragma omp parallel for collapse(2)
+    for(int j=0; j<m_scale_count; ++j)
+    {
+        for(int i=0; i<m_point_count; ++i)
+            features.store(index(i,j), self.normal(i,j), self.curvatures(i,j));
+    }
+
+    *this = std::move(features);
+}
+
+void MultiScaleFeatures::reorder(const std::vector<int>& order)
+{
+    PDPC_DEBUG_ASSERT(int(order.size()) == m_point_count);
+
+    MultiScaleFeatures features;
+    features.allocate(m_point_count, m_scale_count, m_storage);
+
+    // the encoded features are moved as they are
+    const uint64_t normal_size     = MultiScaleFeaturesFormat::normal_size(this->dtype());
+    const uint64_t curvatures_size = MultiScaleFeaturesFormat::curvatures_size(this->dtype());
+    for(int j=0; j<m_scale_count; ++j)
+    {
+        const char* normals    = this->normals_slab(j);
+        const char* curvatures = this->curvatures_slab(j);
+        char* new_normals    = features.normals_slab(j);
+        char* new_curvatures = features.curvatures_slab(j);
+
+        #pragma omp parallel for
+        for(int i=0; i<m_point_count; ++i)
+        {
+            std::memcpy(new_normals    + i * normal_size,     normals    + order[i] * normal_size,     normal_size);
+            std::memcpy(new_curvatures + i * curvatures_size, curvatures + order[i] * curvatures_size, curvatures_size);
+        }
+    }
+
+    *this = std::move(features);
+}
+
+uint32_t MultiScaleFeatures::dtype() const
+{
+    switch(m_storage)
+    {
+    case StorageOct16: return MultiScaleFeaturesFormat::DTypeOct16Half;
+    case StorageOct32: return MultiScaleFeaturesFormat::DTypeOct32Half;
+    default:           return MultiScaleFeaturesFormat::scalar_dtype();
+    }
+}
+
+void MultiScaleFeatures::allocate(int point_count, int scale_count, Storage storage)
+{
+    const std::size_t count = std::size_t(point_count) * scale_count;
+
     m_point_count = point_count;
     m_scale_count = scale_count;
-    m_normals.resize(point_count * scale_count);
-    m_curvatures.resize(point_count * scale_count);
+    m_storage     = storage;
+    if(storage == StorageFloat)
+    {
+        m_normals.resize(count);
+        m_curvatures.resize(count);
+        m_packed_normals.clear();
+        m_packed_curvatures.clear();
+    }
+    else
+    {
+        m_normals.clear();
+        m_curvatures.clear();
+        m_packed_normals.resize((storage == StorageOct32 ? 2 : 1) * count);
+        m_packed_curvatures.resize(2 * count);
+    }
+    m_mapped_file = nullptr;
+    this->reset_data();
+}
+
+void MultiScaleFeatures::reset_data()
+{
+    m_normals_data           = m_normals.data();
+    m_curvatures_data        = m_curvatures.data();
+    m_packed_normals_data    = m_packed_normals.data();
+    m_packed_curvatures_data = m_packed_curvatures.data();
+}
+
+void MultiScaleFeatures::store(std::size_t idx, const Vector3& normal, const Vector2& curvatures)
+{
+    switch(m_storage)
+    {
+    case StorageFloat:
+        m_normals_data[idx]    = normal;
+        m_curvatures_data[idx] = curvatures;
+        return;
+    case StorageOct16:
+        m_packed_normals_data[idx] = oct_encode16(normal);
+        break;
+    case StorageOct32:
+    {
+        const uint32_t code = oct_encode32(normal);
+        m_packed_normals_data[2*idx + 0] = uint16_t(code);
+        m_packed_normals_data[2*idx + 1] = uint16_t(code >> 16);
+        break;
+    }
+    }
+    m_packed_curvatures_data[2*idx + 0] = float_to_half(curvatures[0]);
+    m_packed_curvatures_data[2*idx + 1] = float_to_half(curvatures[1]);
+}
+
+char* MultiScaleFeatures::normals_slab(int j)
+{
+    const uint64_t offset = uint64_t(j) * m_point_count;
+    switch(m_storage)
+    {
+    case StorageOct16: return reinterpret_cast<char*>(m_packed_normals_data + offset);
+    case StorageOct32: return reinterpret_cast<char*>(m_packed_normals_data + 2 * offset);
+    default:           return reinterpret_cast<char*>(m_normals_data + offset);
+    }
+}
+
+const char* MultiScaleFeatures::normals_slab(int j) const
+{
+    return const_cast<MultiScaleFeatures*>(this)->normals_slab(j);
+}
+
+char* MultiScaleFeatures::curvatures_slab(int j)
+{
+    const uint64_t offset = uint64_t(j) * m_point_count;
+    if(m_storage == StorageFloat)
+        return reinterpret_cast<char*>(m_curvatures_data + offset);
+    return reinterpret_cast<char*>(m_packed_curvatures_data + 2 * offset);
+}
+
+const char* MultiScaleFeatures::curvatures_slab(int j) const
+{
+    return const_cast<MultiScaleFeatures*>(this)->curvatures_slab(j);
 }
 
 } // namespace pdpc
@@ -3,44 +3,134 @@
 #include <PDPC/Common/Defines.h>
 #include <PDPC/Common/Assert.h>
 
+#include <cstdint>
+#include <memory>
+
 namespace pdpc {
 
+class MappedFile;
+
+//!
+//! \brief The MultiScaleFeatures class stores the normal and curvatures of
+//! each point at each scale, scale-major
+//!
+//! The features either own their arrays or read a mapped binary file (see
+//! map()), in which case they are only paged in when accessed.
+//!
+//! The features can be quantized (see set_storage()): the normals are then
+//! octahedral codes and the curvatures half floats, decoded by the const
+//! accessors. The non-const accessors require the float storage.
+//!
 class MultiScaleFeatures
 {
+    // Types -------------------------------------------------------------------
+public:
+    enum Storage
+    {
+        StorageFloat = 0, //!< 20 bytes per point and scale
+        StorageOct16 = 1, //!< 16-bit normals and half curvatures, 6 bytes
+        StorageOct32 = 2  //!< 32-bit normals and half curvatures, 8 bytes
+    };
+
 public:
     MultiScaleFeatures(int point_count = 0, int scale_count = 0);
 
+    MultiScaleFeatures(const MultiScaleFeatures& other);
+    MultiScaleFeatures(MultiScaleFeatures&& other);
+    MultiScaleFeatures& operator = (const MultiScaleFeatures& other);
+    MultiScaleFeatures& operator = (MultiScaleFeatures&& other);
+    ~MultiScaleFeatures();
+
 public:
     bool save(const std::string& filename, bool verbose = true) const;
     bool load(const std::string& filename, bool verbose = true);
 
+    //!
+    //! \brief map reads a binary features file in place, without copy
+    //!
+    //! The mapped features are read-only: the non-const accessors fail on them.
+    //!
+    bool map(const std::string& filename, bool verbose = true);
+    bool is_mapped() const;
+
 public:
     void clear();
+
+    //! \brief resize resets the features to the float storage
     void resize(int point_count, int scale_count);
 
+    //! \brief set_storage converts the features to the given storage
+    void set_storage(Storage storage);
+    inline Storage storage() const;
+
+    //! \brief reorder moves the features of the point order[i] to the index i (see PointCloud::reorder)
+    void reorder(const std::vector<int>& order);
+
 public:
-    inline const Vector3& normal(int i, int j) const;
-    inline       Vector3& normal(int i, int j);
+    //! The non-const accessors require owned float features
+    inline Vector3  normal(int i, int j) const;
+    inline Vector3& normal(int i, int j);
 
-    inline const Vector2& curvatures(int i, int j) const;
-    inline       Vector2& curvatures(int i, int j);
+    inline Vector2  curvatures(int i, int j) const;
+    inline Vector2& curvatures(int i, int j);
 
-    inline const Scalar& k1(int i, int j) const;
-    inline       Scalar& k1(int i, int j);
+    inline Scalar  k1(int i, int j) const;
+    inline Scalar& k1(int i, int j);
 
-    inline const Scalar& k2(int i, int j) const;
-    inline       Scalar& k2(int i, int j);
+    inline Scalar  k2(int i, int j) const;
+    inline Scalar& k2(int i, int j);
 
     inline Scalar plane_dev(int i, int j) const;
 
 public:
-    inline int index(int i, int j) const;
+    //! \brief index is the position of the features of the point i at the scale j, N*S may exceed 2^31
+    inline std::size_t index(int i, int j) const;
+
+    //! \brief normals_data gives the float normals of all the scales, at index(i,j)
+    inline const Vector3* normals_data() const;
+    inline       Vector3* normals_data();
+
+    inline const Vector2* curvatures_data() const;
+    inline       Vector2* curvatures_data();
+
+    //! \brief packed_normals_data gives the codes of the quantized normals (two per entry for StorageOct32)
+    inline const uint16_t* packed_normals_data() const;
+
+    //! \brief packed_curvatures_data gives the half curvatures (two per entry)
+    inline const uint16_t* packed_curvatures_data() const;
+
+    //! \brief dtype returns the dtype of the binary format for the current storage
+    uint32_t dtype() const;
+
+protected:
+    void allocate(int point_count, int scale_count, Storage storage);
+    void reset_data();
+
+    //! \brief store encodes the features at index idx in the current storage
+    void store(std::size_t idx, const Vector3& normal, const Vector2& curvatures);
+
+    //! \brief normals_slab gives the bytes of the normals of the scale j
+    char*       normals_slab(int j);
+    const char* normals_slab(int j) const;
+    char*       curvatures_slab(int j);
+    const char* curvatures_slab(int j) const;
 
 public:
     int m_point_count;
     int m_scale_count;
     std::vector<Vector3> m_normals;
     std::vector<Vector2> m_curvatures;
+
+protected:
+    Storage               m_storage;
+    std::vector<uint16_t> m_packed_normals;
+    std::vector<uint16_t> m_packed_curvatures;
+
+    Vector3*  m_normals_data;           //!< m_normals or the mapped normals
+    Vector2*  m_curvatures_data;        //!< m_curvatures or the mapped curvatures
+    uint16_t* m_packed_normals_data;    //!< m_packed_normals or the mapped codes
+    uint16_t* m_packed_curvatures_data; //!< m_packed_curvatures or the mapped halfs
+    std::unique_ptr<MappedFile> m_mapped_file;
 };
 
 } // namespace pdpc
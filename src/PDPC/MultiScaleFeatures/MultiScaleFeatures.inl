@@ -1,30 +1,55 @@
 #include <PDPC/MultiScaleFeatures/MultiScaleFeatures.h>
+#include <PDPC/MultiScaleFeatures/quantization.h>
 
 namespace pdpc {
 
-const Vector3& MultiScaleFeatures::normal(int i, int j) const
+MultiScaleFeatures::Storage MultiScaleFeatures::storage() const
 {
-    return m_normals[index(i,j)];
+    return m_storage;
+}
+
+Vector3 MultiScaleFeatures::normal(int i, int j) const
+{
+    switch(m_storage)
+    {
+    case StorageOct16:
+        return oct_decode16(m_packed_normals_data[index(i,j)]);
+    case StorageOct32:
+    {
+        const uint16_t* code = m_packed_normals_data + 2 * index(i,j);
+        return oct_decode32(uint32_t(code[0]) | (uint32_t(code[1]) << 16));
+    }
+    default:
+        return m_normals_data[index(i,j)];
+    }
 }
 
 Vector3& MultiScaleFeatures::normal(int i, int j)
 {
-    return m_normals[index(i,j)];
+    PDPC_ASSERT_MSG(m_storage == StorageFloat && !m_mapped_file, "Only the owned float features are writable");
+    return m_normals_data[index(i,j)];
 }
 
-const Vector2& MultiScaleFeatures::curvatures(int i, int j) const
+Vector2 MultiScaleFeatures::curvatures(int i, int j) const
 {
-    return m_curvatures[index(i,j)];
+    if(m_storage == StorageFloat)
+        return m_curvatures_data[index(i,j)];
+
+    const uint16_t* halfs = m_packed_curvatures_data + 2 * index(i,j);
+    return Vector2(half_to_float(halfs[0]), half_to_float(halfs[1]));
 }
 
 Vector2& MultiScaleFeatures::curvatures(int i, int j)
 {
-    return m_curvatures[index(i,j)];
+    PDPC_ASSERT_MSG(m_storage == StorageFloat && !m_mapped_file, "Only the owned float features are writable");
+    return m_curvatures_data[index(i,j)];
 }
 
-const Scalar& MultiScaleFeatures::k1(int i, int j) const
+Scalar MultiScaleFeatures::k1(int i, int j) const
 {
-    return curvatures(i,j)[0];
+    if(m_storage == StorageFloat)
+        return m_curvatures_data[index(i,j)][0];
+    return half_to_float(m_packed_curvatures_data[2 * index(i,j) + 0]);
 }
 
 Scalar& MultiScaleFeatures::k1(int i, int j)
@@ -32,9 +57,11 @@ Scalar& MultiScaleFeatures::k1(int i, int j)
     return curvatures(i,j)[0];
 }
 
-const Scalar& MultiScaleFeatures::k2(int i, int j) const
+Scalar MultiScaleFeatures::k2(int i, int j) const
 {
-    return curvatures(i,j)[1];
+    if(m_storage == StorageFloat)
+        return m_curvatures_data[index(i,j)][1];
+    return half_to_float(m_packed_curvatures_data[2 * index(i,j) + 1]);
 }
 
 Scalar& MultiScaleFeatures::k2(int i, int j)
@@ -42,16 +69,49 @@ Scalar& MultiScaleFeatures::k2(int i, int j)
     return curvatures(i,j)[1];
 }
 
-int MultiScaleFeatures::index(int i, int j) const
+std::size_t MultiScaleFeatures::index(int i, int j) const
 {
     PDPC_DEBUG_ASSERT(0 <= i && i < m_point_count);
     PDPC_DEBUG_ASSERT(0 <= j && j < m_scale_count);
-    return j * m_point_count + i;
+    return std::size_t(j) * m_point_count + i;
+}
+
+const Vector3* MultiScaleFeatures::normals_data() const
+{
+    return m_normals_data;
+}
+
+Vector3* MultiScaleFeatures::normals_data()
+{
+    PDPC_ASSERT_MSG(m_storage == StorageFloat && !m_mapped_file, "Only the owned float features are writable");
+    return m_normals_data;
+}
+
+const Vector2* MultiScaleFeatures::curvatures_data() const
+{
+    return m_curvatures_data;
+}
+
+Vector2* MultiScaleFeatures::curvatures_data()
+{
+    PDPC_ASSERT_MSG(m_storage == StorageFloat && !m_mapped_file, "Only the owned float features are writable");
+    return m_curvatures_data;
+}
+
+const uint16_t* MultiScaleFeatures::packed_normals_data() const
+{
+    return m_packed_normals_data;
+}
+
+const uint16_t* MultiScaleFeatures::packed_curvatures_data() const
+{
+    return m_packed_curvatures_data;
 }
 
 Scalar MultiScaleFeatures::plane_dev(int i, int j) const
 {
-    return std::sqrt( k1(i,j)*k1(i,j) + k2(i,j)*k2(i,j) );
+    const Vector2 k = curvatures(i,j);
+    return std::sqrt( k[0]*k[0] + k[1]*k[1] );
 }
 
 } // namespace pdpc
@@ -0,0 +1,860 @@
+#include <PDPC/MultiScaleFeatures/MultiScaleFeaturesEngine.h>
+#include <PDPC/MultiScaleFeatures/MultiScaleFeatures.h>
+#include <PDPC/MultiScaleFeatures/MultiScaleFeaturesWriter.h>
+#include <PDPC/MultiScaleFeatures/FeatureInterpolation.h>
+#include <PDPC/ScaleSpace/ScaleSampling.h>
+#include <PDPC/ScaleSpace/PoissonDiskSampling.h>
+#include <PDPC/PointCloud/PointCloud.h>
+#include <PDPC/SpacePartitioning/KdTree.h>
+#include <PDPC/SpacePartitioning/HashGrid.h>
+#include <PDPC/Common/Log.h>
+#include <PDPC/Common/IO.h>
+#include <PDPC/Common/Cpu.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <random>
+
+namespace pdpc {
+
+namespace {
+
+constexpr char     CheckpointMagic[8] = "PDPCCKP";
+constexpr uint32_t CheckpointVersion  = 3;
+
+template<typename T>
+void write_vector(std::ostream& os, const std::vector<T>& v)
+{
+    os.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(T));
+}
+
+template<typename T>
+void read_vector(std::istream& is, std::vector<T>& v)
+{
+    is.read(reinterpret_cast<char*>(v.data()), v.size() * sizeof(T));
+}
+
+//!
+//! \brief point_hash fingerprints the points and normals of a point cloud, so
+//! that a checkpoint is not resumed on another input
+//!
+uint64_t point_hash(const PointCloud& points)
+{
+    const int  point_count = points.size();
+    const bool has_normals = points.has_normals();
+
+    // sum of the splitmix64 hashes of the coordinates and of their position
+    uint64_t hash = 0;
+    #pragma omp parallel for reduction(+:hash)
+    for(int i=0; i<point_count; ++i)
+    {
+        float values[6] = {points.point(i)[0], points.point(i)[1], points.point(i)[2], 0, 0, 0};
+        if(has_normals)
+            std::copy(points.normal(i).data(), points.normal(i).data() + 3, values + 3);
+
+        uint64_t z = uint64_t(i);
+        for(float value : values)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            z = (z ^ bits) * 0x9E3779B97F4A7C15ull;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            z ^= z >> 31;
+        }
+        hash += z;
+    }
+    return hash;
+}
+
+} // namespace
+
+MultiScaleFeaturesEngine::MultiScaleFeaturesEngine() :
+    m_mls(),
+    m_alpha(0.1),
+    m_seed(0),
+    m_block_size(256),
+    m_prop_ratio(0),
+    m_prop_k(4),
+    m_prop_check(1000),
+    m_warm_start(WarmStartNone),
+    m_hash_grid(false),
+    m_verbose(false),
+    m_checkpoint(),
+    m_checkpoint_period(0),
+    m_resume(false),
+    m_points(nullptr),
+    m_scales(nullptr),
+    m_features(nullptr),
+    m_writer(nullptr),
+    m_slab(),
+    m_levels(),
+    m_kdtree(nullptr),
+    m_grids(),
+    m_to_compute(),
+    m_to_check(),
+    m_is_computed(),
+    m_remaining_blocks(),
+    m_prerequisites(),
+    m_deviations(),
+    m_convergences(),
+    m_first_scale(0),
+    m_failed_scale(-1),
+    m_checkpoint_timer(),
+    m_warm_points(),
+    m_warm_scales(),
+    m_dependencies()
+{
+}
+
+MultiScaleFeaturesEngine::~MultiScaleFeaturesEngine()
+{
+}
+
+void MultiScaleFeaturesEngine::compute(PointCloud& points, const ScaleSampling& scales, MultiScaleFeatures& features)
+{
+    features.resize(points.size(), scales.size());
+
+    m_features = &features;
+    this->run(points, scales);
+    m_features = nullptr;
+}
+
+bool MultiScaleFeaturesEngine::compute(PointCloud& points, const ScaleSampling& scales, MultiScaleFeaturesWriter& writer)
+{
+    PDPC_DEBUG_ASSERT(writer.is_open());
+    PDPC_DEBUG_ASSERT(writer.point_count() == points.size());
+    PDPC_DEBUG_ASSERT(writer.scale_count() == scales.size());
+
+    m_slab.resize(points.size(), 1);
+
+    m_writer = &writer;
+    m_failed_scale = -1;
+    this->run(points, scales);
+    m_writer = nullptr;
+
+    m_slab.clear();
+    return m_failed_scale < 0;
+}
+
+// Parameters ------------------------------------------------------------------
+
+const MultiScaleFeaturesEngine::Operator& MultiScaleFeaturesEngine::mls() const
+{
+    return m_mls;
+}
+
+MultiScaleFeaturesEngine::Operator& MultiScaleFeaturesEngine::mls()
+{
+    return m_mls;
+}
+
+void MultiScaleFeaturesEngine::set_alpha(Scalar alpha)
+{
+    m_alpha = alpha;
+}
+
+void MultiScaleFeaturesEngine::set_seed(int seed)
+{
+    m_seed = seed;
+}
+
+void MultiScaleFeaturesEngine::set_block_size(int block_size)
+{
+    m_block_size = std::max(1, block_size);
+}
+
+void MultiScaleFeaturesEngine::set_interpolation(Scalar ratio, int k, int check_count)
+{
+    m_prop_ratio = ratio;
+    m_prop_k     = k;
+    m_prop_check = check_count;
+}
+
+void MultiScaleFeaturesEngine::set_warm_start(WarmStart warm_start)
+{
+    m_warm_start = warm_start;
+}
+
+void MultiScaleFeaturesEngine::set_checkpoint(const std::string& filename, Scalar period)
+{
+    m_checkpoint        = filename;
+    m_checkpoint_period = period;
+}
+
+void MultiScaleFeaturesEngine::set_resume(bool resume)
+{
+    m_resume = resume;
+}
+
+void MultiScaleFeaturesEngine::set_hash_grid(bool hash_grid)
+{
+    m_hash_grid = hash_grid;
+}
+
+void MultiScaleFeaturesEngine::set_verbose(bool verbose)
+{
+    m_verbose = verbose;
+}
+
+// Accessors -------------------------------------------------------------------
+
+const std::vector<int>& MultiScaleFeaturesEngine::levels() const
+{
+    return m_levels;
+}
+
+const KdTree& MultiScaleFeaturesEngine::kdtree() const
+{
+    return *m_kdtree.get();
+}
+
+const MultiScaleFeaturesEngine::Deviation& MultiScaleFeaturesEngine::deviation(int j) const
+{
+    return m_deviations[j];
+}
+
+const MultiScaleFeaturesEngine::Convergence& MultiScaleFeaturesEngine::convergence(int j) const
+{
+    return m_convergences[j];
+}
+
+bool MultiScaleFeaturesEngine::is_interpolated(int j) const
+{
+    return !m_is_computed[j].empty();
+}
+
+// Internal --------------------------------------------------------------------
+
+void MultiScaleFeaturesEngine::run(PointCloud& points, const ScaleSampling& scales)
+{
+    PDPC_DEBUG_ASSERT(points.has_normals());
+    PDPC_DEBUG_ASSERT(points.has_kdtree());
+
+    const int point_count = points.size();
+    const int scale_count = scales.size();
+
+    m_points = &points;
+    m_scales = &scales;
+
+    m_levels.assign(point_count, 0);
+    m_kdtree = nullptr;
+    m_grids.assign(scale_count, nullptr);
+    m_to_compute.assign(scale_count, std::vector<int>());
+    m_to_check.assign(scale_count, std::vector<int>());
+    m_is_computed.assign(scale_count, std::vector<bool>());
+    m_remaining_blocks.assign(scale_count, 0);
+    m_deviations.assign(scale_count, Deviation());
+    m_deviations[0].compute_count = point_count;
+    m_convergences.assign(scale_count, Convergence());
+    m_warm_points.clear();
+    m_warm_scales.clear();
+    if(m_warm_start != WarmStartNone)
+    {
+        m_warm_points.assign(point_count, Vector3::Zero());
+        m_warm_scales.assign(point_count, -1);
+    }
+
+    // the scales written before an interruption are skipped
+    m_first_scale = m_writer && m_resume ? this->load_checkpoint() : 0;
+    for(int j=0; j<m_first_scale; ++j)
+        m_writer->skip(j);
+    m_checkpoint_timer.restart();
+
+    // in streaming mode a scale waits for the previous one (and the first
+    // coarse scale for the levels too)
+    const int level_scale = std::max(1, m_first_scale);
+    m_prerequisites.assign(scale_count, 1);
+    if(m_first_scale == 0 && scale_count > 1) m_prerequisites[1] = 2;
+
+    // the finest scale queries all the points
+    if(m_hash_grid && m_first_scale == 0 && scale_count > 0)
+        m_grids[0] = std::make_shared<HashGrid>(m_points->points_ptr(), scales[0]);
+
+    #pragma omp parallel
+    #pragma omp single
+    {
+        if(m_writer)
+        {
+            #pragma omp task
+            {
+                this->compute_levels();
+                this->release_scale(level_scale);
+            }
+
+            if(m_first_scale == 0 && scale_count > 0)
+                this->spawn_scale(0);
+        }
+        else if(m_warm_start != WarmStartNone)
+        {
+            this->spawn_chains();
+        }
+        else
+        {
+            // the coarser scales wait for the multi-resolution
+            #pragma omp task
+            {
+                this->compute_levels();
+                for(int j=1; j<scale_count; ++j)
+                    this->spawn_scale(j);
+            }
+
+            // the finest scale does not need it
+            if(scale_count > 0)
+                this->spawn_scale(0);
+        }
+    }
+
+    const int scale_end = m_failed_scale < 0 ? scale_count : m_failed_scale + 1;
+    for(int j=0; j<scale_end; ++j)
+    {
+        const Deviation&   dev  = m_deviations[j];
+        const Convergence& conv = m_convergences[j];
+        const Scalar step_mean = Scalar(conv.step_count) / std::max(1, dev.compute_count);
+        if(this->is_interpolated(j))
+        {
+            info().iff(m_verbose) << "  " << j+1 << "/" << scale_count << ": "
+                                  << dev.compute_count << "/" << point_count << " points evaluated"
+                                  << " (" << step_mean << " steps/point, " << conv.unstable_count << " unstable"
+                                  << ", " << conv.warm_count << " warm-started)"
+                                  << ", deviation on " << dev.check_count << " points:"
+                                  << " angle mean = " << dev.angle_mean << "° max = " << dev.angle_max << "°"
+                                  << ", curvature mean = " << dev.curvature_mean << " max = " << dev.curvature_max;
+        }
+        else
+        {
+            info().iff(m_verbose) << "  " << j+1 << "/" << scale_count << ": "
+                                  << dev.compute_count << "/" << point_count << " points evaluated"
+                                  << " (" << step_mean << " steps/point, " << conv.unstable_count << " unstable"
+                                  << ", " << conv.warm_count << " warm-started)";
+        }
+    }
+
+    // all the scales are written, otherwise the checkpoint allows to resume
+    if(m_writer && m_failed_scale < 0 && !m_checkpoint.empty())
+        std::remove(m_checkpoint.c_str());
+
+    m_warm_points.clear();
+    m_warm_scales.clear();
+    m_dependencies.clear();
+    m_grids.clear();
+
+    m_points = nullptr;
+    m_scales = nullptr;
+}
+
+void MultiScaleFeaturesEngine::compute_levels()
+{
+    const int point_count = m_points->size();
+    const int scale_count = m_scales->size();
+
+    // the level of a point is the last scale whose nested poisson disk
+    // sampling contains it, so that a single kdtree serves all the scales
+    // (the levels are restored from the checkpoint when resuming)
+    if(m_first_scale == 0)
+    {
+        PoissonDiskSampling poisson(m_seed);
+        std::vector<int> sampling(point_count);
+        std::vector<int> sampling2;
+        std::iota(sampling.begin(), sampling.end(), 0);
+
+        for(int j=1; j<scale_count; ++j)
+        {
+            // samples are at least 2*alpha*scale apart
+            const Scalar radius = 2 * m_alpha * (*m_scales)[j];
+
+            poisson.sample(m_points->points_data(), sampling, radius, sampling2);
+            std::swap(sampling, sampling2);
+
+            for(int idx : sampling) m_levels[idx] = j;
+        }
+    }
+
+    m_kdtree = std::make_shared<KdTree>(m_points->points_ptr());
+    m_kdtree->build_levels(m_levels);
+
+    // the grid of a scale only holds the points of its level
+    if(m_hash_grid)
+    {
+        for(int j=std::max(1, m_first_scale); j<scale_count; ++j)
+        {
+            std::vector<Index> sampling;
+            for(int i=0; i<point_count; ++i)
+                if(m_levels[i] >= j) sampling.push_back(i);
+            m_grids[j] = std::make_shared<HashGrid>(m_points->points_ptr(), (*m_scales)[j], sampling);
+        }
+    }
+
+    // evaluate all the points (empty list) or only the samples and a
+    // validation set, drawn in scale order for reproducibility
+    std::mt19937 rng(m_seed);
+    for(int j=1; j<scale_count; ++j)
+    {
+        const int sample_count = std::count_if(m_levels.begin(), m_levels.end(), [j](int l){return l >= j;});
+        if(sample_count >= m_prop_ratio * point_count)
+        {
+            m_deviations[j].compute_count = point_count;
+            continue;
+        }
+
+        std::vector<bool>& is_computed = m_is_computed[j];
+        std::vector<int>&  to_compute  = m_to_compute[j];
+        std::vector<int>&  to_check    = m_to_check[j];
+
+        is_computed.resize(point_count);
+        for(int i=0; i<point_count; ++i)
+        {
+            is_computed[i] = m_levels[i] >= j;
+            if(is_computed[i])
+                to_compute.push_back(i);
+            else
+                to_check.push_back(i);
+        }
+        std::shuffle(to_check.begin(), to_check.end(), rng);
+        to_check.resize(std::min(int(to_check.size()), std::max(0, m_prop_check)));
+        to_compute.insert(to_compute.end(), to_check.begin(), to_check.end());
+        for(int idx : to_check) is_computed[idx] = true;
+
+        m_deviations[j].compute_count = to_compute.size();
+        m_deviations[j].check_count   = to_check.size();
+    }
+}
+
+void MultiScaleFeaturesEngine::spawn_scale(int j)
+{
+    const int compute_count = m_deviations[j].compute_count;
+    const int block_count   = (compute_count + m_block_size - 1) / m_block_size;
+
+    m_remaining_blocks[j] = block_count;
+    if(block_count == 0)
+    {
+        this->finish_scale(j);
+        return;
+    }
+
+    for(int b=0; b<block_count; ++b)
+    {
+        #pragma omp task firstprivate(j,b)
+        {
+            this->evaluate_block(j, b);
+            this->end_block(j);
+        }
+    }
+}
+
+void MultiScaleFeaturesEngine::spawn_chains()
+{
+    const int point_count = m_points->size();
+    const int scale_count = m_scales->size();
+    const int block_count = (point_count + m_block_size - 1) / m_block_size;
+    const int levels      = scale_count * block_count;
+
+    // only the addresses of the dependencies matter, they are taken from the
+    // member since GCC reports a local pointer used only in depend as unused
+    m_dependencies.assign(levels + 1, 0);
+
+    #pragma omp task depend(out: m_dependencies.data()[levels])
+    this->compute_levels();
+
+    m_remaining_blocks.assign(scale_count, block_count);
+    for(int j=0; j<scale_count; ++j)
+    {
+        for(int b=0; b<block_count; ++b)
+        {
+            if(j == 0)
+            {
+                #pragma omp task firstprivate(j,b) depend(out: m_dependencies.data()[b])
+                {
+                    this->evaluate_range(j, b);
+                    this->end_block(j);
+                }
+            }
+            else
+            {
+                // the same points at the previous scale
+                #pragma omp task firstprivate(j,b) depend(in: m_dependencies.data()[levels], m_dependencies.data()[(j-1) * block_count + b]) depend(out: m_dependencies.data()[j * block_count + b])
+                {
+                    this->evaluate_range(j, b);
+                    this->end_block(j);
+                }
+            }
+        }
+    }
+}
+
+void MultiScaleFeaturesEngine::end_block(int j)
+{
+    // the last block of the scale finishes it
+    int remaining_blocks;
+    #pragma omp atomic capture seq_cst
+    remaining_blocks = --m_remaining_blocks[j];
+
+    if(remaining_blocks == 0)
+        this->finish_scale(j);
+}
+
+void MultiScaleFeaturesEngine::evaluate_block(int j, int b)
+{
+    const bool all           = !this->is_interpolated(j);
+    const int  compute_count = m_deviations[j].compute_count;
+    const int  begin         = b * m_block_size;
+    const int  end           = std::min(compute_count, begin + m_block_size);
+
+    // the finest scale uses the kdtree of the point cloud
+    const KdTree& kdtree = j == 0 ? m_points->kdtree() : *m_kdtree;
+
+    Operator mls(m_mls);
+    mls.set_scale((*m_scales)[j]);
+    mls.set_level(j);
+    mls.set_grid(m_grids[j].get());
+
+    Convergence convergence;
+    for(int n=begin; n<end; ++n)
+    {
+        const int i = all ? n : m_to_compute[j][n];
+        this->evaluate(mls, kdtree, i, j, convergence);
+    }
+    this->add_convergence(j, convergence);
+}
+
+void MultiScaleFeaturesEngine::evaluate_range(int j, int b)
+{
+    const bool all         = !this->is_interpolated(j);
+    const int  point_count = m_points->size();
+    const int  begin       = b * m_block_size;
+    const int  end         = std::min(point_count, begin + m_block_size);
+
+    const KdTree& kdtree = j == 0 ? m_points->kdtree() : *m_kdtree;
+
+    Operator mls(m_mls);
+    mls.set_scale((*m_scales)[j]);
+    mls.set_level(j);
+    mls.set_grid(m_grids[j].get());
+
+    Convergence convergence;
+    for(int i=begin; i<end; ++i)
+    {
+        if(all || m_is_computed[j][i])
+            this->evaluate(mls, kdtree, i, j, convergence);
+    }
+    this->add_convergence(j, convergence);
+}
+
+void MultiScaleFeaturesEngine::evaluate(Operator& mls, const KdTree& kdtree, int i, int j, Convergence& convergence)
+{
+    const Scalar scale = (*m_scales)[j];
+    const int    c     = this->column(j);
+    MultiScaleFeatures& features = this->slab();
+
+    // warm start from the previous scale
+    const bool warm = m_warm_start != WarmStartNone && j > 0 && m_warm_scales[i] == j-1;
+    Vector3 p = warm ? m_warm_points[i] : m_points->point(i);
+    mls.compute(*m_points, kdtree, p);
+    convergence.step_count += mls.step_count();
+    if(warm) ++convergence.warm_count;
+
+    if(mls.stable())
+    {
+        features.normal(i,c) = mls.normal();
+        features.k1(i,c) = mls.k1() * scale; // normalized curvature
+        features.k2(i,c) = mls.k2() * scale;
+
+        if(m_warm_start != WarmStartNone)
+        {
+            m_warm_points[i] = p;
+            m_warm_scales[i] = j;
+        }
+    }
+    else
+    {
+        features.normal(i,c) = Vector3::Zero();
+        features.k1(i,c) = 0;
+        features.k2(i,c) = 0;
+        ++convergence.unstable_count;
+    }
+}
+
+void MultiScaleFeaturesEngine::add_convergence(int j, const Convergence& convergence)
+{
+    Convergence& sum = m_convergences[j];
+
+    #pragma omp atomic
+    sum.step_count += convergence.step_count;
+    #pragma omp atomic
+    sum.unstable_count += convergence.unstable_count;
+    #pragma omp atomic
+    sum.warm_count += convergence.warm_count;
+}
+
+void MultiScaleFeaturesEngine::finish_scale(int j)
+{
+    // all the points of the scale are evaluated
+    m_grids[j] = nullptr;
+
+    if(!this->is_interpolated(j))
+    {
+        this->complete_scale(j);
+        return;
+    }
+
+    const Scalar scale = (*m_scales)[j];
+    const int    c     = this->column(j);
+    const MultiScaleFeatures& features = this->slab();
+
+    // deviation between the interpolated and the evaluated features
+    Deviation& dev = m_deviations[j];
+    for(int i : m_to_check[j])
+    {
+        Vector3 n;
+        Vector2 k;
+        FeatureInterpolation::interpolate(*m_points, *m_kdtree, j, features, i, c, m_prop_k, scale, n, k);
+
+        const Scalar dot   = std::min(Scalar(1), std::abs(n.dot(features.normal(i,c))));
+        const Scalar angle = std::acos(dot) * Scalar(180. / M_PI);
+        const Scalar curva = (k - features.curvatures(i,c)).cwiseAbs().maxCoeff();
+        dev.angle_mean     += angle;
+        dev.angle_max       = std::max(dev.angle_max, angle);
+        dev.curvature_mean += curva;
+        dev.curvature_max   = std::max(dev.curvature_max, curva);
+    }
+    dev.angle_mean     /= std::max(1, dev.check_count);
+    dev.curvature_mean /= std::max(1, dev.check_count);
+
+    // the interpolated points only read the evaluated samples
+    const int point_count = m_points->size();
+    const int block_count = (point_count + m_block_size - 1) / m_block_size;
+
+    // all the evaluation blocks are done so the counter is reused
+    m_remaining_blocks[j] = block_count;
+    if(block_count == 0)
+    {
+        this->complete_scale(j);
+        return;
+    }
+
+    for(int b=0; b<block_count; ++b)
+    {
+        #pragma omp task firstprivate(j,b)
+        {
+            this->interpolate_block(j, b);
+
+            int remaining_blocks;
+            #pragma omp atomic capture seq_cst
+            remaining_blocks = --m_remaining_blocks[j];
+
+            if(remaining_blocks == 0)
+                this->complete_scale(j);
+        }
+    }
+}
+
+void MultiScaleFeaturesEngine::interpolate_block(int j, int b)
+{
+    const Scalar scale       = (*m_scales)[j];
+    const int    point_count = m_points->size();
+    const int    begin       = b * m_block_size;
+    const int    end         = std::min(point_count, begin + m_block_size);
+    const int    c           = this->column(j);
+
+    MultiScaleFeatures& features = this->slab();
+
+    for(int i=begin; i<end; ++i)
+    {
+        if(m_is_computed[j][i]) continue;
+        FeatureInterpolation::interpolate(*m_points, *m_kdtree, j, features, i, c, m_prop_k, scale,
+                                          features.normal(i,c), features.curvatures(i,c));
+    }
+}
+
+void MultiScaleFeaturesEngine::complete_scale(int j)
+{
+    if(!m_writer)
+        return;
+
+    // the slab is free for the next scale once written, and a failure (e.g.
+    // a full disk) stops the computation since the next scales wait for it
+    if(!m_writer->write(j, m_slab, 0))
+    {
+        error().iff(m_verbose) << "Failed to write scale " << j+1 << "/" << m_scales->size()
+                               << ", the next scales are not computed";
+        m_failed_scale = j;
+        return;
+    }
+
+    // the levels are ready once scale 1 is computed, and the next scale has
+    // not started yet so the warm-start states are the ones of the scale j
+    const bool checkpoint = !m_checkpoint.empty() && j > 0 && j+1 < int(m_scales->size()) &&
+                            m_checkpoint_timer.time_sec() >= m_checkpoint_period;
+    if(checkpoint && m_writer->flush() && this->save_checkpoint(j+1))
+        m_checkpoint_timer.restart();
+
+    this->release_scale(j+1);
+}
+
+void MultiScaleFeaturesEngine::release_scale(int j)
+{
+    if(j >= int(m_scales->size()))
+        return;
+
+    int prerequisites;
+    #pragma omp atomic capture seq_cst
+    prerequisites = --m_prerequisites[j];
+
+    if(prerequisites == 0)
+        this->spawn_scale(j);
+}
+
+bool MultiScaleFeaturesEngine::save_checkpoint(int scale_done) const
+{
+    const int point_count = m_points->size();
+    const int scale_count = m_scales->size();
+
+    // a complete checkpoint replaces the previous one
+    const std::string tmp = m_checkpoint + ".tmp";
+    std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+    if(!ofs.is_open())
+    {
+        error().iff(m_verbose) << "Failed to open checkpoint file " << tmp;
+        return false;
+    }
+
+    ofs.write(CheckpointMagic, sizeof(CheckpointMagic));
+    IO::write_value(ofs, CheckpointVersion);
+    IO::write_value(ofs, point_count);
+    IO::write_value(ofs, scale_count);
+    IO::write_value(ofs, m_seed);
+    IO::write_value(ofs, m_alpha);
+    IO::write_value(ofs, m_prop_ratio);
+    IO::write_value(ofs, m_prop_k);
+    IO::write_value(ofs, m_prop_check);
+    IO::write_value(ofs, int(m_warm_start));
+    IO::write_value(ofs, m_mls.step_max());
+    IO::write_value(ofs, m_mls.convergence_ratio_min());
+    IO::write_value(ofs, m_mls.reweighting_step());
+    IO::write_value(ofs, m_mls.cache_inflation());
+    IO::write_value(ofs, int(m_mls.batched()));
+    IO::write_value(ofs, int(simd_level()));
+    IO::write_value(ofs, int(m_hash_grid));
+    IO::write_value(ofs, point_hash(*m_points));
+    for(int j=0; j<scale_count; ++j)
+        IO::write_value(ofs, (*m_scales)[j]);
+
+    IO::write_value(ofs, scale_done);
+    write_vector(ofs, m_levels);
+    write_vector(ofs, m_deviations);
+    write_vector(ofs, m_convergences);
+    write_vector(ofs, m_warm_points);
+    write_vector(ofs, m_warm_scales);
+
+    ofs.close();
+    if(ofs.fail() || std::rename(tmp.c_str(), m_checkpoint.c_str()) != 0)
+    {
+        error().iff(m_verbose) << "Failed to save checkpoint file " << m_checkpoint;
+        return false;
+    }
+
+    info().iff(m_verbose) << "Checkpoint saved after scale " << scale_done << "/" << scale_count;
+    return true;
+}
+
+int MultiScaleFeaturesEngine::load_checkpoint()
+{
+    const int point_count = m_points->size();
+    const int scale_count = m_scales->size();
+
+    std::ifstream ifs(m_checkpoint, std::ios::binary);
+    if(!ifs.is_open())
+    {
+        warning().iff(m_verbose) << "No checkpoint file " << m_checkpoint << ", all the scales are computed";
+        return 0;
+    }
+
+    char     magic[sizeof(CheckpointMagic)] = {};
+    uint32_t version = 0;
+    ifs.read(magic, sizeof(magic));
+    IO::read_value(ifs, version);
+    if(!ifs.good() || std::memcmp(magic, CheckpointMagic, sizeof(magic)) != 0 || version != CheckpointVersion)
+    {
+        warning().iff(m_verbose) << "Invalid checkpoint file " << m_checkpoint << ", all the scales are computed";
+        return 0;
+    }
+
+    // the checkpoint must come from the same computation on the same points
+    int    ckp_point_count = 0, ckp_scale_count = 0, ckp_seed = 0, ckp_prop_k = 0, ckp_prop_check = 0, ckp_warm_start = 0;
+    int    ckp_step_max = 0, ckp_reweighting_step = 0, ckp_batched = 0, ckp_simd = 0, ckp_hash_grid = 0;
+    Scalar ckp_alpha = 0, ckp_prop_ratio = 0, ckp_convergence_ratio_min = 0, ckp_cache_inflation = 0;
+    uint64_t ckp_point_hash = 0;
+    IO::read_value(ifs, ckp_point_count);
+    IO::read_value(ifs, ckp_scale_count);
+    IO::read_value(ifs, ckp_seed);
+    IO::read_value(ifs, ckp_alpha);
+    IO::read_value(ifs, ckp_prop_ratio);
+    IO::read_value(ifs, ckp_prop_k);
+    IO::read_value(ifs, ckp_prop_check);
+    IO::read_value(ifs, ckp_warm_start);
+    IO::read_value(ifs, ckp_step_max);
+    IO::read_value(ifs, ckp_convergence_ratio_min);
+    IO::read_value(ifs, ckp_reweighting_step);
+    IO::read_value(ifs, ckp_cache_inflation);
+    IO::read_value(ifs, ckp_batched);
+    IO::read_value(ifs, ckp_simd);
+    IO::read_value(ifs, ckp_hash_grid);
+    IO::read_value(ifs, ckp_point_hash);
+    bool same = ifs.good() &&
+                ckp_point_count == point_count && ckp_scale_count == scale_count &&
+                ckp_seed == m_seed && ckp_alpha == m_alpha && ckp_prop_ratio == m_prop_ratio &&
+                ckp_prop_k == m_prop_k && ckp_prop_check == m_prop_check && ckp_warm_start == int(m_warm_start) &&
+                ckp_step_max == m_mls.step_max() && ckp_convergence_ratio_min == m_mls.convergence_ratio_min() &&
+                ckp_reweighting_step == m_mls.reweighting_step() && ckp_cache_inflation == m_mls.cache_inflation() &&
+                ckp_batched == int(m_mls.batched()) && ckp_simd == int(simd_level()) &&
+                ckp_hash_grid == int(m_hash_grid) && ckp_point_hash == point_hash(*m_points);
+    for(int j=0; same && j<scale_count; ++j)
+    {
+        Scalar scale = 0;
+        IO::read_value(ifs, scale);
+        same = ifs.good() && scale == (*m_scales)[j];
+    }
+    if(!same)
+    {
+        warning().iff(m_verbose) << "Checkpoint file " << m_checkpoint
+                                 << " comes from other parameters, all the scales are computed";
+        return 0;
+    }
+
+    int scale_done = 0;
+    IO::read_value(ifs, scale_done);
+    read_vector(ifs, m_levels);
+    read_vector(ifs, m_deviations);
+    read_vector(ifs, m_convergences);
+    read_vector(ifs, m_warm_points);
+    read_vector(ifs, m_warm_scales);
+    if(!ifs.good() || scale_done < 1 || scale_done > scale_count)
+    {
+        warning().iff(m_verbose) << "Truncated checkpoint file " << m_checkpoint << ", all the scales are computed";
+        m_levels.assign(point_count, 0);
+        m_deviations.assign(scale_count, Deviation());
+        m_deviations[0].compute_count = point_count;
+        m_convergences.assign(scale_count, Convergence());
+        std::fill(m_warm_points.begin(), m_warm_points.end(), Vector3::Zero());
+        std::fill(m_warm_scales.begin(), m_warm_scales.end(), -1);
+        return 0;
+    }
+
+    info().iff(m_verbose) << "Resuming after scale " << scale_done << "/" << scale_count;
+    return scale_done;
+}
+
+MultiScaleFeatures& MultiScaleFeaturesEngine::slab()
+{
+    return m_writer ? m_slab : *m_features;
+}
+
+int MultiScaleFeaturesEngine::column(int j) const
+{
+    return m_writer ? 0 : j;
+}
+
+} // namespace pdpc
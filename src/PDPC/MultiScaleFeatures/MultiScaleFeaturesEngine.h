@@ -0,0 +1,247 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+#include <PDPC/Common/Timer.h>
+#include <PDPC/RIMLS/RIMLSOperator.h>
+#include <PDPC/MultiScaleFeatures/MultiScaleFeatures.h>
+
+#include <memory>
+
+namespace pdpc {
+
+class PointCloud;
+class KdTree;
+class HashGrid;
+class ScaleSampling;
+class MultiScaleFeatures;
+class MultiScaleFeaturesWriter;
+
+//!
+//! \brief The MultiScaleFeaturesEngine class computes the RIMLS features of a
+//! point cloud at all the scales of a scale sampling
+//!
+//! The work is split into (scale, block of points) tasks scheduled by the
+//! OpenMP runtime, so that small coarse scales run concurrently instead of
+//! leaving threads idle:
+//! - the finest scale is evaluated on all the points with the kd-tree of the
+//!   point cloud, which is never modified,
+//! - meanwhile the nested Poisson disk samplings are computed and a second
+//!   kd-tree is built with their levels (see KdTree::build_levels), after
+//!   which the tasks of all the coarser scales are spawned,
+//! - when the last block of a scale is done, its interpolation (if any) is
+//!   spawned as well.
+//!
+//! Each point is evaluated by its own copy of the RIMLS operator on immutable
+//! indexes, so the result does not depend on the thread count or on the
+//! scheduling.
+//!
+//! With set_warm_start, the blocks are ranges of point indices at all the
+//! scales and the block of a scale depends on the same block at the previous
+//! scale, whose projected points seed the RIMLS operator.
+//!
+//! When computed into a MultiScaleFeaturesWriter, the scales are done one
+//! after the other (the blocks of a scale still run in parallel) and each scale
+//! is written as soon as it is complete, so that only the features of one
+//! scale are kept in memory.
+//!
+//! In this streaming mode, set_checkpoint periodically saves what is needed to
+//! resume an interrupted computation from the last written scale: the levels
+//! of the multi-resolution, the reports of the written scales and the
+//! warm-start states. The validation points are drawn again from the seed, so
+//! that a resumed computation writes the same file as an uninterrupted one.
+//!
+class MultiScaleFeaturesEngine
+{
+    // Types -------------------------------------------------------------------
+public:
+    //! \brief Operator only computes the normals and curvatures that are stored
+    using Operator = RIMLSOperatorT<RIMLSCurvatures>;
+
+    //!
+    //! \brief The WarmStart enum selects what a scale reuses from the
+    //! evaluation of the same point at the previous scale
+    //!
+    enum WarmStart
+    {
+        WarmStartNone   = 0, //!< projections start from the input points
+        WarmStartPoint  = 1  //!< projections start from the previous projected points
+    };
+
+    //!
+    //! \brief The Deviation struct reports the difference between the
+    //! interpolated and the evaluated features on the validation points
+    //!
+    struct Deviation
+    {
+        int    compute_count  = 0;
+        int    check_count    = 0;
+        Scalar angle_mean     = 0;
+        Scalar angle_max      = 0;
+        Scalar curvature_mean = 0;
+        Scalar curvature_max  = 0;
+    };
+
+    //!
+    //! \brief The Convergence struct sums the RIMLS steps of the evaluated
+    //! points of a scale
+    //!
+    struct Convergence
+    {
+        long step_count     = 0;
+        int  unstable_count = 0;
+        int  warm_count     = 0; //!< points seeded by the previous scale
+    };
+
+    // MultiScaleFeaturesEngine ------------------------------------------------
+public:
+    MultiScaleFeaturesEngine();
+    ~MultiScaleFeaturesEngine();
+
+    void compute(PointCloud& points, const ScaleSampling& scales, MultiScaleFeatures& features);
+
+    //! \brief compute streams the features of each scale to the opened writer
+    //!
+    //! A scale that fails to be written stops the computation of the next
+    //! ones, and compute then returns false.
+    //!
+    bool compute(PointCloud& points, const ScaleSampling& scales, MultiScaleFeaturesWriter& writer);
+
+    // Parameters --------------------------------------------------------------
+public:
+    //! \brief mls is the operator copied by each task, its scale and level are set by the engine
+    const Operator& mls() const;
+          Operator& mls();
+
+    //! \brief set_alpha sets the sub-sampling factor: samples of scale s are 2*alpha*s apart
+    void set_alpha(Scalar alpha);
+    void set_seed(int seed);
+    void set_block_size(int block_size);
+
+    //!
+    //! \brief set_interpolation evaluates only the samples of a scale when
+    //! they are less than ratio times the points, and interpolates the others
+    //! from their k nearest samples (see FeatureInterpolation)
+    //!
+    //! check_count interpolated points are evaluated as well to measure the
+    //! deviation.
+    //!
+    void set_interpolation(Scalar ratio, int k, int check_count);
+
+    //!
+    //! \brief set_warm_start seeds the RIMLS operator of a point with its
+    //! projection at the previous scale, when it was evaluated and stable there
+    //!
+    void set_warm_start(WarmStart warm_start);
+
+    //!
+    //! \brief set_checkpoint saves a checkpoint to filename after a scale is
+    //! written, when period seconds have passed since the last one (streaming
+    //! mode only)
+    //!
+    //! The checkpoint is removed once all the scales are written.
+    //!
+    void set_checkpoint(const std::string& filename, Scalar period);
+
+    //!
+    //! \brief set_resume skips the scales saved in the checkpoint, if any, the
+    //! writer must then be reopened (see MultiScaleFeaturesWriter::reopen)
+    //!
+    //! A checkpoint saved with other parameters (including the RIMLS ones and
+    //! the SIMD level) or from other points is not resumed, all the scales are
+    //! computed again.
+    //!
+    void set_resume(bool resume);
+
+    //!
+    //! \brief set_hash_grid queries the neighbors of each scale in a HashGrid
+    //! of the points of its level, with cells of the size of the scale,
+    //! instead of the kd-tree
+    //!
+    //! The neighbors are summed in another order, so the features slightly
+    //! differ from the ones computed with the kd-tree.
+    //!
+    void set_hash_grid(bool hash_grid);
+
+    void set_verbose(bool verbose);
+
+    // Accessors ---------------------------------------------------------------
+public:
+    //! \brief levels gives for each point the last scale whose sampling contains it
+    const std::vector<int>& levels() const;
+    const KdTree& kdtree() const;
+    const Deviation& deviation(int j) const;
+    const Convergence& convergence(int j) const;
+    bool  is_interpolated(int j) const;
+
+    // Internal ----------------------------------------------------------------
+protected:
+    void run(PointCloud& points, const ScaleSampling& scales);
+    void compute_levels();
+    void spawn_scale(int j);
+    void spawn_chains();
+    void end_block(int j);
+    void evaluate_block(int j, int b);
+    void evaluate_range(int j, int b);
+    void evaluate(Operator& mls, const KdTree& kdtree, int i, int j, Convergence& convergence);
+    void add_convergence(int j, const Convergence& convergence);
+    void finish_scale(int j);
+    void interpolate_block(int j, int b);
+    void complete_scale(int j);
+    void release_scale(int j);
+
+    //! \brief save_checkpoint saves the state after the scale_done first scales are written
+    bool save_checkpoint(int scale_done) const;
+    //! \brief load_checkpoint returns the count of scales already written, 0 if none
+    int  load_checkpoint();
+
+    //! \brief slab stores the features of the scale j at column(j)
+    MultiScaleFeatures& slab();
+    int column(int j) const;
+
+    // Data --------------------------------------------------------------------
+protected:
+    Operator m_mls;
+
+    Scalar m_alpha;
+    int    m_seed;
+    int    m_block_size;
+
+    Scalar m_prop_ratio;
+    int    m_prop_k;
+    int    m_prop_check;
+
+    WarmStart m_warm_start;
+    bool   m_hash_grid;
+    bool   m_verbose;
+
+    std::string m_checkpoint;
+    Scalar m_checkpoint_period;
+    bool   m_resume;
+
+    // computation state
+    PointCloud*                   m_points;
+    const ScaleSampling*          m_scales;
+    MultiScaleFeatures*           m_features;
+    MultiScaleFeaturesWriter*     m_writer;
+    MultiScaleFeatures            m_slab;         //!< features of the current scale in streaming mode
+    std::vector<int>              m_levels;
+    std::shared_ptr<KdTree>       m_kdtree;
+    std::vector<std::shared_ptr<HashGrid>> m_grids; //!< grid of each scale until it is evaluated (see set_hash_grid)
+    std::vector<std::vector<int>> m_to_compute;
+    std::vector<std::vector<int>> m_to_check;
+    std::vector<std::vector<bool>> m_is_computed;
+    std::vector<int>              m_remaining_blocks;
+    std::vector<int>              m_prerequisites; //!< scales or levels each scale waits for in streaming mode
+    std::vector<Deviation>        m_deviations;
+    std::vector<Convergence>      m_convergences;
+    int                           m_first_scale;  //!< first scale not written before a resume
+    int                           m_failed_scale; //!< scale that failed to be written (the next ones are not spawned), -1 if none
+    Timer                         m_checkpoint_timer;
+
+    // warm start
+    std::vector<Vector3>          m_warm_points;  //!< projection of each point at its warm scale
+    std::vector<int>              m_warm_scales;  //!< scale of each projection, -1 if none
+    std::vector<char>             m_dependencies; //!< task dependency of each (scale, block), then of the levels
+};
+
+} // namespace pdpc
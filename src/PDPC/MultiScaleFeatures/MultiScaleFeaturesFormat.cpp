@@ -0,0 +1,238 @@
+#include <PDPC/MultiScaleFeatures/MultiScaleFeaturesFormat.h>
+#include <PDPC/Common/Log.h>
+
+#include <climits>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <type_traits>
+
+namespace pdpc {
+
+namespace {
+
+constexpr char Magic[8] = "PDPCMSF";
+
+uint64_t align(uint64_t offset)
+{
+    constexpr uint64_t a = MultiScaleFeaturesFormat::Alignment;
+    return (offset + a - 1) / a * a;
+}
+
+uint64_t normals_begin(int scale_count)
+{
+    return align(sizeof(MultiScaleFeaturesFormat::Header) + scale_count * sizeof(MultiScaleFeaturesFormat::Offsets));
+}
+
+uint64_t curvatures_begin(int point_count, int scale_count, uint32_t dtype)
+{
+    const uint64_t normal_size = MultiScaleFeaturesFormat::normal_size(dtype);
+    return align(normals_begin(scale_count) + uint64_t(scale_count) * point_count * normal_size);
+}
+
+} // namespace
+
+constexpr uint32_t MultiScaleFeaturesFormat::Version;
+constexpr uint32_t MultiScaleFeaturesFormat::Endianness;
+constexpr uint64_t MultiScaleFeaturesFormat::Alignment;
+
+// Layout ----------------------------------------------------------------------
+
+MultiScaleFeaturesFormat::DType MultiScaleFeaturesFormat::scalar_dtype()
+{
+    static_assert(std::is_same<Scalar,float>::value || std::is_same<Scalar,double>::value, "Unsupported Scalar");
+    return std::is_same<Scalar,float>::value ? DTypeFloat32 : DTypeFloat64;
+}
+
+bool MultiScaleFeaturesFormat::is_quantized(uint32_t dtype)
+{
+    return dtype == DTypeOct16Half || dtype == DTypeOct32Half;
+}
+
+uint64_t MultiScaleFeaturesFormat::normal_size(uint32_t dtype)
+{
+    switch(dtype)
+    {
+    case DTypeFloat32:   return 3 * sizeof(float);
+    case DTypeFloat64:   return 3 * sizeof(double);
+    case DTypeOct16Half: return sizeof(uint16_t);
+    case DTypeOct32Half: return sizeof(uint32_t);
+    default:             return 0;
+    }
+}
+
+uint64_t MultiScaleFeaturesFormat::curvatures_size(uint32_t dtype)
+{
+    switch(dtype)
+    {
+    case DTypeFloat32:   return 2 * sizeof(float);
+    case DTypeFloat64:   return 2 * sizeof(double);
+    case DTypeOct16Half: return 2 * sizeof(uint16_t);
+    case DTypeOct32Half: return 2 * sizeof(uint16_t);
+    default:             return 0;
+    }
+}
+
+MultiScaleFeaturesFormat::Header MultiScaleFeaturesFormat::make_header(int point_count, int scale_count, DType dtype)
+{
+    Header header;
+    std::memcpy(header.magic, Magic, sizeof(header.magic));
+    header.version     = Version;
+    header.endianness  = Endianness;
+    header.dtype       = dtype;
+    header.header_size = sizeof(Header);
+    header.point_count = point_count;
+    header.scale_count = scale_count;
+    return header;
+}
+
+MultiScaleFeaturesFormat::Offsets MultiScaleFeaturesFormat::offsets(int point_count, int scale_count, int j, DType dtype)
+{
+    Offsets offsets;
+    offsets.normals    = normals_begin(scale_count)                        + uint64_t(j) * point_count * normal_size(dtype);
+    offsets.curvatures = curvatures_begin(point_count, scale_count, dtype) + uint64_t(j) * point_count * curvatures_size(dtype);
+    return offsets;
+}
+
+uint64_t MultiScaleFeaturesFormat::file_size(int point_count, int scale_count, DType dtype)
+{
+    return curvatures_begin(point_count, scale_count, dtype) + uint64_t(scale_count) * point_count * curvatures_size(dtype);
+}
+
+// IO --------------------------------------------------------------------------
+
+bool MultiScaleFeaturesFormat::has_magic(const char* data, std::size_t size)
+{
+    return size >= sizeof(Magic) && std::memcmp(data, Magic, sizeof(Magic)) == 0;
+}
+
+bool MultiScaleFeaturesFormat::write_header(std::ostream& os, int point_count, int scale_count, DType dtype)
+{
+    const Header header = make_header(point_count, scale_count, dtype);
+    os.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+    for(int j=0; j<scale_count; ++j)
+    {
+        const Offsets o = offsets(point_count, scale_count, j, dtype);
+        os.write(reinterpret_cast<const char*>(&o), sizeof(Offsets));
+    }
+
+    // padding up to the first normals
+    const uint64_t padding = normals_begin(scale_count) - sizeof(Header) - scale_count * sizeof(Offsets);
+    const std::vector<char> zeros(padding, 0);
+    os.write(zeros.data(), zeros.size());
+
+    return os.good();
+}
+
+bool MultiScaleFeaturesFormat::check_header(const Header& header, const std::string& filename, bool v)
+{
+    if(!has_magic(header.magic, sizeof(header.magic)))
+    {
+        error().iff(v) << "Features file " << filename << " has no valid magic";
+        return false;
+    }
+    if(header.endianness != Endianness)
+    {
+        error().iff(v) << "Features file " << filename << " was written with another endianness";
+        return false;
+    }
+    if(header.version != Version)
+    {
+        error().iff(v) << "Features file " << filename << " has version " << header.version
+                       << " (supported version is " << Version << ")";
+        return false;
+    }
+    if(header.header_size != sizeof(Header))
+    {
+        error().iff(v) << "Features file " << filename << " has an invalid header size " << header.header_size;
+        return false;
+    }
+    if(header.dtype != scalar_dtype() && !is_quantized(header.dtype))
+    {
+        error().iff(v) << "Features file " << filename << " has dtype " << header.dtype
+                       << " (expected " << scalar_dtype() << " or a quantized dtype)";
+        return false;
+    }
+    // the readers and the writers index the points and the scales with int
+    if(header.point_count > INT_MAX || header.scale_count > INT_MAX)
+    {
+        error().iff(v) << "Features file " << filename << " has too many points (" << header.point_count
+                       << ") or scales (" << header.scale_count << ")";
+        return false;
+    }
+    return true;
+}
+
+bool MultiScaleFeaturesFormat::check_offsets(const Header& header, const std::vector<Offsets>& offsets,
+                                             uint64_t file_size, const std::string& filename, bool v)
+{
+    const uint64_t normals_bytes    = header.point_count * normal_size(header.dtype);
+    const uint64_t curvatures_bytes = header.point_count * curvatures_size(header.dtype);
+    for(uint64_t j=0; j<header.scale_count; ++j)
+    {
+        if(offsets[j].normals    + normals_bytes    > file_size ||
+           offsets[j].curvatures + curvatures_bytes > file_size)
+        {
+            error().iff(v) << "Features file " << filename << " is truncated at scale " << j;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MultiScaleFeaturesFormat::read_header(std::istream& is, Header& header, std::vector<Offsets>& offsets,
+                                           const std::string& filename, bool v)
+{
+    is.seekg(0, std::ios::end);
+    const uint64_t size = is.tellg();
+    is.seekg(0, std::ios::beg);
+
+    is.read(reinterpret_cast<char*>(&header), sizeof(Header));
+    if(!is.good())
+    {
+        error().iff(v) << "Failed to read the header of features file " << filename;
+        return false;
+    }
+    if(!check_header(header, filename, v))
+        return false;
+
+    if(size < sizeof(Header) + header.scale_count * sizeof(Offsets))
+    {
+        error().iff(v) << "Failed to read the offsets of features file " << filename;
+        return false;
+    }
+    offsets.resize(header.scale_count);
+    is.read(reinterpret_cast<char*>(offsets.data()), header.scale_count * sizeof(Offsets));
+    if(!is.good())
+    {
+        error().iff(v) << "Failed to read the offsets of features file " << filename;
+        return false;
+    }
+    return check_offsets(header, offsets, size, filename, v);
+}
+
+bool MultiScaleFeaturesFormat::read_header(const char* data, std::size_t size, Header& header, std::vector<Offsets>& offsets,
+                                           const std::string& filename, bool v)
+{
+    if(size < sizeof(Header))
+    {
+        error().iff(v) << "Failed to read the header of features file " << filename;
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(Header));
+    if(!check_header(header, filename, v))
+        return false;
+
+    if(size < sizeof(Header) + header.scale_count * sizeof(Offsets))
+    {
+        error().iff(v) << "Failed to read the offsets of features file " << filename;
+        return false;
+    }
+    offsets.resize(header.scale_count);
+    std::memcpy(offsets.data(), data + sizeof(Header), header.scale_count * sizeof(Offsets));
+
+    return check_offsets(header, offsets, size, filename, v);
+}
+
+} // namespace pdpc
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace pdpc {
+
+//!
+//! \brief The MultiScaleFeaturesFormat class describes the binary features file
+//!
+//! The file starts with a Header, followed by a table giving for each scale j
+//! the byte offsets of its normals and of its curvatures. The normals of all
+//! the scales are stored first (scale-major), then the curvatures, both
+//! blocks being aligned to a page so that they can be mapped and read in place.
+//!
+//! The quantized dtypes store octahedral normals on 16 or 32 bits (see
+//! quantization.h) and the curvatures as two half floats.
+//!
+//! Files without the magic are the raw dumps of the previous versions:
+//! point count, scale count, normals and curvatures.
+//!
+class MultiScaleFeaturesFormat
+{
+    // Types -------------------------------------------------------------------
+public:
+    enum DType : uint32_t
+    {
+        DTypeFloat32    = 0,
+        DTypeFloat64    = 1,
+        DTypeOct16Half  = 2,
+        DTypeOct32Half  = 3
+    };
+
+    struct Header
+    {
+        char     magic[8];    //!< "PDPCMSF" followed by a null char
+        uint32_t version;
+        uint32_t endianness;  //!< Endianness as written by the host
+        uint32_t dtype;       //!< DType of the normals and curvatures
+        uint32_t header_size; //!< sizeof(Header)
+        uint64_t point_count;
+        uint64_t scale_count;
+    };
+
+    struct Offsets
+    {
+        uint64_t normals;
+        uint64_t curvatures;
+    };
+
+    static constexpr uint32_t Version    = 1;
+    static constexpr uint32_t Endianness = 0x01020304;
+    static constexpr uint64_t Alignment  = 4096;
+
+    // Layout ------------------------------------------------------------------
+public:
+    static DType scalar_dtype();
+    static bool is_quantized(uint32_t dtype);
+
+    //! \brief normal_size returns the bytes count of a normal
+    static uint64_t normal_size(uint32_t dtype);
+    static uint64_t curvatures_size(uint32_t dtype);
+
+    static Header make_header(int point_count, int scale_count, DType dtype = scalar_dtype());
+
+    //! \brief offsets returns the offsets of the scale j written by write_header
+    static Offsets offsets(int point_count, int scale_count, int j, DType dtype = scalar_dtype());
+
+    //! \brief file_size returns the size of a file written by write_header and all the scales
+    static uint64_t file_size(int point_count, int scale_count, DType dtype = scalar_dtype());
+
+    // IO ----------------------------------------------------------------------
+public:
+    static bool has_magic(const char* data, std::size_t size);
+
+    //! \brief write_header writes the header and the offset table
+    static bool write_header(std::ostream& os, int point_count, int scale_count, DType dtype = scalar_dtype());
+
+    //!
+    //! \brief check_header checks that the file can be read by this build:
+    //! version, endianness and dtype
+    //!
+    static bool check_header(const Header& header, const std::string& filename, bool verbose);
+
+    //! \brief check_offsets checks that all the scales lie in a file of the given size
+    static bool check_offsets(const Header& header, const std::vector<Offsets>& offsets,
+                              uint64_t file_size, const std::string& filename, bool verbose);
+
+    //! \brief read_header reads and checks the header and the offset table
+    static bool read_header(std::istream& is, Header& header, std::vector<Offsets>& offsets,
+                            const std::string& filename, bool verbose);
+
+    //! \brief read_header reads and checks the header and the offset table of a mapped file
+    static bool read_header(const char* data, std::size_t size, Header& header, std::vector<Offsets>& offsets,
+                            const std::string& filename, bool verbose);
+};
+
+} // namespace pdpc
@@ -0,0 +1,119 @@
+#include <PDPC/MultiScaleFeatures/MultiScaleFeaturesReader.h>
+#include <PDPC/MultiScaleFeatures/MultiScaleFeatures.h>
+#include <PDPC/MultiScaleFeatures/MultiScaleFeaturesFormat.h>
+#include <PDPC/Common/Log.h>
+
+namespace pdpc {
+
+MultiScaleFeaturesReader::MultiScaleFeaturesReader() :
+    m_filename(),
+    m_ifs(),
+    m_offsets(),
+    m_point_count(0),
+    m_scale_count(0),
+    m_verbose(true)
+{
+}
+
+MultiScaleFeaturesReader::~MultiScaleFeaturesReader()
+{
+}
+
+bool MultiScaleFeaturesReader::open(const std::string& filename, bool v)
+{
+    this->close();
+
+    m_ifs.open(filename, std::ios::in | std::ios::binary);
+    if(!m_ifs.is_open())
+    {
+        error().iff(v) << "Failed to open input features file " << filename;
+        return false;
+    }
+
+    m_filename = filename;
+    m_verbose  = v;
+
+    MultiScaleFeaturesFormat::Header header;
+    if(!MultiScaleFeaturesFormat::read_header(m_ifs, header, m_offsets, filename, v))
+    {
+        this->close();
+        return false;
+    }
+    if(header.dtype != MultiScaleFeaturesFormat::scalar_dtype())
+    {
+        error().iff(v) << "Quantized features file " << filename << " can only be loaded or mapped as a whole";
+        this->close();
+        return false;
+    }
+    m_point_count = header.point_count;
+    m_scale_count = header.scale_count;
+    return true;
+}
+
+void MultiScaleFeaturesReader::close()
+{
+    if(m_ifs.is_open())
+        m_ifs.close();
+    m_ifs.clear();
+    m_offsets.clear();
+    m_point_count = 0;
+    m_scale_count = 0;
+}
+
+bool MultiScaleFeaturesReader::read(int scale_begin, int scale_end, MultiScaleFeatures& features)
+{
+    PDPC_DEBUG_ASSERT(this->is_open());
+
+    if(scale_begin < 0 || scale_end > m_scale_count || scale_begin > scale_end)
+    {
+        error().iff(m_verbose) << "Invalid scale range [" << scale_begin << "," << scale_end << ")"
+                               << " of features file " << m_filename << " (" << m_scale_count << " scales)";
+        return false;
+    }
+
+    const int range_count = scale_end - scale_begin;
+    features.resize(m_point_count, range_count);
+
+    for(int j=scale_begin; j<scale_end; ++j)
+    {
+        const std::size_t index = features.index(0, j - scale_begin);
+        m_ifs.seekg(m_offsets[j].normals);
+        m_ifs.read(reinterpret_cast<char*>(features.normals_data() + index), sizeof(Vector3) * m_point_count);
+        m_ifs.seekg(m_offsets[j].curvatures);
+        m_ifs.read(reinterpret_cast<char*>(features.curvatures_data() + index), sizeof(Vector2) * m_point_count);
+    }
+
+    if(!m_ifs.good())
+    {
+        error().iff(m_verbose) << "Failed to read scales [" << scale_begin << "," << scale_end << ")"
+                               << " of features file " << m_filename;
+        m_ifs.clear();
+        return false;
+    }
+
+    info().iff(m_verbose) << m_point_count << "x" << range_count
+                          << " features loaded from " << m_filename;
+    return true;
+}
+
+bool MultiScaleFeaturesReader::read(int j, MultiScaleFeatures& features)
+{
+    return this->read(j, j+1, features);
+}
+
+bool MultiScaleFeaturesReader::is_open() const
+{
+    return m_ifs.is_open();
+}
+
+int MultiScaleFeaturesReader::point_count() const
+{
+    return m_point_count;
+}
+
+int MultiScaleFeaturesReader::scale_count() const
+{
+    return m_scale_count;
+}
+
+} // namespace pdpc
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+#include <PDPC/MultiScaleFeatures/MultiScaleFeaturesFormat.h>
+
+#include <fstream>
+
+namespace pdpc {
+
+class MultiScaleFeatures;
+
+//!
+//! \brief The MultiScaleFeaturesReader class loads a single scale or a range
+//! of scales of a binary features file (see MultiScaleFeaturesFormat and
+//! MultiScaleFeaturesWriter)
+//!
+class MultiScaleFeaturesReader
+{
+public:
+    MultiScaleFeaturesReader();
+    ~MultiScaleFeaturesReader();
+
+public:
+    bool open(const std::string& filename, bool verbose = true);
+    void close();
+
+    //!
+    //! \brief read loads the scales [scale_begin, scale_end) of the file
+    //!
+    //! The scale j of the file is the scale j - scale_begin of features.
+    //!
+    bool read(int scale_begin, int scale_end, MultiScaleFeatures& features);
+
+    //! \brief read loads the scale j of the file
+    bool read(int j, MultiScaleFeatures& features);
+
+public:
+    bool is_open() const;
+    int  point_count() const;
+    int  scale_count() const;
+
+protected:
+    std::string   m_filename;
+    std::ifstream m_ifs;
+    std::vector<MultiScaleFeaturesFormat::Offsets> m_offsets;
+    int           m_point_count;
+    int           m_scale_count;
+    bool          m_verbose;
+};
+
+} // namespace pdpc
@@ -0,0 +1,234 @@
+#include <PDPC/MultiScaleFeatures/MultiScaleFeaturesTiling.h>
+#include <PDPC/MultiScaleFeatures/MultiScaleFeatures.h>
+#include <PDPC/MultiScaleFeatures/MultiScaleFeaturesEngine.h>
+#include <PDPC/MultiScaleFeatures/MultiScaleFeaturesReader.h>
+#include <PDPC/MultiScaleFeatures/MultiScaleFeaturesWriter.h>
+#include <PDPC/ScaleSpace/ScaleSampling.h>
+#include <PDPC/PointCloud/PointCloud.h>
+#include <PDPC/Common/Log.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <numeric>
+
+namespace pdpc {
+
+MultiScaleFeaturesTiling::MultiScaleFeaturesTiling() :
+    m_tile_size(1000000),
+    m_halo(0),
+    m_verbose(false),
+    m_tiles(),
+    m_order()
+{
+}
+
+bool MultiScaleFeaturesTiling::compute(const PointCloud& points, const ScaleSampling& scales,
+                                       MultiScaleFeaturesEngine& engine, const std::string& filename)
+{
+    this->split(points);
+
+    info().iff(m_verbose) << "Computing " << m_tiles.size() << " tiles of at most " << m_tile_size
+                          << " points (halo = " << m_halo << ")";
+
+    bool ok = true;
+    for(int t=0; ok && t<this->tile_count(); ++t)
+        ok = this->compute_tile(points, scales, engine, t, filename);
+
+    if(ok)
+        return this->merge(points.size(), scales.size(), filename);
+
+    for(int t=0; t<this->tile_count(); ++t)
+        std::remove(tile_filename(filename, t).c_str());
+    return false;
+}
+
+void MultiScaleFeaturesTiling::split(const PointCloud& points)
+{
+    const int point_count = points.size();
+
+    m_tiles.clear();
+
+    std::vector<std::vector<int>> stack(1, std::vector<int>(point_count));
+    std::iota(stack.back().begin(), stack.back().end(), 0);
+
+    while(!stack.empty())
+    {
+        std::vector<int> indices = std::move(stack.back());
+        stack.pop_back();
+
+        Aabb aabb;
+        for(int i : indices) aabb.extend(points[i]);
+
+        if(int(indices.size()) <= m_tile_size)
+        {
+            m_tiles.push_back(Tile{aabb, std::move(indices)});
+            continue;
+        }
+
+        // median split of the longest axis
+        int axis;
+        aabb.sizes().maxCoeff(&axis);
+        const auto middle = indices.begin() + indices.size() / 2;
+        std::nth_element(indices.begin(), middle, indices.end(), [&points,axis](int i1, int i2)
+        {
+            return points[i1][axis] < points[i2][axis];
+        });
+
+        // the first half is split first
+        stack.emplace_back(middle, indices.end());
+        stack.emplace_back(indices.begin(), middle);
+    }
+}
+
+bool MultiScaleFeaturesTiling::compute_tile(const PointCloud& points, const ScaleSampling& scales,
+                                            MultiScaleFeaturesEngine& engine, int t, const std::string& filename) const
+{
+    const Tile& tile = m_tiles[t];
+    const std::string tile_filename = MultiScaleFeaturesTiling::tile_filename(filename, t);
+
+    // the halo is searched in the tiles close enough
+    const Aabb halo_aabb(tile.aabb.min() - Vector3::Constant(m_halo),
+                         tile.aabb.max() + Vector3::Constant(m_halo));
+    std::vector<int> indices = tile.indices;
+    for(int u=0; u<this->tile_count(); ++u)
+    {
+        if(u == t || !halo_aabb.intersects(m_tiles[u].aabb)) continue;
+        for(int i : m_tiles[u].indices)
+        {
+            if(tile.aabb.exteriorDistance(points[i]) <= m_halo)
+                indices.push_back(i);
+        }
+    }
+
+    // a halo larger than the tile (up to the whole cloud with the default max
+    // scale) bounds little of the memory and multiplies the computation
+    const int halo_count = indices.size() - tile.indices.size();
+    if(halo_count > int(tile.indices.size()))
+    {
+        warning().iff(m_verbose) << "The halo of tile " << t+1 << "/" << this->tile_count() << " (" << m_halo << ") "
+                                 << (int(indices.size()) == points.size() ? "covers the whole cloud" : "is larger than the tile")
+                                 << ", a smaller max scale is needed";
+    }
+
+    PointCloud tile_points;
+    tile_points.sample(points, indices);
+    tile_points.build_kdtree();
+
+    info().iff(m_verbose) << "Tile " << t+1 << "/" << this->tile_count() << ": "
+                          << tile.indices.size() << " points + " << halo_count << " halo points";
+
+    // the halo points are written too but ignored by the merge
+    MultiScaleFeaturesWriter writer;
+    bool ok = writer.open(tile_filename, tile_points.size(), scales.size(), false);
+    if(!ok)
+    {
+        error().iff(m_verbose) << "Failed to open tile features file " << tile_filename;
+        return false;
+    }
+    ok = engine.compute(tile_points, scales, writer);
+    return writer.close() && ok;
+}
+
+bool MultiScaleFeaturesTiling::merge(int point_count, int scale_count, const std::string& filename) const
+{
+    std::vector<std::string> tile_filenames(this->tile_count());
+    for(int t=0; t<this->tile_count(); ++t)
+        tile_filenames[t] = tile_filename(filename, t);
+
+    std::vector<std::unique_ptr<MultiScaleFeaturesReader>> readers(this->tile_count());
+    for(int t=0; t<this->tile_count(); ++t)
+    {
+        readers[t].reset(new MultiScaleFeaturesReader());
+        if(!readers[t]->open(tile_filenames[t], false))
+        {
+            error().iff(m_verbose) << "Failed to open tile features file " << tile_filenames[t];
+            return false;
+        }
+        if(readers[t]->scale_count() != scale_count || readers[t]->point_count() < int(m_tiles[t].indices.size()))
+        {
+            error().iff(m_verbose) << "Tile features file " << tile_filenames[t] << " does not match tile " << t;
+            return false;
+        }
+    }
+
+    MultiScaleFeaturesWriter writer;
+    if(!writer.open(filename, point_count, scale_count, m_verbose))
+        return false;
+    writer.set_order(m_order);
+
+    // only one scale of all the points and one of a tile are kept in memory
+    MultiScaleFeatures slab(point_count, 1);
+    MultiScaleFeatures tile_slab;
+    for(int j=0; j<scale_count; ++j)
+    {
+        for(int t=0; t<this->tile_count(); ++t)
+        {
+            // the tile points come before the halo
+            const std::vector<int>& indices = m_tiles[t].indices;
+            if(!readers[t]->read(j, tile_slab))
+            {
+                error().iff(m_verbose) << "Failed to read scale " << j << " of tile features file " << tile_filenames[t];
+                return false;
+            }
+
+            for(int n=0; n<int(indices.size()); ++n)
+            {
+                slab.normal(indices[n],0)     = tile_slab.normal(n,0);
+                slab.curvatures(indices[n],0) = tile_slab.curvatures(n,0);
+            }
+        }
+        if(!writer.write(j, slab, 0))
+            return false;
+    }
+    if(!writer.close())
+        return false;
+
+    for(int t=0; t<this->tile_count(); ++t)
+    {
+        readers[t]->close();
+        std::remove(tile_filenames[t].c_str());
+    }
+    return true;
+}
+
+std::string MultiScaleFeaturesTiling::tile_filename(const std::string& filename, int t)
+{
+    return filename + ".tile" + std::to_string(t);
+}
+
+// Parameters ------------------------------------------------------------------
+
+void MultiScaleFeaturesTiling::set_tile_size(int tile_size)
+{
+    m_tile_size = std::max(1, tile_size);
+}
+
+void MultiScaleFeaturesTiling::set_halo(Scalar halo)
+{
+    m_halo = halo;
+}
+
+void MultiScaleFeaturesTiling::set_verbose(bool verbose)
+{
+    m_verbose = verbose;
+}
+
+void MultiScaleFeaturesTiling::set_order(const std::vector<int>& order)
+{
+    m_order = order;
+}
+
+// Accessors -------------------------------------------------------------------
+
+int MultiScaleFeaturesTiling::tile_count() const
+{
+    return m_tiles.size();
+}
+
+const MultiScaleFeaturesTiling::Tile& MultiScaleFeaturesTiling::tile(int t) const
+{
+    return m_tiles[t];
+}
+
+} // namespace pdpc
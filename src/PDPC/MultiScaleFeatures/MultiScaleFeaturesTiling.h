@@ -0,0 +1,90 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+
+#include <vector>
+
+namespace pdpc {
+
+class PointCloud;
+class ScaleSampling;
+class MultiScaleFeaturesEngine;
+
+//!
+//! \brief The MultiScaleFeaturesTiling class computes the features of a point
+//! cloud tile by tile, so that the features and the kd-trees of only one tile
+//! are kept in memory
+//!
+//! The points are split into spatial tiles of at most tile_size points (median
+//! splits of the longest axis). A tile is computed by the engine with its
+//! points and the halo of the points closer than halo to its bounding box, and
+//! the features of the tile points are streamed to a tile file. The tile files
+//! are then merged into one features file, one scale at a time.
+//!
+//! The halo is the max scale, so the tiling only bounds the memory when the
+//! max scale is small compared to the cloud: a halo larger than its tile is
+//! reported.
+//!
+//! The tiles only depend on the points and the tile size, so that the tiles
+//! can also be computed by several processes (see compute_tile) before one of
+//! them merges the tile files (see merge).
+//!
+//! The coarse scales of a tile use the multi-resolution of the tile and its
+//! halo (see MultiScaleFeaturesEngine), so the features slightly differ from
+//! the ones of an untiled computation.
+//!
+class MultiScaleFeaturesTiling
+{
+    // Types -------------------------------------------------------------------
+public:
+    struct Tile
+    {
+        Aabb             aabb;
+        std::vector<int> indices; //!< indices of the tile points in the point cloud
+    };
+
+    // MultiScaleFeaturesTiling ------------------------------------------------
+public:
+    MultiScaleFeaturesTiling();
+
+    //! \brief compute writes the features of all the points to the binary file filename
+    bool compute(const PointCloud& points, const ScaleSampling& scales,
+                 MultiScaleFeaturesEngine& engine, const std::string& filename);
+
+    //! \brief split splits the points into tiles (must be called before compute_tile and merge)
+    void split(const PointCloud& points);
+
+    //! \brief compute_tile writes the features of the tile t and its halo to tile_filename(filename, t)
+    bool compute_tile(const PointCloud& points, const ScaleSampling& scales,
+                      MultiScaleFeaturesEngine& engine, int t, const std::string& filename) const;
+
+    //! \brief merge writes the features of all the tile files to filename and removes them
+    bool merge(int point_count, int scale_count, const std::string& filename) const;
+
+    static std::string tile_filename(const std::string& filename, int t);
+
+    // Parameters --------------------------------------------------------------
+public:
+    void set_tile_size(int tile_size);
+    void set_halo(Scalar halo);
+    void set_verbose(bool verbose);
+
+    //! \brief set_order writes the features of the point i at the index order[i] (see MultiScaleFeaturesWriter::set_order)
+    void set_order(const std::vector<int>& order);
+
+    // Accessors ---------------------------------------------------------------
+public:
+    int tile_count() const;
+    const Tile& tile(int t) const;
+
+    // Data --------------------------------------------------------------------
+protected:
+    int    m_tile_size;
+    Scalar m_halo;
+    bool   m_verbose;
+
+    std::vector<Tile> m_tiles;
+    std::vector<int>  m_order;
+};
+
+} // namespace pdpc
@@ -0,0 +1,189 @@
+#include <PDPC/MultiScaleFeatures/MultiScaleFeaturesWriter.h>
+#include <PDPC/MultiScaleFeatures/MultiScaleFeatures.h>
+#include <PDPC/MultiScaleFeatures/MultiScaleFeaturesFormat.h>
+#include <PDPC/Common/Log.h>
+
+namespace pdpc {
+
+MultiScaleFeaturesWriter::MultiScaleFeaturesWriter() :
+    m_filename(),
+    m_ofs(),
+    m_point_count(0),
+    m_scale_count(0),
+    m_written_count(0),
+    m_verbose(true),
+    m_order(),
+    m_normals(),
+    m_curvatures()
+{
+}
+
+MultiScaleFeaturesWriter::~MultiScaleFeaturesWriter()
+{
+    if(this->is_open())
+        this->close();
+}
+
+bool MultiScaleFeaturesWriter::open(const std::string& filename, int point_count, int scale_count, bool v)
+{
+    if(this->is_open())
+        this->close();
+
+    m_ofs.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!m_ofs.is_open())
+    {
+        error().iff(v) << "Failed to open output features file " << filename;
+        return false;
+    }
+
+    m_filename      = filename;
+    m_point_count   = point_count;
+    m_scale_count   = scale_count;
+    m_written_count = 0;
+    m_verbose       = v;
+
+    if(!MultiScaleFeaturesFormat::write_header(m_ofs, m_point_count, m_scale_count))
+        return false;
+
+    // the file has its final size from the start so that a partially written
+    // file can be reopened (see reopen)
+    const uint64_t size = MultiScaleFeaturesFormat::file_size(m_point_count, m_scale_count);
+    m_ofs.seekp(size - 1);
+    m_ofs.put(0);
+    return m_ofs.good();
+}
+
+bool MultiScaleFeaturesWriter::reopen(const std::string& filename, int point_count, int scale_count, bool v)
+{
+    if(this->is_open())
+        this->close();
+
+    m_ofs.open(filename, std::ios::in | std::ios::out | std::ios::binary);
+    if(!m_ofs.is_open())
+    {
+        error().iff(v) << "Failed to reopen output features file " << filename;
+        return false;
+    }
+
+    MultiScaleFeaturesFormat::Header header;
+    std::vector<MultiScaleFeaturesFormat::Offsets> offsets;
+    if(!MultiScaleFeaturesFormat::read_header(m_ofs, header, offsets, filename, v))
+    {
+        m_ofs.close();
+        return false;
+    }
+    if(int(header.point_count) != point_count || int(header.scale_count) != scale_count ||
+       header.dtype != MultiScaleFeaturesFormat::scalar_dtype())
+    {
+        error().iff(v) << "Features file " << filename << " has " << header.point_count << "x" << header.scale_count
+                       << " features instead of " << point_count << "x" << scale_count;
+        m_ofs.close();
+        return false;
+    }
+
+    m_filename      = filename;
+    m_point_count   = point_count;
+    m_scale_count   = scale_count;
+    m_written_count = 0;
+    m_verbose       = v;
+    return true;
+}
+
+bool MultiScaleFeaturesWriter::write(int j, const MultiScaleFeatures& features, int column)
+{
+    PDPC_DEBUG_ASSERT(this->is_open());
+    PDPC_DEBUG_ASSERT(0 <= j && j < m_scale_count);
+    PDPC_DEBUG_ASSERT(features.m_point_count == m_point_count);
+    PDPC_DEBUG_ASSERT(features.storage() == MultiScaleFeatures::StorageFloat);
+
+    const auto        offsets = MultiScaleFeaturesFormat::offsets(m_point_count, m_scale_count, j);
+    const std::size_t index   = features.index(0, column);
+
+    const Vector3* normals    = features.normals_data() + index;
+    const Vector2* curvatures = features.curvatures_data() + index;
+    if(!m_order.empty())
+    {
+        m_normals.resize(m_point_count);
+        m_curvatures.resize(m_point_count);
+
+        #pragma omp parallel for
+        for(int i=0; i<m_point_count; ++i)
+        {
+            m_normals[m_order[i]]    = normals[i];
+            m_curvatures[m_order[i]] = curvatures[i];
+        }
+        normals    = m_normals.data();
+        curvatures = m_curvatures.data();
+    }
+
+    m_ofs.seekp(offsets.normals);
+    m_ofs.write(reinterpret_cast<const char*>(normals), sizeof(Vector3) * m_point_count);
+    m_ofs.seekp(offsets.curvatures);
+    m_ofs.write(reinterpret_cast<const char*>(curvatures), sizeof(Vector2) * m_point_count);
+
+    if(!m_ofs.good())
+    {
+        error().iff(m_verbose) << "Failed to write scale " << j << " to features file " << m_filename;
+        return false;
+    }
+    ++m_written_count;
+    return true;
+}
+
+void MultiScaleFeaturesWriter::skip(int j)
+{
+    PDPC_DEBUG_ASSERT(this->is_open());
+    PDPC_DEBUG_ASSERT(0 <= j && j < m_scale_count);
+    PDPC_UNUSED(j);
+    ++m_written_count;
+}
+
+bool MultiScaleFeaturesWriter::flush()
+{
+    m_ofs.flush();
+    return m_ofs.good();
+}
+
+void MultiScaleFeaturesWriter::set_order(const std::vector<int>& order)
+{
+    m_order = order;
+}
+
+bool MultiScaleFeaturesWriter::close()
+{
+    if(!this->is_open())
+        return false;
+
+    if(m_written_count != m_scale_count)
+    {
+        warning().iff(m_verbose) << m_written_count << "/" << m_scale_count
+                                 << " scales written to " << m_filename;
+    }
+
+    m_ofs.close();
+    const bool ok = !m_ofs.fail();
+
+    std::vector<Vector3>().swap(m_normals);
+    std::vector<Vector2>().swap(m_curvatures);
+
+    info().iff(m_verbose && ok) << m_point_count << "x" << m_scale_count
+                                << " features saved to " << m_filename;
+    return ok;
+}
+
+bool MultiScaleFeaturesWriter::is_open() const
+{
+    return m_ofs.is_open();
+}
+
+int MultiScaleFeaturesWriter::point_count() const
+{
+    return m_point_count;
+}
+
+int MultiScaleFeaturesWriter::scale_count() const
+{
+    return m_scale_count;
+}
+
+} // namespace pdpc
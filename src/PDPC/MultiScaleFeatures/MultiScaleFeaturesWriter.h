@@ -0,0 +1,68 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+
+#include <fstream>
+#include <vector>
+
+namespace pdpc {
+
+class MultiScaleFeatures;
+
+//!
+//! \brief The MultiScaleFeaturesWriter class writes the features of a binary
+//! file (see MultiScaleFeaturesFormat) one scale at a time
+//!
+//! The file is scale-major so each scale is written at a known offset, in any
+//! order, and only the features of the current scale need to be kept in
+//! memory. The file can be read with MultiScaleFeatures::load or with
+//! MultiScaleFeaturesReader.
+//!
+class MultiScaleFeaturesWriter
+{
+public:
+    MultiScaleFeaturesWriter();
+    ~MultiScaleFeaturesWriter();
+
+public:
+    bool open(const std::string& filename, int point_count, int scale_count, bool verbose = true);
+
+    //! \brief reopen opens a file written by a previous writer to complete it
+    bool reopen(const std::string& filename, int point_count, int scale_count, bool verbose = true);
+
+    //! \brief write writes the scale column of the given features as the scale j of the file
+    bool write(int j, const MultiScaleFeatures& features, int column = 0);
+
+    //! \brief skip counts the scale j of a reopened file as written
+    void skip(int j);
+
+    //! \brief flush makes sure the written scales are in the file
+    bool flush();
+
+    //!
+    //! \brief set_order writes the features of the point i at the index
+    //! order[i] of the file, e.g. to undo PointCloud::reorder(order)
+    //!
+    void set_order(const std::vector<int>& order);
+
+    bool close();
+
+public:
+    bool is_open() const;
+    int  point_count() const;
+    int  scale_count() const;
+
+protected:
+    std::string   m_filename;
+    std::fstream  m_ofs;
+    int           m_point_count;
+    int           m_scale_count;
+    int           m_written_count;
+    bool          m_verbose;
+
+    std::vector<int>     m_order;     //!< file index of each point, empty for the identity
+    std::vector<Vector3> m_normals;   //!< reordered normals of the written scale
+    std::vector<Vector2> m_curvatures;
+};
+
+} // namespace pdpc
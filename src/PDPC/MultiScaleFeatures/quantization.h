@@ -0,0 +1,215 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace pdpc {
+
+//!
+//! \brief float_to_half converts to IEEE half-precision, rounding to nearest even
+//!
+inline uint16_t float_to_half(float x);
+inline float half_to_float(uint16_t h);
+
+//!
+//! \brief oct_encode16 encodes a unit vector with the octahedral mapping on
+//! two signed 8-bit components
+//!
+//! The null vector (e.g. of unstable points) is encoded by a code that no unit
+//! vector uses, and decoded as a null vector.
+//!
+inline uint16_t oct_encode16(const Vector3& n);
+inline Vector3  oct_decode16(uint16_t code);
+
+//! \brief oct_encode32 is oct_encode16 with two signed 16-bit components
+inline uint32_t oct_encode32(const Vector3& n);
+inline Vector3  oct_decode32(uint32_t code);
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+uint16_t float_to_half(float x)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(float));
+
+    const uint32_t sign = (bits >> 16) & 0x8000;
+    const int      exp  = (bits >> 23) & 0xff;
+    uint32_t       mant = bits & 0x007fffff;
+
+    // inf and nan
+    if(exp == 0xff)
+        return sign | 0x7c00 | (mant ? 0x0200 : 0);
+
+    const int e = exp - 127 + 15;
+    if(e >= 0x1f)
+        return sign | 0x7c00;
+
+    // subnormal half
+    if(e <= 0)
+    {
+        if(e < -10)
+            return sign;
+        mant |= 0x00800000;
+        const int      shift = 14 - e;
+        const uint32_t rem   = mant & ((1u << shift) - 1);
+        const uint32_t mid   = 1u << (shift - 1);
+        uint32_t h = mant >> shift;
+        if(rem > mid || (rem == mid && (h & 1))) ++h;
+        return sign | h;
+    }
+
+    // a carry of the rounding correctly increments the exponent
+    const uint32_t rem = mant & 0x1fff;
+    uint32_t h = (uint32_t(e) << 10) | (mant >> 13);
+    if(rem > 0x1000 || (rem == 0x1000 && (h & 1))) ++h;
+    return sign | h;
+}
+
+float half_to_float(uint16_t h)
+{
+    const uint32_t sign = uint32_t(h & 0x8000) << 16;
+    uint32_t       exp  = (h >> 10) & 0x1f;
+    uint32_t       mant = h & 0x03ff;
+
+    uint32_t bits;
+    if(exp == 0)
+    {
+        if(mant == 0)
+        {
+            bits = sign;
+        }
+        else
+        {
+            // normalize the subnormal half
+            exp = 127 - 15 + 1;
+            while(!(mant & 0x0400))
+            {
+                mant <<= 1;
+                --exp;
+            }
+            mant &= 0x03ff;
+            bits = sign | (exp << 23) | (mant << 13);
+        }
+    }
+    else if(exp == 0x1f)
+    {
+        bits = sign | 0x7f800000 | (mant << 13);
+    }
+    else
+    {
+        bits = sign | ((exp + 127 - 15) << 23) | (mant << 13);
+    }
+
+    float x;
+    std::memcpy(&x, &bits, sizeof(float));
+    return x;
+}
+
+namespace internal {
+
+inline Scalar sign_not_zero(Scalar x)
+{
+    return x < 0 ? Scalar(-1) : Scalar(1);
+}
+
+//! \brief oct_encode maps a unit vector to the square [-1,1]^2
+inline Vector2 oct_encode(const Vector3& n)
+{
+    const Scalar l1 = std::abs(n.x()) + std::abs(n.y()) + std::abs(n.z());
+    Vector2 p(n.x() / l1, n.y() / l1);
+    if(n.z() < 0)
+    {
+        p = Vector2((1 - std::abs(p.y())) * sign_not_zero(p.x()),
+                    (1 - std::abs(p.x())) * sign_not_zero(p.y()));
+    }
+    return p;
+}
+
+inline Vector3 oct_decode(const Vector2& p)
+{
+    Vector3 n(p.x(), p.y(), 1 - std::abs(p.x()) - std::abs(p.y()));
+    if(n.z() < 0)
+    {
+        n.head<2>() = Vector2((1 - std::abs(p.y())) * sign_not_zero(p.x()),
+                              (1 - std::abs(p.x())) * sign_not_zero(p.y()));
+    }
+    return n.normalized();
+}
+
+//! \brief snorm quantizes x in [-1,1] on [-M,M], -M-1 being left for the null vector
+template<typename IntT>
+inline IntT snorm(Scalar x)
+{
+    constexpr Scalar M = std::numeric_limits<IntT>::max();
+    return IntT(std::round(std::min(Scalar(1), std::max(Scalar(-1), x)) * M));
+}
+
+template<typename IntT>
+inline Scalar unsnorm(IntT x)
+{
+    constexpr Scalar M = std::numeric_limits<IntT>::max();
+    return Scalar(x) / M;
+}
+
+template<typename IntT, typename CodeT>
+inline CodeT oct_encode(const Vector3& n)
+{
+    using UIntT = typename std::make_unsigned<IntT>::type;
+    constexpr int B = 8 * sizeof(IntT);
+
+    IntT x = std::numeric_limits<IntT>::min();
+    IntT y = std::numeric_limits<IntT>::min();
+    if(!n.isZero())
+    {
+        const Vector2 p = oct_encode(n);
+        x = snorm<IntT>(p.x());
+        y = snorm<IntT>(p.y());
+    }
+    return CodeT(UIntT(x)) | (CodeT(UIntT(y)) << B);
+}
+
+template<typename IntT, typename CodeT>
+inline Vector3 oct_decode(CodeT code)
+{
+    using UIntT = typename std::make_unsigned<IntT>::type;
+    constexpr int B = 8 * sizeof(IntT);
+
+    const IntT x = IntT(UIntT(code));
+    const IntT y = IntT(UIntT(code >> B));
+    if(x == std::numeric_limits<IntT>::min())
+        return Vector3::Zero();
+
+    return oct_decode(Vector2(unsnorm(x), unsnorm(y)));
+}
+
+} // namespace internal
+
+uint16_t oct_encode16(const Vector3& n)
+{
+    return internal::oct_encode<int8_t,uint16_t>(n);
+}
+
+Vector3 oct_decode16(uint16_t code)
+{
+    return internal::oct_decode<int8_t,uint16_t>(code);
+}
+
+uint32_t oct_encode32(const Vector3& n)
+{
+    return internal::oct_encode<int16_t,uint32_t>(n);
+}
+
+Vector3 oct_decode32(uint32_t code)
+{
+    return internal::oct_decode<int16_t,uint32_t>(code);
+}
+
+} // namespace pdpc
@@ -1,6 +1,7 @@
 #include <PDPC/Persistence/ComponentDataSet.h>
 #include <PDPC/Persistence/ComponentSet.h>
 #include <PDPC/Segmentation/RegionSet.h>
+#include <PDPC/Common/TextFile.h>
 
 #include <fstream>
 
@@ -46,28 +47,36 @@ bool ComponentDataSet::save(const std::string& filename) const
 
 bool ComponentDataSet::load(const std::string& filename)
 {
-    std::ifstream ifs(filename);
-    if(!ifs.is_open())
+    TextFile file;
+    if(!file.open(filename, false))
     {
         warning() << "Failed to open input file " << filename;
         return false;
     }
 
-    std::string line;
-    while(std::getline(ifs, line))
-    {
-        m_data.push_back(ComponentData());
-        auto& comp = m_data.back();
+    // one component per line
+    const int offset = m_data.size();
+    m_data.resize(offset + file.line_count());
 
-        std::stringstream str(line);
+    const bool ok = file.for_each_line([this,offset](int l, const char* p, const char* end) -> bool
+    {
+        auto& comp = m_data[offset + l];
 
-        str >> comp.m_birth;
-        str >> comp.m_death;
+        p = TextFile::parse(p, end, comp.m_birth);
+        if(p) p = TextFile::parse(p, end, comp.m_death);
+        if(!p) return false;
 
         int i;
-        while(str >> i) comp.indices().push_back(i);
-    }
+        while((p = TextFile::parse(p, end, i)))
+            comp.indices().push_back(i);
+        return true;
+    });
 
+    if(!ok)
+    {
+        warning() << "Failed to read file " << filename;
+        return false;
+    }
     return true;
 }
 
@@ -2,6 +2,7 @@
 
 #include <PDPC/SpacePartitioning/KdTree.h>
 #include <PDPC/SpacePartitioning/KnnGraph.h>
+#include <PDPC/SpacePartitioning/Octree.h>
 
 #include <PDPC/Common/std_vector_algo.h>
 
@@ -844,6 +845,28 @@ void PointCloud::compute_normals_from_faces()
     }
 }
 
+void PointCloud::reorder(const std::vector<int>& order)
+{
+    PDPC_DEBUG_ASSERT(int(order.size()) == size());
+
+    permute(points_data(), order);
+    if(has_normals()) permute(normals_data(), order);
+    if(has_colors())  permute(colors_data(),  order);
+    if(has_uv())      permute(uv_data(),      order);
+
+    if(face_count() > 0)
+    {
+        const std::vector<int> inverse = inverse_permutation(order);
+        for(auto& f : faces_data())
+        {
+            f = Vector3i(inverse[f[0]], inverse[f[1]], inverse[f[2]]);
+        }
+    }
+
+    clear_kdtree();
+    clear_knn_graph();
+}
+
 // Data Accessors --------------------------------------------------------------
 
 Vector3Array& PointCloud::points_data()
@@ -1055,4 +1078,20 @@ void PointCloud::build_knn_graph(int k, bool keep_kdtree)
     if(!keep_kdtree) clear_kdtree();
 }
 
+std::vector<int> PointCloud::spatial_order()
+{
+    if(!has_kdtree()) build_kdtree();
+
+    // the leaves are contiguous ranges of the kd-tree indices
+    const auto& indices = m_kdtree->index_data();
+    return std::vector<int>(indices.begin(), indices.end());
+}
+
+std::vector<int> PointCloud::morton_order()
+{
+    const Octree octree(m_points);
+    const auto& indices = octree.index_data();
+    return std::vector<int>(indices.begin(), indices.end());
+}
+
 } // namespace pdpc
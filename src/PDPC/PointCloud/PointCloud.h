@@ -154,6 +154,12 @@ public:
     void normalize_normals();
     void compute_normals_from_faces();
 
+    //!
+    //! \brief reorder moves the point order[i] (and its attributes) to the
+    //! index i, the faces are updated and the kd-tree and knn graph are cleared
+    //!
+    void reorder(const std::vector<int>& order);
+
     // Data Accessors ----------------------------------------------------------
 public:
     Vector3Array&  points_data();
@@ -209,6 +215,20 @@ public:
     void build_kdtree();
     void build_knn_graph(int k, bool keep_kdtree = false);
 
+    //!
+    //! \brief spatial_order returns the indices in the order of the leaves of
+    //! the kd-tree (built if needed), so that reorder(spatial_order()) stores
+    //! the points of a leaf contiguously
+    //!
+    std::vector<int> spatial_order();
+
+    //!
+    //! \brief morton_order returns the indices sorted by the Morton codes of
+    //! the points (see Octree), so that reorder(morton_order()) stores the
+    //! points of any octree cell contiguously
+    //!
+    std::vector<int> morton_order();
+
     // Data --------------------------------------------------------------------
 protected:
     std::shared_ptr<Vector3Array>  m_points;
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <PDPC/RIMLS/RIMLSKernel.h>
+
+namespace pdpc {
+
+//!
+//! \brief The OrientedSphereSums class is a Ponca fitting extension of
+//! OrientedSphereFit that adds sums computed outside of addNeighbor, e.g. by
+//! RIMLSKernel, so that finalize() and the primitive are left to Ponca
+//!
+template<class DataPoint, class _WFunctor, typename T>
+class OrientedSphereSums : public T
+{
+protected:
+    using Base = T;
+
+public:
+    inline void addSums(const RIMLSKernel::Sums& sums)
+    {
+        Base::m_sumP     += sums.sum_p;
+        Base::m_sumN     += sums.sum_n;
+        Base::m_sumDotPN += sums.sum_dot_pn;
+        Base::m_sumDotPP += sums.sum_dot_pp;
+        Base::m_sumW     += sums.sum_w;
+        Base::m_nbNeighbors += sums.count;
+    }
+};
+
+} // namespace pdpc
@@ -0,0 +1,144 @@
+#include <PDPC/RIMLS/RIMLSKernel.h>
+#include <PDPC/RIMLS/internal/RIMLSKernelImpl.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace pdpc {
+
+// RIMLSNeighborhood -----------------------------------------------------------
+
+RIMLSNeighborhood::RIMLSNeighborhood() :
+    m_size(0),
+    m_px(),
+    m_py(),
+    m_pz(),
+    m_nx(),
+    m_ny(),
+    m_nz()
+{
+}
+
+void RIMLSNeighborhood::grow()
+{
+    const int capacity = std::max(int(Padding), 2 * int(m_px.size()));
+    m_px.resize(capacity, 0);
+    m_py.resize(capacity, 0);
+    m_pz.resize(capacity, 0);
+    m_nx.resize(capacity, 0);
+    m_ny.resize(capacity, 0);
+    m_nz.resize(capacity, 0);
+}
+
+// RIMLSKernel -----------------------------------------------------------------
+
+void RIMLSKernel::accumulate(const RIMLSNeighborhood& neighborhood,
+                             const Vector3& center,
+                             Scalar t,
+                             const Reweighting& reweighting,
+                             Sums& sums)
+{
+    accumulate(simd_level(), neighborhood, center, t, reweighting, sums);
+}
+
+void RIMLSKernel::accumulate(SimdLevel level,
+                             const RIMLSNeighborhood& neighborhood,
+                             const Vector3& center,
+                             Scalar t,
+                             const Reweighting& reweighting,
+                             Sums& sums)
+{
+    internal::RIMLSKernelArgs args;
+    args.px = neighborhood.px();
+    args.py = neighborhood.py();
+    args.pz = neighborhood.pz();
+    args.nx = neighborhood.nx();
+    args.ny = neighborhood.ny();
+    args.nz = neighborhood.nz();
+    args.size = neighborhood.size();
+    args.cx = center.x();
+    args.cy = center.y();
+    args.cz = center.z();
+    args.t2     = t * t;
+    args.inv_t2 = Scalar(1) / (t * t);
+    args.reweight  = reweighting.enabled;
+    args.uc        = reweighting.uc;
+    args.ulx       = reweighting.ul.x();
+    args.uly       = reweighting.ul.y();
+    args.ulz       = reweighting.ul.z();
+    args.uq        = reweighting.uq;
+    args.potential = reweighting.potential;
+    args.gx        = reweighting.gradient.x();
+    args.gy        = reweighting.gradient.y();
+    args.gz        = reweighting.gradient.z();
+    args.inv_sigma2       = reweighting.inv_sigma2;
+    args.inv_sigma_scale2 = reweighting.inv_sigma_scale2;
+
+    internal::RIMLSKernelResult res;
+    switch(level)
+    {
+#ifdef PDPC_SIMD_X86
+    case SimdLevel::AVX512: internal::rimls_accumulate_avx512(args, res); break;
+    case SimdLevel::AVX2:   internal::rimls_accumulate_avx2(  args, res); break;
+#endif
+    default:                internal::rimls_accumulate_scalar(args, res); break;
+    }
+
+    sums.sum_p      = Vector3(res.sum_px, res.sum_py, res.sum_pz);
+    sums.sum_n      = Vector3(res.sum_nx, res.sum_ny, res.sum_nz);
+    sums.sum_dot_pn = res.sum_dot_pn;
+    sums.sum_dot_pp = res.sum_dot_pp;
+    sums.sum_w      = res.sum_w;
+    sums.count      = res.count;
+}
+
+// Scalar kernel ---------------------------------------------------------------
+
+namespace internal {
+
+void rimls_accumulate_scalar(const RIMLSKernelArgs& a, RIMLSKernelResult& r)
+{
+    r = RIMLSKernelResult{0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+    for(int i=0; i<a.size; ++i)
+    {
+        const Scalar qx = a.px[i] - a.cx;
+        const Scalar qy = a.py[i] - a.cy;
+        const Scalar qz = a.pz[i] - a.cz;
+        const Scalar d2 = qx*qx + qy*qy + qz*qz;
+        if(d2 > a.t2) continue;
+
+        // SmoothWeightKernel (x^2-1)^2 with x = |q|/t
+        const Scalar v = d2 * a.inv_t2 - 1;
+        Scalar w = v * v;
+
+        if(a.reweight)
+        {
+            const Scalar s   = a.uc + qx*a.ulx + qy*a.uly + qz*a.ulz + d2*a.uq;
+            const Scalar dp  = a.potential - s;
+            const Scalar gnx = a.gx - a.nx[i];
+            const Scalar gny = a.gy - a.ny[i];
+            const Scalar gnz = a.gz - a.nz[i];
+            const Scalar dn2 = gnx*gnx + gny*gny + gnz*gnz;
+            w *= std::exp(-dn2 * a.inv_sigma2 - dp * dp * a.inv_sigma_scale2);
+        }
+
+        if(w > 0)
+        {
+            r.sum_px     += w * qx;
+            r.sum_py     += w * qy;
+            r.sum_pz     += w * qz;
+            r.sum_nx     += w * a.nx[i];
+            r.sum_ny     += w * a.ny[i];
+            r.sum_nz     += w * a.nz[i];
+            r.sum_dot_pn += w * (a.nx[i]*qx + a.ny[i]*qy + a.nz[i]*qz);
+            r.sum_dot_pp += w * d2;
+            r.sum_w      += w;
+            ++r.count;
+        }
+    }
+}
+
+} // namespace internal
+
+} // namespace pdpc
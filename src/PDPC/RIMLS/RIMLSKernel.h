@@ -0,0 +1,114 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+#include <PDPC/Common/Cpu.h>
+
+namespace pdpc {
+
+//!
+//! \brief The RIMLSNeighborhood class packs the positions and normals of a
+//! neighborhood into separate arrays (SoA), padded to a multiple of 16 so that
+//! SIMD kernels can load full vectors
+//!
+class RIMLSNeighborhood
+{
+public:
+    enum {Padding = 16};
+
+public:
+    RIMLSNeighborhood();
+
+public:
+    inline void clear();
+    inline void push_back(const Vector3& point, const Vector3& normal);
+
+    inline int size() const;
+    inline bool empty() const;
+
+public:
+    inline const Scalar* px() const;
+    inline const Scalar* py() const;
+    inline const Scalar* pz() const;
+    inline const Scalar* nx() const;
+    inline const Scalar* ny() const;
+    inline const Scalar* nz() const;
+
+protected:
+    void grow();
+
+protected:
+    int m_size;
+    std::vector<Scalar> m_px;
+    std::vector<Scalar> m_py;
+    std::vector<Scalar> m_pz;
+    std::vector<Scalar> m_nx;
+    std::vector<Scalar> m_ny;
+    std::vector<Scalar> m_nz;
+};
+
+//!
+//! \brief The RIMLSKernel class computes the sums of the oriented sphere fit
+//! of a packed neighborhood, including the SmoothWeightKernel weights and the
+//! robust reweighting of RIMLSWeightFunc
+//!
+//! The kernel is vectorized with AVX2 or AVX-512 depending on simd_level(),
+//! with a scalar fallback. Lanes are summed in a different order and the
+//! exponential of the reweighting is a polynomial approximation (relative
+//! error below 2e-7), so compared to Ponca's addNeighbor the sums differ by a
+//! few float ulps. After the projection steps and the final fit, normals
+//! deviate by less than 0.01 degree and normalized curvatures by less than
+//! 1e-3 on typical data, except for the rare points whose convergence test
+//! flips.
+//!
+class RIMLSKernel
+{
+public:
+    struct Sums
+    {
+        Vector3 sum_p      = Vector3::Zero();
+        Vector3 sum_n      = Vector3::Zero();
+        Scalar  sum_dot_pn = 0;
+        Scalar  sum_dot_pp = 0;
+        Scalar  sum_w      = 0;
+        int     count      = 0; // neighbors with a positive weight
+    };
+
+    //!
+    //! \brief The Reweighting struct holds the algebraic sphere of the
+    //! previous iteration, used to compute the residuals of the neighbors
+    //!
+    struct Reweighting
+    {
+        bool    enabled          = false;
+        Scalar  uc               = 0;
+        Vector3 ul               = Vector3::Zero();
+        Scalar  uq               = 0;
+        Scalar  potential        = 0;
+        Vector3 gradient         = Vector3::Zero();
+        Scalar  inv_sigma2       = 1;
+        Scalar  inv_sigma_scale2 = 1;
+    };
+
+public:
+    //!
+    //! \brief accumulate computes the weighted sums of the neighborhood
+    //! centered at the given point for a support size t
+    //!
+    static void accumulate(const RIMLSNeighborhood& neighborhood,
+                           const Vector3& center,
+                           Scalar t,
+                           const Reweighting& reweighting,
+                           Sums& sums);
+
+    //! \brief accumulate uses the given instruction set, which must be supported by the cpu
+    static void accumulate(SimdLevel level,
+                           const RIMLSNeighborhood& neighborhood,
+                           const Vector3& center,
+                           Scalar t,
+                           const Reweighting& reweighting,
+                           Sums& sums);
+};
+
+} // namespace pdpc
+
+#include <PDPC/RIMLS/RIMLSKernel.inl>
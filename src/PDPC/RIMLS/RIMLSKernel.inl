@@ -0,0 +1,39 @@
+#include <PDPC/RIMLS/RIMLSKernel.h>
+
+namespace pdpc {
+
+void RIMLSNeighborhood::clear()
+{
+    m_size = 0;
+}
+
+void RIMLSNeighborhood::push_back(const Vector3& point, const Vector3& normal)
+{
+    if(m_size == int(m_px.size())) this->grow();
+    m_px[m_size] = point.x();
+    m_py[m_size] = point.y();
+    m_pz[m_size] = point.z();
+    m_nx[m_size] = normal.x();
+    m_ny[m_size] = normal.y();
+    m_nz[m_size] = normal.z();
+    ++m_size;
+}
+
+int RIMLSNeighborhood::size() const
+{
+    return m_size;
+}
+
+bool RIMLSNeighborhood::empty() const
+{
+    return m_size == 0;
+}
+
+const Scalar* RIMLSNeighborhood::px() const {return m_px.data();}
+const Scalar* RIMLSNeighborhood::py() const {return m_py.data();}
+const Scalar* RIMLSNeighborhood::pz() const {return m_pz.data();}
+const Scalar* RIMLSNeighborhood::nx() const {return m_nx.data();}
+const Scalar* RIMLSNeighborhood::ny() const {return m_ny.data();}
+const Scalar* RIMLSNeighborhood::nz() const {return m_nz.data();}
+
+} // namespace pdpc
@@ -4,39 +4,55 @@
 
 #include <PDPC/RIMLS/RIMLSWeightFunc.h>
 #include <PDPC/RIMLS/RIMLSPoint.h>
-
-#include <memory>
+#include <PDPC/RIMLS/RIMLSKernel.h>
+#include <PDPC/RIMLS/OrientedSphereSums.h>
+#include <PDPC/RIMLS/RIMLSOutputs.h>
 
 namespace pdpc {
 
-class KdTreeRangePointQuery;
+class KdTree;
+class HashGrid;
 class PointCloud;
 
 // =============================================================================
 
-class RIMLSOperator
+//!
+//! \brief The RIMLSOperatorT class projects a point onto the robust implicit
+//! MLS surface and fits the final sphere with only the derivatives required by
+//! the given outputs (see RIMLSOutputs)
+//!
+template<RIMLSOutputs Outputs>
+class RIMLSOperatorT
 {
     // Types -------------------------------------------------------------------
 public:
     using Point         = RIMLSPoint<Vector3>;
     using WeightKernel  = Ponca::SmoothWeightKernel<Scalar>;
     using WeightFunc    = RIMLSWeightFunc<Point, WeightKernel>;
-    using FitStep       = Ponca::Basket<Point, WeightFunc, Ponca::OrientedSphereFit>;
-    using FitFinal      = Ponca::Basket<Point, WeightFunc, Ponca::OrientedSphereFit,
-                                                           Ponca::OrientedSphereScaleSpaceDer,
-                                                           Ponca::MlsSphereFitDer,
-                                                           Ponca::CurvatureEstimator>;
+    using Traits        = RIMLSFitFinal<Outputs>;
+    using FitStep       = Ponca::Basket<Point, WeightFunc, Ponca::OrientedSphereFit,
+                                                           OrientedSphereSums>;
+    using FitFinal      = typename Traits::template Fit<Point, WeightFunc>;
 
     // MLSOperator -------------------------------------------------------------
 public:
-    RIMLSOperator();
-    RIMLSOperator(const RIMLSOperator& other);
-    ~RIMLSOperator();
+    RIMLSOperatorT();
+    RIMLSOperatorT(const RIMLSOperatorT& other);
+    ~RIMLSOperatorT();
 
     void compute(const PointCloud& points, Vector3& point);
 
+    //! \brief compute uses the given kd-tree built on the points instead of the one of the point cloud
+    void compute(const PointCloud& points, const KdTree& kdtree, Vector3& point);
+
     // Parameters --------------------------------------------------------------
 public:
+    int    step_max() const;
+    Scalar convergence_ratio_min() const;
+    int    reweighting_step() const;
+    Scalar cache_inflation() const;
+    bool   batched() const;
+
     void set_scale(Scalar scale);
     void set_step_max(int step_max);
     void set_convergence_ratio_min(Scalar convergence_ratio_min);
@@ -44,15 +60,68 @@ public:
     void set_reweighting_sigma(Scalar sigma);
     void set_reweighting_step(int step);
 
+    //!
+    //! \brief set_cache_inflation enables the neighbor cache when positive
+    //!
+    //! The neighborhood is gathered once within (1+inflation)*scale and the
+    //! kd-tree is queried again only when the projected point moved farther
+    //! than inflation*scale from the cache center.
+    //!
+    void set_cache_inflation(Scalar inflation);
+
+    //!
+    //! \brief set_batched computes the reweighting steps with RIMLSKernel
+    //! (default) instead of adding the neighbors one by one to Ponca
+    //!
+    //! The neighborhood is then gathered once per projection step.
+    //! The final fit is always computed by Ponca.
+    //!
+    void set_batched(bool batched);
+
+    //! \brief set_level restricts the neighbors to a level of the kd-tree (see KdTree::build_levels)
+    void set_level(int level);
+
+    //!
+    //! \brief set_grid queries the neighbors in grid instead of the kd-tree
+    //! (nullptr to use the kd-tree)
+    //!
+    //! The grid must hold the points of the level, ideally with cells of the
+    //! size of the scale (see HashGrid).
+    //!
+    void set_grid(const HashGrid* grid);
+
+    // Neighbor cache ----------------------------------------------------------
+protected:
+    void update_cache(const PointCloud& points, const Vector3& point);
+
+    template<class FuncT>
+    void for_each_neighbor(const PointCloud& points, const Vector3& point, FuncT&& f);
+
+    //! \brief for_each_in_range visits the neighbors in the grid if any, else in the kd-tree
+    template<class FuncT>
+    void for_each_in_range(const Vector3& point, Scalar r, FuncT&& f);
+
     // Accessors ---------------------------------------------------------------
 public:
     bool  stable() const;
+
+    //! \brief normal is the MLS normal at the projected point
+    inline Vector3 normal() const;
+
+    //! \brief k1 and k2 are the principal curvatures, not available with RIMLSNormal
+    inline Scalar k1() const;
+    inline Scalar k2() const;
+
+    int   step_count() const;
+    int   neighbor_count() const;
+    int   query_count() const;
     const FitFinal& fit() const;
           FitFinal& fit();
 
     // Data --------------------------------------------------------------------
 protected:
     Scalar      m_scale;
+    int         m_level;
 
     Scalar      m_reweighting_sigma; //TODO this is never used...
     int         m_reweighting_step;
@@ -68,7 +137,23 @@ protected:
     FitStep     m_fit_step;
     FitFinal    m_fit_final;
 
-    std::unique_ptr<KdTreeRangePointQuery> m_query;
+    const KdTree*   m_kdtree;
+    const HashGrid* m_grid;
+
+    bool              m_batched;
+    RIMLSNeighborhood m_neighborhood;
+
+    Scalar       m_cache_inflation;
+    bool         m_cache_valid;
+    Vector3      m_cache_center;
+    Vector3Array m_cache_points;
+    Vector3Array m_cache_normals;
+    int          m_query_count;
 };
 
+//! \brief RIMLSOperator computes all the outputs of the final fit
+using RIMLSOperator = RIMLSOperatorT<RIMLSScaleSpace>;
+
 } // namespace pdpc
+
+#include <PDPC/RIMLS/RIMLSOperator.hpp>
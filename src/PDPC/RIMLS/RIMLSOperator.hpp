@@ -0,0 +1,449 @@
+#include <PDPC/RIMLS/RIMLSOperator.h>
+#include <PDPC/PointCloud/PointCloud.h>
+#include <PDPC/SpacePartitioning/KdTree.h>
+#include <PDPC/SpacePartitioning/HashGrid.h>
+
+namespace pdpc {
+
+template<RIMLSOutputs O>
+RIMLSOperatorT<O>::RIMLSOperatorT() :
+    m_scale(1.0),
+    m_level(0),
+    m_reweighting_sigma(1),
+    m_reweighting_step(1),
+    m_step_max(100),
+    m_convergence_ratio_min(0.01),
+    m_step(0),
+    m_stable(false),
+    m_neighbor_count(0),
+    m_weight_func(1.0),
+    m_fit_step(),
+    m_fit_final(),
+    m_kdtree(nullptr),
+    m_grid(nullptr),
+    m_batched(true),
+    m_neighborhood(),
+    m_cache_inflation(0),
+    m_cache_valid(false),
+    m_cache_center(Vector3::Zero()),
+    m_cache_points(),
+    m_cache_normals(),
+    m_query_count(0)
+{
+}
+
+template<RIMLSOutputs O>
+RIMLSOperatorT<O>::~RIMLSOperatorT()
+{
+}
+
+template<RIMLSOutputs O>
+RIMLSOperatorT<O>::RIMLSOperatorT(const RIMLSOperatorT& other) :
+    m_scale(other.m_scale),
+    m_level(other.m_level),
+    m_reweighting_sigma(other.m_reweighting_sigma),
+    m_reweighting_step(other.m_reweighting_step),
+    m_step_max(other.m_step_max),
+    m_convergence_ratio_min(other.m_convergence_ratio_min),
+    m_step(other.m_step),
+    m_stable(other.m_stable),
+    m_neighbor_count(other.m_neighbor_count),
+    m_weight_func(other.m_weight_func),
+    m_fit_step(other.m_fit_step),
+    m_fit_final(other.m_fit_final),
+    m_kdtree(nullptr),
+    m_grid(other.m_grid),
+    m_batched(other.m_batched),
+    m_neighborhood(),
+    m_cache_inflation(other.m_cache_inflation),
+    m_cache_valid(false),
+    m_cache_center(Vector3::Zero()),
+    m_cache_points(),
+    m_cache_normals(),
+    m_query_count(0)
+{
+}
+
+// Neighbor cache --------------------------------------------------------------
+
+template<RIMLSOutputs O>
+void RIMLSOperatorT<O>::update_cache(const PointCloud& points, const Vector3& point)
+{
+    const Scalar max_dist = m_cache_inflation * m_scale;
+    if(m_cache_valid && (point - m_cache_center).squaredNorm() <= max_dist * max_dist)
+        return;
+
+    m_cache_points.clear();
+    m_cache_normals.clear();
+
+    this->for_each_in_range(point, (1 + m_cache_inflation) * m_scale, [this,&points](int idx_nei, Scalar)
+    {
+        m_cache_points.push_back(points.point(idx_nei));
+        m_cache_normals.push_back(points.normal(idx_nei));
+    });
+
+    m_cache_center = point;
+    m_cache_valid  = true;
+}
+
+template<RIMLSOutputs O>
+template<class FuncT>
+void RIMLSOperatorT<O>::for_each_neighbor(const PointCloud& points, const Vector3& point, FuncT&& f)
+{
+    if(m_cache_inflation > 0)
+    {
+        // any neighbor within the scale is inside the inflated cached ball
+        this->update_cache(points, point);
+
+        const Scalar squared_scale = m_scale * m_scale;
+        const int size = m_cache_points.size();
+        for(int i=0; i<size; ++i)
+        {
+            if((point - m_cache_points[i]).squaredNorm() < squared_scale)
+            {
+                f(m_cache_points[i], m_cache_normals[i]);
+            }
+        }
+    }
+    else
+    {
+        this->for_each_in_range(point, m_scale, [&points,&f](int idx_nei, Scalar)
+        {
+            f(points.point(idx_nei), points.normal(idx_nei));
+        });
+    }
+}
+
+template<RIMLSOutputs O>
+template<class FuncT>
+void RIMLSOperatorT<O>::for_each_in_range(const Vector3& point, Scalar r, FuncT&& f)
+{
+    if(m_grid)
+        m_grid->for_each_in_range(point, r, f);
+    else
+        m_kdtree->for_each_in_range(point, r, f, m_level);
+    ++m_query_count;
+}
+
+template<RIMLSOutputs O>
+void RIMLSOperatorT<O>::compute(const PointCloud& points, Vector3& point)
+{
+    this->compute(points, points.kdtree(), point);
+}
+
+template<RIMLSOutputs O>
+void RIMLSOperatorT<O>::compute(const PointCloud& points, const KdTree& kdtree, Vector3& point)
+{
+    m_kdtree = &kdtree;
+    m_cache_valid = false;
+    m_query_count = 0;
+
+    // First steps -------------------------------------------------------------
+    m_fit_step.setWeightFunc(m_weight_func);
+    Scalar dist_min = m_convergence_ratio_min * m_scale;
+    Scalar dist     = 10 * dist_min; // arbitrary initialization > dist_min
+    m_step          = 0;
+
+    Scalar  uc       = Scalar(0);
+    Vector3 ul       = Vector3::Zero();
+    Scalar  uq       = Scalar(0);
+
+    Scalar  potential = Scalar(0);
+    Vector3 gradient  = Vector3::Zero();
+
+    m_stable        = true;
+    bool converge   = dist < dist_min;
+    bool reach_max  = m_step >= m_step_max-1;
+
+    while(m_stable && !reach_max && !converge)
+    {
+        // the neighborhood does not change during the reweighting
+        if(m_batched)
+        {
+            m_neighborhood.clear();
+            for_each_neighbor(points, point, [&](const Vector3& nei_point, const Vector3& nei_normal)
+            {
+                m_neighborhood.push_back(nei_point, nei_normal);
+            });
+        }
+
+        // Reweighting
+        for(int n=0; n<m_reweighting_step; ++n)
+        {
+            // init
+            m_fit_step.init(point);
+
+            // add neighbors
+            if(m_batched)
+            {
+                // same parameters as WeightFunc(m_scale)
+                RIMLSKernel::Reweighting reweighting;
+                reweighting.enabled          = n > 0;
+                reweighting.uc               = uc;
+                reweighting.ul               = ul;
+                reweighting.uq               = uq;
+                reweighting.potential        = potential;
+                reweighting.gradient         = gradient;
+                reweighting.inv_sigma2       = Scalar(1);
+                reweighting.inv_sigma_scale2 = Scalar(1)/(0.5*m_scale * 0.5*m_scale);
+
+                RIMLSKernel::Sums sums;
+                RIMLSKernel::accumulate(m_neighborhood, point, m_scale, reweighting, sums);
+                m_fit_step.addSums(sums);
+            }
+            else
+            {
+                for_each_neighbor(points, point, [&](const Vector3& nei_point, const Vector3& nei_normal)
+                {
+                    Scalar diffN = Scalar(0.);
+                    Scalar diffP = Scalar(0.);
+                    if(n>0)
+                    {
+                        Vector3 q = nei_point - point;
+                        Scalar  s = uc + q.dot(ul) + q.squaredNorm()*uq;
+                        diffN = (gradient - nei_normal).norm();
+                        diffP = potential-s;
+                    }
+                    Point pt(nei_point,
+                             nei_normal,
+                             diffN,
+                             diffP);
+                    m_fit_step.addNeighbor(pt);
+                });
+            }
+
+            // finalize
+            m_stable = (m_fit_step.finalize() == Ponca::STABLE);
+            if(m_stable)
+            {
+                uc = m_fit_step.m_uc;
+                ul = m_fit_step.m_ul;
+                uq = m_fit_step.m_uq;
+                potential = m_fit_step.m_uc;
+                gradient  = m_fit_step.m_ul;
+            }
+        }
+
+        // project
+        if(m_stable)
+        {
+            Vector3 proj = m_fit_step.project(point);
+            dist         = (proj-point).norm();
+            converge     = dist < dist_min;
+            point        = proj;
+        }
+
+        // increment
+        ++m_step;
+        reach_max = m_step >= m_step_max-1;
+    }
+
+    // Last step ---------------------------------------------------------------
+    if(m_stable)
+    {
+        // init
+        m_fit_final.setWeightFunc(m_weight_func);
+        m_fit_final.init(point);
+        m_neighbor_count = 0;
+
+        // add neighbors
+        for_each_neighbor(points, point, [&](const Vector3& nei_point, const Vector3& nei_normal)
+        {
+            Scalar diffN = Scalar(0.);
+            Scalar diffP = Scalar(0.);
+            if(m_step > 0 && m_reweighting_step > 1)
+            {
+                Vector3 q = nei_point - point;
+                Scalar  s = uc + q.dot(ul) + q.squaredNorm()*uq;
+                diffN = (gradient - nei_normal).norm();
+                diffP = potential-s;
+            }
+            Point pt(nei_point,
+                     nei_normal,
+                     diffN,
+                     diffP);
+            m_fit_final.addNeighbor(pt);
+            ++m_neighbor_count;
+        });
+
+        // finalize
+        m_stable = (m_fit_final.finalize() == Ponca::STABLE);
+        if(m_stable)
+        {
+            point = m_fit_final.project(point);
+            Traits::compute_curvature(m_fit_final);
+        }
+        ++m_step;
+    }
+}
+
+// Accessors -------------------------------------------------------------------
+
+
+template<RIMLSOutputs O>
+Vector3 RIMLSOperatorT<O>::normal() const
+{
+    return Traits::normal(m_fit_final);
+}
+
+
+template<RIMLSOutputs O>
+Scalar RIMLSOperatorT<O>::k1() const
+{
+    return m_fit_final.k1();
+}
+
+
+template<RIMLSOutputs O>
+Scalar RIMLSOperatorT<O>::k2() const
+{
+    return m_fit_final.k2();
+}
+
+
+template<RIMLSOutputs O>
+bool RIMLSOperatorT<O>::stable() const
+{
+    return m_stable;
+}
+
+
+template<RIMLSOutputs O>
+int RIMLSOperatorT<O>::step_count() const
+{
+    return m_step;
+}
+
+
+template<RIMLSOutputs O>
+int RIMLSOperatorT<O>::neighbor_count() const
+{
+    return m_neighbor_count;
+}
+
+
+template<RIMLSOutputs O>
+int RIMLSOperatorT<O>::query_count() const
+{
+    return m_query_count;
+}
+
+
+template<RIMLSOutputs O>
+const typename RIMLSOperatorT<O>::FitFinal& RIMLSOperatorT<O>::fit() const
+{
+    return m_fit_final;
+}
+
+
+template<RIMLSOutputs O>
+typename RIMLSOperatorT<O>::FitFinal& RIMLSOperatorT<O>::fit()
+{
+    return m_fit_final;
+}
+
+// Parameters ------------------------------------------------------------------
+
+
+template<RIMLSOutputs O>
+int RIMLSOperatorT<O>::step_max() const
+{
+    return m_step_max;
+}
+
+
+template<RIMLSOutputs O>
+Scalar RIMLSOperatorT<O>::convergence_ratio_min() const
+{
+    return m_convergence_ratio_min;
+}
+
+
+template<RIMLSOutputs O>
+int RIMLSOperatorT<O>::reweighting_step() const
+{
+    return m_reweighting_step;
+}
+
+
+template<RIMLSOutputs O>
+Scalar RIMLSOperatorT<O>::cache_inflation() const
+{
+    return m_cache_inflation;
+}
+
+
+template<RIMLSOutputs O>
+bool RIMLSOperatorT<O>::batched() const
+{
+    return m_batched;
+}
+
+
+template<RIMLSOutputs O>
+void RIMLSOperatorT<O>::set_scale(Scalar scale)
+{
+    m_weight_func = WeightFunc(scale);
+    m_scale = scale;
+    m_cache_valid = false;
+}
+
+
+template<RIMLSOutputs O>
+void RIMLSOperatorT<O>::set_step_max(int step_max)
+{
+    m_step_max = step_max;
+}
+
+
+template<RIMLSOutputs O>
+void RIMLSOperatorT<O>::set_convergence_ratio_min(Scalar convergence_ratio_min)
+{
+    m_convergence_ratio_min = convergence_ratio_min;
+}
+
+
+template<RIMLSOutputs O>
+void RIMLSOperatorT<O>::set_reweighting_sigma(Scalar sigma)
+{
+    m_reweighting_sigma = sigma;
+}
+
+
+template<RIMLSOutputs O>
+void RIMLSOperatorT<O>::set_reweighting_step(int step)
+{
+    m_reweighting_step= step;
+}
+
+
+template<RIMLSOutputs O>
+void RIMLSOperatorT<O>::set_cache_inflation(Scalar inflation)
+{
+    m_cache_inflation = inflation;
+    m_cache_valid = false;
+}
+
+
+template<RIMLSOutputs O>
+void RIMLSOperatorT<O>::set_batched(bool batched)
+{
+    m_batched = batched;
+}
+
+
+template<RIMLSOutputs O>
+void RIMLSOperatorT<O>::set_level(int level)
+{
+    m_level = level;
+    m_cache_valid = false;
+}
+
+template<RIMLSOutputs O>
+void RIMLSOperatorT<O>::set_grid(const HashGrid* grid)
+{
+    m_grid = grid;
+    m_cache_valid = false;
+}
+
+} // namespace pdpc
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+
+#include <Ponca/core.h>
+
+namespace pdpc {
+
+//!
+//! \brief The RIMLSOutputs enum selects what the final fit of RIMLSOperatorT
+//! computes, so that unused derivatives are not accumulated
+//!
+enum RIMLSOutputs
+{
+    RIMLSNormal     = 0x1,              //!< MLS normal (1st order space derivatives)
+    RIMLSCurvatures = 0x1 | 0x2,        //!< normal and principal curvatures (2nd order space derivatives)
+    RIMLSScaleSpace = 0x1 | 0x2 | 0x4   //!< normal, curvatures and scale derivatives
+};
+
+//!
+//! \brief The RIMLSFitFinal struct gives the Ponca basket of the final fit of
+//! a RIMLSOutputs value and the way to read its outputs
+//!
+template<RIMLSOutputs Outputs>
+struct RIMLSFitFinal;
+
+template<>
+struct RIMLSFitFinal<RIMLSNormal>
+{
+    template<class P, class W>
+    using Fit = Ponca::Basket<P, W, Ponca::OrientedSphereFit,
+                                    Ponca::OrientedSphereSpaceDer>;
+
+    template<class FitT>
+    static inline void compute_curvature(FitT&) {}
+
+    // same as MlsSphereFitDer::normal()
+    template<class FitT>
+    static inline Vector3 normal(const FitT& fit) {return fit.dPotential().template tail<3>().transpose().normalized();}
+};
+
+template<>
+struct RIMLSFitFinal<RIMLSCurvatures>
+{
+    template<class P, class W>
+    using Fit = Ponca::Basket<P, W, Ponca::OrientedSphereFit,
+                                    Ponca::OrientedSphereSpaceDer,
+                                    Ponca::MlsSphereFitDer,
+                                    Ponca::CurvatureEstimator>;
+
+    template<class FitT>
+    static inline void compute_curvature(FitT& fit) {fit.computeCurvature(true);} // useNormal = true
+
+    template<class FitT>
+    static inline Vector3 normal(const FitT& fit) {return fit.normal();}
+};
+
+template<>
+struct RIMLSFitFinal<RIMLSScaleSpace>
+{
+    template<class P, class W>
+    using Fit = Ponca::Basket<P, W, Ponca::OrientedSphereFit,
+                                    Ponca::OrientedSphereScaleSpaceDer,
+                                    Ponca::MlsSphereFitDer,
+                                    Ponca::CurvatureEstimator>;
+
+    template<class FitT>
+    static inline void compute_curvature(FitT& fit) {fit.computeCurvature(true);} // useNormal = true
+
+    template<class FitT>
+    static inline Vector3 normal(const FitT& fit) {return fit.normal();}
+};
+
+} // namespace pdpc
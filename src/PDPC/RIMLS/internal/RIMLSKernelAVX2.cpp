@@ -0,0 +1,151 @@
+#include <PDPC/RIMLS/internal/RIMLSKernelImpl.h>
+
+#ifdef PDPC_SIMD_X86
+
+#include <immintrin.h>
+
+#define PDPC_TARGET_AVX2 __attribute__((target("avx2,fma")))
+
+namespace pdpc {
+namespace internal {
+
+namespace {
+
+// Cephes expf: exp(x) = 2^n * exp(r) with |r| <= ln(2)/2
+PDPC_TARGET_AVX2 inline __m256 exp_avx2(__m256 x)
+{
+    const __m256 underflow = _mm256_cmp_ps(x, _mm256_set1_ps(-103.97208f), _CMP_LT_OQ);
+
+    x = _mm256_min_ps(x, _mm256_set1_ps( 88.37626f));
+    x = _mm256_max_ps(x, _mm256_set1_ps(-87.33654f));
+
+    __m256 fx = _mm256_fmadd_ps(x, _mm256_set1_ps(1.44269504088896341f), _mm256_set1_ps(0.5f));
+    fx = _mm256_floor_ps(fx);
+
+    x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(0.693359375f), x);
+    x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(-2.12194440e-4f), x);
+
+    const __m256 z = _mm256_mul_ps(x, x);
+    __m256 y = _mm256_set1_ps(1.9875691500e-4f);
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.3981999507e-3f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(8.3334519073e-3f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(4.1665795894e-2f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.6666665459e-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(5.0000001201e-1f));
+    y = _mm256_fmadd_ps(y, z, x);
+    y = _mm256_add_ps(y, _mm256_set1_ps(1.f));
+
+    __m256i n = _mm256_cvttps_epi32(fx);
+    n = _mm256_add_epi32(n, _mm256_set1_epi32(127));
+    n = _mm256_slli_epi32(n, 23);
+    y = _mm256_mul_ps(y, _mm256_castsi256_ps(n));
+
+    return _mm256_andnot_ps(underflow, y);
+}
+
+PDPC_TARGET_AVX2 inline float hsum_avx2(__m256 v)
+{
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_movehdup_ps(s));
+    return _mm_cvtss_f32(s);
+}
+
+} // namespace
+
+PDPC_TARGET_AVX2 void rimls_accumulate_avx2(const RIMLSKernelArgs& a, RIMLSKernelResult& r)
+{
+    const __m256 cx  = _mm256_set1_ps(a.cx);
+    const __m256 cy  = _mm256_set1_ps(a.cy);
+    const __m256 cz  = _mm256_set1_ps(a.cz);
+    const __m256 t2  = _mm256_set1_ps(a.t2);
+    const __m256 it2 = _mm256_set1_ps(a.inv_t2);
+    const __m256 one = _mm256_set1_ps(1.f);
+
+    const __m256 uc  = _mm256_set1_ps(a.uc);
+    const __m256 ulx = _mm256_set1_ps(a.ulx);
+    const __m256 uly = _mm256_set1_ps(a.uly);
+    const __m256 ulz = _mm256_set1_ps(a.ulz);
+    const __m256 uq  = _mm256_set1_ps(a.uq);
+    const __m256 pot = _mm256_set1_ps(a.potential);
+    const __m256 gx  = _mm256_set1_ps(a.gx);
+    const __m256 gy  = _mm256_set1_ps(a.gy);
+    const __m256 gz  = _mm256_set1_ps(a.gz);
+    const __m256 is2 = _mm256_set1_ps(-a.inv_sigma2);
+    const __m256 iss = _mm256_set1_ps(-a.inv_sigma_scale2);
+
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i size = _mm256_set1_epi32(a.size);
+
+    __m256 spx = _mm256_setzero_ps(), spy = _mm256_setzero_ps(), spz = _mm256_setzero_ps();
+    __m256 snx = _mm256_setzero_ps(), sny = _mm256_setzero_ps(), snz = _mm256_setzero_ps();
+    __m256 spn = _mm256_setzero_ps(), spp = _mm256_setzero_ps(), sw  = _mm256_setzero_ps();
+    int count = 0;
+
+    for(int i=0; i<a.size; i+=8)
+    {
+        const __m256 px = _mm256_loadu_ps(a.px + i);
+        const __m256 py = _mm256_loadu_ps(a.py + i);
+        const __m256 pz = _mm256_loadu_ps(a.pz + i);
+        const __m256 nx = _mm256_loadu_ps(a.nx + i);
+        const __m256 ny = _mm256_loadu_ps(a.ny + i);
+        const __m256 nz = _mm256_loadu_ps(a.nz + i);
+
+        const __m256 qx = _mm256_sub_ps(px, cx);
+        const __m256 qy = _mm256_sub_ps(py, cy);
+        const __m256 qz = _mm256_sub_ps(pz, cz);
+        const __m256 d2 = _mm256_fmadd_ps(qz, qz, _mm256_fmadd_ps(qy, qy, _mm256_mul_ps(qx, qx)));
+
+        const __m256i idx    = _mm256_add_epi32(lane, _mm256_set1_epi32(i));
+        const __m256  active = _mm256_and_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(size, idx)),
+                                             _mm256_cmp_ps(d2, t2, _CMP_LE_OQ));
+
+        // SmoothWeightKernel (x^2-1)^2 with x = |q|/t
+        const __m256 v = _mm256_fmsub_ps(d2, it2, one);
+        __m256 w = _mm256_mul_ps(v, v);
+
+        if(a.reweight)
+        {
+            const __m256 s   = _mm256_fmadd_ps(d2, uq, _mm256_fmadd_ps(qz, ulz, _mm256_fmadd_ps(qy, uly, _mm256_fmadd_ps(qx, ulx, uc))));
+            const __m256 dp  = _mm256_sub_ps(pot, s);
+            const __m256 gnx = _mm256_sub_ps(gx, nx);
+            const __m256 gny = _mm256_sub_ps(gy, ny);
+            const __m256 gnz = _mm256_sub_ps(gz, nz);
+            const __m256 dn2 = _mm256_fmadd_ps(gnz, gnz, _mm256_fmadd_ps(gny, gny, _mm256_mul_ps(gnx, gnx)));
+            const __m256 e   = _mm256_fmadd_ps(dn2, is2, _mm256_mul_ps(_mm256_mul_ps(dp, dp), iss));
+            w = _mm256_mul_ps(w, exp_avx2(e));
+        }
+        w = _mm256_and_ps(w, active);
+
+        count += __builtin_popcount(_mm256_movemask_ps(_mm256_cmp_ps(w, _mm256_setzero_ps(), _CMP_GT_OQ)));
+
+        spx = _mm256_fmadd_ps(w, qx, spx);
+        spy = _mm256_fmadd_ps(w, qy, spy);
+        spz = _mm256_fmadd_ps(w, qz, spz);
+        snx = _mm256_fmadd_ps(w, nx, snx);
+        sny = _mm256_fmadd_ps(w, ny, sny);
+        snz = _mm256_fmadd_ps(w, nz, snz);
+        spn = _mm256_fmadd_ps(w, _mm256_fmadd_ps(nz, qz, _mm256_fmadd_ps(ny, qy, _mm256_mul_ps(nx, qx))), spn);
+        spp = _mm256_fmadd_ps(w, d2, spp);
+        sw  = _mm256_add_ps(sw, w);
+    }
+
+    r.sum_px     = hsum_avx2(spx);
+    r.sum_py     = hsum_avx2(spy);
+    r.sum_pz     = hsum_avx2(spz);
+    r.sum_nx     = hsum_avx2(snx);
+    r.sum_ny     = hsum_avx2(sny);
+    r.sum_nz     = hsum_avx2(snz);
+    r.sum_dot_pn = hsum_avx2(spn);
+    r.sum_dot_pp = hsum_avx2(spp);
+    r.sum_w      = hsum_avx2(sw);
+    r.count      = count;
+
+    // avoid the penalty of the dirty upper state in the non-VEX caller
+    _mm256_zeroupper();
+}
+
+} // namespace internal
+} // namespace pdpc
+
+#endif // PDPC_SIMD_X86
@@ -0,0 +1,136 @@
+#include <PDPC/RIMLS/internal/RIMLSKernelImpl.h>
+#include <PDPC/Common/internal/SimdAVX512.h>
+
+#ifdef PDPC_SIMD_X86
+
+namespace pdpc {
+namespace internal {
+
+namespace {
+
+// Cephes expf: exp(x) = 2^n * exp(r) with |r| <= ln(2)/2
+PDPC_TARGET_AVX512 inline __m512 exp_avx512(__m512 x)
+{
+    const __mmask16 underflow = _mm512_cmp_ps_mask(x, _mm512_set1_ps(-103.97208f), _CMP_LT_OQ);
+
+    // zero-masked forms, see avx512_all_lanes
+    x = _mm512_maskz_min_ps(avx512_all_lanes, x, _mm512_set1_ps( 88.37626f));
+    x = _mm512_maskz_max_ps(avx512_all_lanes, x, _mm512_set1_ps(-87.33654f));
+
+    __m512 fx = _mm512_fmadd_ps(x, _mm512_set1_ps(1.44269504088896341f), _mm512_set1_ps(0.5f));
+    fx = _mm512_maskz_roundscale_ps(avx512_all_lanes, fx, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+
+    x = _mm512_fnmadd_ps(fx, _mm512_set1_ps(0.693359375f), x);
+    x = _mm512_fnmadd_ps(fx, _mm512_set1_ps(-2.12194440e-4f), x);
+
+    const __m512 z = _mm512_mul_ps(x, x);
+    __m512 y = _mm512_set1_ps(1.9875691500e-4f);
+    y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(1.3981999507e-3f));
+    y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(8.3334519073e-3f));
+    y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(4.1665795894e-2f));
+    y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(1.6666665459e-1f));
+    y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(5.0000001201e-1f));
+    y = _mm512_fmadd_ps(y, z, x);
+    y = _mm512_add_ps(y, _mm512_set1_ps(1.f));
+
+    y = _mm512_maskz_scalef_ps(avx512_all_lanes, y, fx);
+
+    return _mm512_maskz_mov_ps(_mm512_knot(underflow), y);
+}
+
+} // namespace
+
+PDPC_TARGET_AVX512 void rimls_accumulate_avx512(const RIMLSKernelArgs& a, RIMLSKernelResult& r)
+{
+    const __m512 cx  = _mm512_set1_ps(a.cx);
+    const __m512 cy  = _mm512_set1_ps(a.cy);
+    const __m512 cz  = _mm512_set1_ps(a.cz);
+    const __m512 t2  = _mm512_set1_ps(a.t2);
+    const __m512 it2 = _mm512_set1_ps(a.inv_t2);
+    const __m512 one = _mm512_set1_ps(1.f);
+
+    const __m512 uc  = _mm512_set1_ps(a.uc);
+    const __m512 ulx = _mm512_set1_ps(a.ulx);
+    const __m512 uly = _mm512_set1_ps(a.uly);
+    const __m512 ulz = _mm512_set1_ps(a.ulz);
+    const __m512 uq  = _mm512_set1_ps(a.uq);
+    const __m512 pot = _mm512_set1_ps(a.potential);
+    const __m512 gx  = _mm512_set1_ps(a.gx);
+    const __m512 gy  = _mm512_set1_ps(a.gy);
+    const __m512 gz  = _mm512_set1_ps(a.gz);
+    const __m512 is2 = _mm512_set1_ps(-a.inv_sigma2);
+    const __m512 iss = _mm512_set1_ps(-a.inv_sigma_scale2);
+
+    __m512 spx = _mm512_setzero_ps(), spy = _mm512_setzero_ps(), spz = _mm512_setzero_ps();
+    __m512 snx = _mm512_setzero_ps(), sny = _mm512_setzero_ps(), snz = _mm512_setzero_ps();
+    __m512 spn = _mm512_setzero_ps(), spp = _mm512_setzero_ps(), sw  = _mm512_setzero_ps();
+    int count = 0;
+
+    for(int i=0; i<a.size; i+=16)
+    {
+        const int       remaining = a.size - i;
+        const __mmask16 in_size   = remaining >= 16 ? __mmask16(0xFFFF) : __mmask16((1u << remaining) - 1);
+
+        const __m512 px = _mm512_loadu_ps(a.px + i);
+        const __m512 py = _mm512_loadu_ps(a.py + i);
+        const __m512 pz = _mm512_loadu_ps(a.pz + i);
+        const __m512 nx = _mm512_loadu_ps(a.nx + i);
+        const __m512 ny = _mm512_loadu_ps(a.ny + i);
+        const __m512 nz = _mm512_loadu_ps(a.nz + i);
+
+        const __m512 qx = _mm512_sub_ps(px, cx);
+        const __m512 qy = _mm512_sub_ps(py, cy);
+        const __m512 qz = _mm512_sub_ps(pz, cz);
+        const __m512 d2 = _mm512_fmadd_ps(qz, qz, _mm512_fmadd_ps(qy, qy, _mm512_mul_ps(qx, qx)));
+
+        const __mmask16 active = _mm512_mask_cmp_ps_mask(in_size, d2, t2, _CMP_LE_OQ);
+
+        // SmoothWeightKernel (x^2-1)^2 with x = |q|/t
+        const __m512 v = _mm512_fmsub_ps(d2, it2, one);
+        __m512 w = _mm512_mul_ps(v, v);
+
+        if(a.reweight)
+        {
+            const __m512 s   = _mm512_fmadd_ps(d2, uq, _mm512_fmadd_ps(qz, ulz, _mm512_fmadd_ps(qy, uly, _mm512_fmadd_ps(qx, ulx, uc))));
+            const __m512 dp  = _mm512_sub_ps(pot, s);
+            const __m512 gnx = _mm512_sub_ps(gx, nx);
+            const __m512 gny = _mm512_sub_ps(gy, ny);
+            const __m512 gnz = _mm512_sub_ps(gz, nz);
+            const __m512 dn2 = _mm512_fmadd_ps(gnz, gnz, _mm512_fmadd_ps(gny, gny, _mm512_mul_ps(gnx, gnx)));
+            const __m512 e   = _mm512_fmadd_ps(dn2, is2, _mm512_mul_ps(_mm512_mul_ps(dp, dp), iss));
+            w = _mm512_mul_ps(w, exp_avx512(e));
+        }
+        w = _mm512_maskz_mov_ps(active, w);
+
+        count += __builtin_popcount(_mm512_cmp_ps_mask(w, _mm512_setzero_ps(), _CMP_GT_OQ));
+
+        spx = _mm512_fmadd_ps(w, qx, spx);
+        spy = _mm512_fmadd_ps(w, qy, spy);
+        spz = _mm512_fmadd_ps(w, qz, spz);
+        snx = _mm512_fmadd_ps(w, nx, snx);
+        sny = _mm512_fmadd_ps(w, ny, sny);
+        snz = _mm512_fmadd_ps(w, nz, snz);
+        spn = _mm512_fmadd_ps(w, _mm512_fmadd_ps(nz, qz, _mm512_fmadd_ps(ny, qy, _mm512_mul_ps(nx, qx))), spn);
+        spp = _mm512_fmadd_ps(w, d2, spp);
+        sw  = _mm512_add_ps(sw, w);
+    }
+
+    r.sum_px     = hsum_avx512(spx);
+    r.sum_py     = hsum_avx512(spy);
+    r.sum_pz     = hsum_avx512(spz);
+    r.sum_nx     = hsum_avx512(snx);
+    r.sum_ny     = hsum_avx512(sny);
+    r.sum_nz     = hsum_avx512(snz);
+    r.sum_dot_pn = hsum_avx512(spn);
+    r.sum_dot_pp = hsum_avx512(spp);
+    r.sum_w      = hsum_avx512(sw);
+    r.count      = count;
+
+    // avoid the penalty of the dirty upper state in the non-VEX caller
+    _mm256_zeroupper();
+}
+
+} // namespace internal
+} // namespace pdpc
+
+#endif // PDPC_SIMD_X86
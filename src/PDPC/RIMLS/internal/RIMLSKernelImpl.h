@@ -0,0 +1,52 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+#include <PDPC/Common/Cpu.h>
+
+namespace pdpc {
+namespace internal {
+
+// plain arguments shared by the kernels compiled for each instruction set
+struct RIMLSKernelArgs
+{
+    const Scalar* px;
+    const Scalar* py;
+    const Scalar* pz;
+    const Scalar* nx;
+    const Scalar* ny;
+    const Scalar* nz;
+    int size; // arrays are readable up to the next multiple of 16
+
+    Scalar cx, cy, cz;
+    Scalar t2;
+    Scalar inv_t2;
+
+    bool   reweight;
+    Scalar uc;
+    Scalar ulx, uly, ulz;
+    Scalar uq;
+    Scalar potential;
+    Scalar gx, gy, gz;
+    Scalar inv_sigma2;
+    Scalar inv_sigma_scale2;
+};
+
+struct RIMLSKernelResult
+{
+    Scalar sum_px, sum_py, sum_pz;
+    Scalar sum_nx, sum_ny, sum_nz;
+    Scalar sum_dot_pn;
+    Scalar sum_dot_pp;
+    Scalar sum_w;
+    int    count;
+};
+
+void rimls_accumulate_scalar(const RIMLSKernelArgs& args, RIMLSKernelResult& res);
+
+#ifdef PDPC_SIMD_X86
+void rimls_accumulate_avx2(  const RIMLSKernelArgs& args, RIMLSKernelResult& res);
+void rimls_accumulate_avx512(const RIMLSKernelArgs& args, RIMLSKernelResult& res);
+#endif
+
+} // namespace internal
+} // namespace pdpc
@@ -0,0 +1,162 @@
+#include <PDPC/ScaleSpace/PoissonDiskSampling.h>
+#include <PDPC/SpacePartitioning/internal/CellGrid.h>
+#include <PDPC/Common/Algorithms/parallel_sort.h>
+#include <PDPC/Common/Assert.h>
+
+#include <array>
+
+namespace pdpc {
+
+namespace {
+
+using internal::CellGrid;
+
+inline int cell_color(std::uint64_t key)
+{
+    const Vector3i c = CellGrid::coords(key);
+    return (c.x() % 3) + 3 * (c.y() % 3) + 9 * (c.z() % 3);
+}
+
+struct Entry
+{
+    std::uint64_t key;
+    std::uint64_t priority;
+    int           index;
+
+    bool operator < (const Entry& other) const
+    {
+        if(key != other.key) return key < other.key;
+        if(priority != other.priority) return priority > other.priority;
+        return index < other.index;
+    }
+};
+
+} // namespace
+
+// PoissonDiskSampling ---------------------------------------------------------
+
+PoissonDiskSampling::PoissonDiskSampling(std::uint64_t seed) :
+    m_seed(seed)
+{
+}
+
+// Sampling --------------------------------------------------------------------
+
+void PoissonDiskSampling::sample(const Vector3Array& points,
+                                 const std::vector<int>& indices,
+                                 Scalar radius,
+                                 std::vector<int>& samples) const
+{
+    PDPC_DEBUG_ASSERT(radius > 0);
+
+    samples.clear();
+    const int size = indices.size();
+    if(size == 0) return;
+
+    // 1. grid of the bounding box, with cells at least as large as the radius
+    const CellGrid grid(internal::bounding_box(points, indices), radius);
+
+    // 2. points sorted by cell ------------------------------------------------
+    std::vector<Entry> entries(size);
+    #pragma omp parallel for
+    for(int n=0; n<size; ++n)
+    {
+        const int idx = indices[n];
+        entries[n].key      = grid.key_of(points[idx]);
+        entries[n].priority = priority(m_seed, idx);
+        entries[n].index    = idx;
+    }
+    parallel_sort(entries.begin(), entries.end());
+
+    std::vector<std::uint64_t> cell_keys;
+    std::vector<int>           cell_starts;
+    internal::cell_ranges(entries, cell_keys, cell_starts);
+    const int cell_count = cell_keys.size();
+
+    std::array<std::vector<int>,27> colors;
+    for(int c=0; c<cell_count; ++c)
+        colors[cell_color(cell_keys[c])].push_back(c);
+
+    // 3. sampling -------------------------------------------------------------
+    const Scalar squared_radius = radius * radius;
+    std::vector<char> is_sample(size, false);
+
+    for(const std::vector<int>& cells : colors)
+    {
+        const int color_size = cells.size();
+
+        #pragma omp parallel for schedule(dynamic,64)
+        for(int n=0; n<color_size; ++n)
+        {
+            const int      c    = cells[n];
+            const Vector3i cell = CellGrid::coords(cell_keys[c]);
+
+            // ranges of the neighbor cells (including c)
+            std::array<std::pair<int,int>,27> neighbors;
+            int neighbor_count = 0;
+            for(int dx=-1; dx<=1; ++dx)
+            for(int dy=-1; dy<=1; ++dy)
+            for(int dz=-1; dz<=1; ++dz)
+            {
+                const Vector3i other = cell + Vector3i(dx, dy, dz);
+                if((other.array() < 0).any() || (other.array() >= grid.dims.array()).any()) continue;
+                const std::uint64_t key = CellGrid::key(other.x(), other.y(), other.z());
+                const auto it = std::lower_bound(cell_keys.begin(), cell_keys.end(), key);
+                if(it == cell_keys.end() || *it != key) continue;
+                const int nc = std::distance(cell_keys.begin(), it);
+                neighbors[neighbor_count++] = {cell_starts[nc], cell_starts[nc+1]};
+            }
+
+            for(int e=cell_starts[c]; e<cell_starts[c+1]; ++e)
+            {
+                const Vector3& point = points[entries[e].index];
+
+                bool free = true;
+                for(int k=0; k<neighbor_count && free; ++k)
+                {
+                    for(int f=neighbors[k].first; f<neighbors[k].second; ++f)
+                    {
+                        if(is_sample[f] && (point - points[entries[f].index]).squaredNorm() < squared_radius)
+                        {
+                            free = false;
+                            break;
+                        }
+                    }
+                }
+                is_sample[e] = free;
+            }
+        }
+    }
+
+    // 4. output ---------------------------------------------------------------
+    for(int n=0; n<size; ++n)
+    {
+        if(is_sample[n]) samples.push_back(entries[n].index);
+    }
+    parallel_sort(samples.begin(), samples.end());
+}
+
+// Parameters ------------------------------------------------------------------
+
+std::uint64_t PoissonDiskSampling::seed() const
+{
+    return m_seed;
+}
+
+void PoissonDiskSampling::set_seed(std::uint64_t seed)
+{
+    m_seed = seed;
+}
+
+// Internal --------------------------------------------------------------------
+
+std::uint64_t PoissonDiskSampling::priority(std::uint64_t seed, int index)
+{
+    // splitmix64 finalizer
+    std::uint64_t z = seed + std::uint64_t(index) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+} // namespace pdpc
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+
+#include <cstdint>
+
+namespace pdpc {
+
+//!
+//! \brief The PoissonDiskSampling class computes a maximal Poisson-disk
+//! sub-sampling of a set of points in parallel
+//!
+//! The points are binned into a grid of cell size equal to the radius, and
+//! the cells are processed by 27 colors so that two cells of the same color
+//! never share a neighbor within the radius. Inside a cell the points are
+//! visited by decreasing random priority, given by a hash of the seed and of
+//! the point index. The result only depends on the seed and on the input
+//! indices, not on the thread count.
+//!
+class PoissonDiskSampling
+{
+    // PoissonDiskSampling -----------------------------------------------------
+public:
+    PoissonDiskSampling(std::uint64_t seed = 0);
+
+    // Sampling ----------------------------------------------------------------
+public:
+    //!
+    //! \brief sample selects a subset of indices such that two samples are at
+    //! least radius apart and every input point lies within radius of a sample
+    //!
+    //! \param points  the point positions
+    //! \param indices the candidate point indices
+    //! \param radius  the minimal distance between two samples
+    //! \param samples the selected point indices, sorted by increasing index
+    //!
+    void sample(const Vector3Array& points,
+                const std::vector<int>& indices,
+                Scalar radius,
+                std::vector<int>& samples) const;
+
+    // Parameters --------------------------------------------------------------
+public:
+    std::uint64_t seed() const;
+    void set_seed(std::uint64_t seed);
+
+    // Internal ----------------------------------------------------------------
+public:
+    static std::uint64_t priority(std::uint64_t seed, int index);
+
+    // Data --------------------------------------------------------------------
+protected:
+    std::uint64_t m_seed;
+
+}; // class PoissonDiskSampling
+
+} // namespace pdpc
@@ -4,6 +4,7 @@
 
 #include <cmath>
 #include <fstream>
+#include <limits>
 
 namespace pdpc {
 
@@ -63,6 +64,8 @@ bool ScaleSampling::save(const std::string& filename, bool v) const
         return false;
     }
 
+    // exact round trip, the scales of the shards must be the same
+    ofs.precision(std::numeric_limits<Scalar>::max_digits10);
     for(const Scalar s : m_scales)
     {
         ofs << s << " ";
@@ -1,5 +1,6 @@
 #include <PDPC/Segmentation/MSSegmentation.h>
 #include <PDPC/Common/Log.h>
+#include <PDPC/Common/TextFile.h>
 
 #include <fstream>
 
@@ -29,8 +30,8 @@ bool MSSegmentation::is_valid() const
 
 bool MSSegmentation::load(const std::string& filename)
 {
-    std::ifstream ifs(filename);
-    if(!ifs.is_open())
+    TextFile file;
+    if(!file.open(filename, false))
     {
         warning() << "Failed to open output file " << filename;
         return false;
@@ -39,8 +40,17 @@ bool MSSegmentation::load(const std::string& filename)
     int point_count = 0;
     int scale_count = 0;
 
-    ifs >> point_count;
-    ifs >> scale_count;
+    // header line then one line per point
+    const char* begin = nullptr;
+    const char* end   = nullptr;
+    if(!file.line(0, begin, end) ||
+       !(begin = TextFile::parse(begin, end, point_count)) ||
+       !(begin = TextFile::parse(begin, end, scale_count)) ||
+       file.line_count() < point_count + 1)
+    {
+        warning() << "Failed to read the header of file " << filename;
+        return false;
+    }
 
     PDPC_DEBUG_ASSERT(point_count > 0);
     PDPC_DEBUG_ASSERT(scale_count > 0);
@@ -49,13 +59,26 @@ bool MSSegmentation::load(const std::string& filename)
 
     std::vector<std::vector<int>> labels(scale_count, std::vector<int>(point_count, -1));
 
-    for(int i=0; i<point_count; ++i)
+    const bool ok = file.for_each_line([&](int l, const char* p, const char* end) -> bool
     {
-        for(int j=0; j<scale_count; ++j)
+        const int i = l - 1;
+        if(i >= point_count)
+            return true;
+
+        for(int j=0; j<scale_count && p; ++j)
         {
-            ifs >> labels[j][i];
+            p = TextFile::parse(p, end, labels[j][i]);
         }
+        return p != nullptr;
+    }, 1);
+
+    if(!ok)
+    {
+        warning() << "Failed to read file " << filename;
+        return false;
     }
+
+    #pragma omp parallel for
     for(int j=0; j<scale_count; ++j)
     {
         m_data[j] = Segmentation(labels[j]);
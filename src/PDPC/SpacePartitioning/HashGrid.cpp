@@ -0,0 +1,246 @@
+#include <PDPC/SpacePartitioning/HashGrid.h>
+#include <PDPC/Common/Algorithms/parallel_sort.h>
+#include <PDPC/Common/Assert.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace pdpc {
+
+namespace {
+
+struct Entry
+{
+    std::uint64_t key;
+    Index         index;
+
+    bool operator < (const Entry& other) const
+    {
+        if(key != other.key) return key < other.key;
+        return index < other.index;
+    }
+};
+
+} // namespace
+
+HashGrid::HashGrid() :
+    m_points(nullptr),
+    m_indices(),
+    m_cell_points(),
+    m_cell_keys(),
+    m_cell_starts(1, 0),
+    m_table(),
+    m_grid()
+{
+}
+
+HashGrid::HashGrid(std::shared_ptr<Vector3Array>& points, Scalar cell_size) :
+    HashGrid()
+{
+    this->build(points, cell_size);
+}
+
+HashGrid::HashGrid(std::shared_ptr<Vector3Array>& points, Scalar cell_size, const std::vector<Index>& sampling) :
+    HashGrid()
+{
+    this->build(points, cell_size, sampling);
+}
+
+void HashGrid::clear()
+{
+    m_points = nullptr;
+    m_indices.clear();
+    m_cell_points.clear();
+    m_cell_keys.clear();
+    m_cell_starts.assign(1, 0);
+    m_table.clear();
+    m_grid = internal::CellGrid();
+}
+
+void HashGrid::build(std::shared_ptr<Vector3Array>& points, Scalar cell_size)
+{
+    std::vector<Index> sampling(points->size());
+    std::iota(sampling.begin(), sampling.end(), 0);
+    this->build(points, cell_size, sampling);
+}
+
+void HashGrid::build(std::shared_ptr<Vector3Array>& points, Scalar cell_size, const std::vector<Index>& sampling)
+{
+    PDPC_DEBUG_ASSERT(cell_size > 0);
+
+    this->clear();
+
+    m_points         = points;
+    m_grid.cell_size = cell_size;
+
+    const Vector3Array& pts = *m_points.get();
+    const Index size = sampling.size();
+    if(size == 0) return;
+
+    // 1. grid of the bounding box ---------------------------------------------
+    m_grid = internal::CellGrid(internal::bounding_box(pts, sampling), cell_size);
+
+    // 2. points sorted by cell ------------------------------------------------
+    std::vector<Entry> entries(size);
+    #pragma omp parallel for
+    for(Index n=0; n<size; ++n)
+    {
+        const Index idx = sampling[n];
+        entries[n].key   = m_grid.key_of(pts[idx]);
+        entries[n].index = idx;
+    }
+    parallel_sort(entries.begin(), entries.end());
+
+    m_indices.resize(size);
+    m_cell_points.resize(size);
+    #pragma omp parallel for
+    for(Index n=0; n<size; ++n)
+    {
+        m_indices[n]     = entries[n].index;
+        m_cell_points[n] = pts[entries[n].index];
+    }
+
+    internal::cell_ranges(entries, m_cell_keys, m_cell_starts);
+
+    // 3. hash table of the cells ----------------------------------------------
+    const Index cell_count = m_cell_keys.size();
+    std::size_t table_size = 1;
+    while(table_size < 2 * std::size_t(cell_count)) table_size *= 2;
+    m_table.assign(table_size, -1);
+
+    const std::uint64_t mask = table_size - 1;
+    for(Index c=0; c<cell_count; ++c)
+    {
+        std::uint64_t slot = cell_hash(m_cell_keys[c]) & mask;
+        while(m_table[slot] >= 0) slot = (slot + 1) & mask;
+        m_table[slot] = c;
+    }
+
+    PDPC_DEBUG_ASSERT(this->valid());
+}
+
+bool HashGrid::valid() const
+{
+    if(!m_points)
+        return m_indices.empty();
+
+    if(m_cell_points.size() != m_indices.size() || m_cell_starts.size() != m_cell_keys.size() + 1)
+    {
+        PDPC_DEBUG_ASSERT(false);
+        return false;
+    }
+
+    const Index cell_count = m_cell_keys.size();
+    for(Index c=0; c<cell_count; ++c)
+    {
+        if(this->find_cell(m_cell_keys[c]) != c || m_cell_starts[c] >= m_cell_starts[c+1])
+        {
+            PDPC_DEBUG_ASSERT(false);
+            return false;
+        }
+        for(Index pos=m_cell_starts[c]; pos<m_cell_starts[c+1]; ++pos)
+        {
+            if(m_grid.key_of(m_cell_points[pos]) != m_cell_keys[c] ||
+               m_cell_points[pos] != (*m_points)[m_indices[pos]])
+            {
+                PDPC_DEBUG_ASSERT(false);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Query -----------------------------------------------------------------------
+
+HashGridRangePointQuery HashGrid::range_neighbors(const Vector3& point, Scalar r) const
+{
+    return RangePointQuery(this, r, point);
+}
+
+HashGridRangeIndexQuery HashGrid::range_neighbors(Index index, Scalar r) const
+{
+    return RangeIndexQuery(this, r, index);
+}
+
+// Empty Query -----------------------------------------------------------------
+
+HashGridRangePointQuery HashGrid::range_point_query(Scalar r) const
+{
+    return RangePointQuery(this, r);
+}
+
+HashGridRangeIndexQuery HashGrid::range_index_query(Scalar r) const
+{
+    return RangeIndexQuery(this, r);
+}
+
+// Accessors -------------------------------------------------------------------
+
+Scalar HashGrid::cell_size() const
+{
+    return m_grid.cell_size;
+}
+
+Index HashGrid::cell_count() const
+{
+    return m_cell_keys.size();
+}
+
+Index HashGrid::index_count() const
+{
+    return m_indices.size();
+}
+
+Index HashGrid::point_count() const
+{
+    return m_points ? Index(m_points->size()) : 0;
+}
+
+const Vector3Array& HashGrid::point_data() const
+{
+    return *m_points.get();
+}
+
+const std::shared_ptr<Vector3Array>& HashGrid::point_ptr() const
+{
+    return m_points;
+}
+
+const std::vector<Index>& HashGrid::index_data() const
+{
+    return m_indices;
+}
+
+const Vector3Array& HashGrid::cell_point_data() const
+{
+    return m_cell_points;
+}
+
+// Internal --------------------------------------------------------------------
+
+bool HashGrid::cell_range(const Vector3& point, Scalar r, Vector3i& first, Vector3i& last) const
+{
+    first = Vector3i::Zero();
+    last  = -Vector3i::Ones();
+    if(m_cell_keys.empty()) return false;
+
+    // the radius is slightly inflated so that the rounding of the bounds (or
+    // of a radius given by its square) does not miss a cell
+    const Scalar margin = r + r * Scalar(1e-5);
+    const Vector3 lo = (point - Vector3::Constant(margin) - m_grid.origin) / m_grid.cell_size;
+    const Vector3 hi = (point + Vector3::Constant(margin) - m_grid.origin) / m_grid.cell_size;
+    for(int k=0; k<3; ++k)
+    {
+        if(hi[k] < 0 || lo[k] >= m_grid.dims[k])
+        {
+            last = -Vector3i::Ones();
+            return false;
+        }
+        first[k] = lo[k] <= 0 ? 0 : int(lo[k]);
+        last[k]  = hi[k] >= m_grid.dims[k] - 1 ? m_grid.dims[k] - 1 : int(hi[k]);
+    }
+    return true;
+}
+
+} // namespace pdpc
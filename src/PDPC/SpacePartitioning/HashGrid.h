@@ -0,0 +1,135 @@
+#pragma once
+
+#include <PDPC/SpacePartitioning/HashGrid/Query/HashGridRangeIndexQuery.h>
+#include <PDPC/SpacePartitioning/HashGrid/Query/HashGridRangePointQuery.h>
+#include <PDPC/SpacePartitioning/internal/CellGrid.h>
+
+#include <cstdint>
+#include <memory>
+
+namespace pdpc {
+
+//!
+//! \brief The HashGrid class is a uniform grid for fixed-radius queries
+//!
+//! The points are sorted by cell and copied in this order, and the non-empty
+//! cells are found with a hash table of their keys. A query visits the cells
+//! intersecting the bounding box of its ball: with a cell size equal to the
+//! radius this is the 27-cell stencil around the point. The cells of a row of
+//! the stencil are contiguous in the sorted points, so that a query scans at
+//! most 9 ranges of points.
+//!
+//! Any radius is supported, but the grid is only efficient for radii close
+//! to the cell size.
+//!
+class HashGrid
+{
+    // Types -------------------------------------------------------------------
+public:
+    using RangePointQuery = HashGridRangePointQuery;
+    using RangeIndexQuery = HashGridRangeIndexQuery;
+
+    // HashGrid ----------------------------------------------------------------
+public:
+    HashGrid();
+    HashGrid(std::shared_ptr<Vector3Array>& points, Scalar cell_size);
+    HashGrid(std::shared_ptr<Vector3Array>& points, Scalar cell_size, const std::vector<Index>& sampling);
+
+    void clear();
+    void build(std::shared_ptr<Vector3Array>& points, Scalar cell_size);
+
+    //!
+    //! \brief build indexes only the points of sampling
+    //!
+    //! The cell size is increased if needed so that the cell coordinates fit
+    //! in 21 bits.
+    //!
+    void build(std::shared_ptr<Vector3Array>& points, Scalar cell_size, const std::vector<Index>& sampling);
+
+    bool valid() const;
+
+    // Query -------------------------------------------------------------------
+public:
+    RangePointQuery range_neighbors(const Vector3& point, Scalar r) const;
+    RangeIndexQuery range_neighbors(Index index, Scalar r) const;
+
+    // Visitor Query -----------------------------------------------------------
+public:
+    //!
+    //! \brief for_each_in_range calls f(index, squared_distance) for each point
+    //! closer than r, in the order of range_neighbors
+    //!
+    //! f may return a bool, false to stop the traversal, in which case
+    //! for_each_in_range returns false (see KdTree::for_each_in_range).
+    //!
+    template<class VisitorT>
+    bool for_each_in_range(const Vector3& point, Scalar r, VisitorT&& f) const;
+
+    //! \brief for_each_in_range visits the neighbors of the point index, excluding itself
+    template<class VisitorT>
+    bool for_each_in_range(Index index, Scalar r, VisitorT&& f) const;
+
+    // Empty Query -------------------------------------------------------------
+public:
+    RangePointQuery range_point_query(Scalar r = 0) const;
+    RangeIndexQuery range_index_query(Scalar r = 0) const;
+
+    // Accessors ---------------------------------------------------------------
+public:
+    Scalar cell_size() const;
+    Index  cell_count() const;
+    Index  index_count() const;
+    Index  point_count() const;
+
+    const Vector3Array& point_data() const;
+
+    const std::shared_ptr<Vector3Array>& point_ptr() const;
+
+    //! \brief index_data gives the indexed points sorted by cell
+    const std::vector<Index>& index_data() const;
+
+    //! \brief cell_point_data gives the points in the order of index_data()
+    const Vector3Array& cell_point_data() const;
+
+    // Internal ----------------------------------------------------------------
+public:
+    //! \brief cell_hash mixes the bits of a key for the hash table
+    static inline std::uint64_t cell_hash(std::uint64_t key);
+
+    //!
+    //! \brief cell_range computes the cells [first,last] intersecting the
+    //! bounding box of the ball, returns false if there is none
+    //!
+    bool cell_range(const Vector3& point, Scalar r, Vector3i& first, Vector3i& last) const;
+
+    //! \brief find_cell returns the id of the cell of the given key, -1 if it is empty
+    inline Index find_cell(std::uint64_t key) const;
+
+    //!
+    //! \brief row_range computes the positions in index_data() of the points
+    //! of the cells (x,y,first_z) to (x,y,last_z) that intersect the ball,
+    //! returns false if they are all empty
+    //!
+    //! The cells of a row are contiguous in the key order, so that a single
+    //! lookup in the hash table is needed once a non-empty cell is found.
+    //!
+    inline bool row_range(const Vector3& point, Scalar r, int x, int y, int first_z, int last_z, Index& start, Index& end) const;
+
+    template<class VisitorT>
+    bool visit_range(const Vector3& point, Scalar r, Index excluded, VisitorT& f) const;
+
+    // Data --------------------------------------------------------------------
+protected:
+    std::shared_ptr<Vector3Array> m_points;
+    std::vector<Index>            m_indices;      //!< indexed points sorted by cell
+    Vector3Array                  m_cell_points;  //!< points in the order of m_indices
+    std::vector<std::uint64_t>    m_cell_keys;    //!< sorted keys of the non-empty cells
+    std::vector<Index>            m_cell_starts;  //!< the cell c holds the positions [m_cell_starts[c], m_cell_starts[c+1])
+    std::vector<Index>            m_table;        //!< open addressing hash table of the cells, -1 if empty
+    internal::CellGrid            m_grid;         //!< cells of the bounding box of the indexed points
+};
+
+} // namespace pdpc
+
+#include <PDPC/SpacePartitioning/HashGrid.inl>
+#include <PDPC/SpacePartitioning/HashGrid.hpp>
@@ -0,0 +1,48 @@
+#include <PDPC/SpacePartitioning/HashGrid.h>
+#include <PDPC/SpacePartitioning/internal/NeighborVisitor.h>
+
+namespace pdpc {
+
+// Visitor Query ---------------------------------------------------------------
+
+template<class VisitorT>
+bool HashGrid::for_each_in_range(const Vector3& point, Scalar r, VisitorT&& f) const
+{
+    return this->visit_range(point, r, -1, f);
+}
+
+template<class VisitorT>
+bool HashGrid::for_each_in_range(Index index, Scalar r, VisitorT&& f) const
+{
+    return this->visit_range(this->point_data()[index], r, index, f);
+}
+
+template<class VisitorT>
+bool HashGrid::visit_range(const Vector3& point, Scalar r, Index excluded, VisitorT& f) const
+{
+    Vector3i first, last;
+    if(!this->cell_range(point, r, first, last)) return true;
+
+    const Scalar squared_radius = r * r;
+    for(int x=first.x(); x<=last.x(); ++x)
+    {
+        for(int y=first.y(); y<=last.y(); ++y)
+        {
+            Index start, end;
+            if(!this->row_range(point, r, x, y, first.z(), last.z(), start, end)) continue;
+
+            for(Index pos=start; pos<end; ++pos)
+            {
+                const Scalar d2 = (point - m_cell_points[pos]).squaredNorm();
+                if(d2 < squared_radius && m_indices[pos] != excluded)
+                {
+                    if(!internal::visit_neighbor(f, m_indices[pos], d2))
+                        return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace pdpc
@@ -0,0 +1,65 @@
+#include <PDPC/SpacePartitioning/HashGrid.h>
+#include <PDPC/Common/Assert.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace pdpc {
+
+// Internal --------------------------------------------------------------------
+
+std::uint64_t HashGrid::cell_hash(std::uint64_t key)
+{
+    const std::uint64_t h = key * 0x9E3779B97F4A7C15ull;
+    return h ^ (h >> 32);
+}
+
+Index HashGrid::find_cell(std::uint64_t key) const
+{
+    PDPC_DEBUG_ASSERT(!m_table.empty());
+
+    // the table is at most half full so that the probes are short
+    const std::uint64_t mask = m_table.size() - 1;
+    for(std::uint64_t slot = cell_hash(key) & mask; ; slot = (slot + 1) & mask)
+    {
+        const Index c = m_table[slot];
+        if(c < 0 || m_cell_keys[c] == key) return c;
+    }
+}
+
+bool HashGrid::row_range(const Vector3& point, Scalar r, int x, int y, int first_z, int last_z, Index& start, Index& end) const
+{
+    // distance to the row in cell units, with the margin of cell_range()
+    const Vector3 c  = (point - m_grid.origin) / m_grid.cell_size;
+    const Scalar  mr = (r + r * Scalar(1e-5)) / m_grid.cell_size;
+    const Scalar  dx = std::max({Scalar(x) - c.x(), c.x() - Scalar(x+1), Scalar(0)});
+    const Scalar  dy = std::max({Scalar(y) - c.y(), c.y() - Scalar(y+1), Scalar(0)});
+    const Scalar  h2 = mr * mr - dx * dx - dy * dy;
+    if(h2 < 0) return false;
+
+    // cells of the row intersecting the ball
+    const Scalar h  = std::sqrt(h2);
+    const Scalar lo = c.z() - h;
+    const Scalar hi = c.z() + h;
+    if(hi < first_z) return false;
+    if(lo > first_z) first_z = int(lo);
+    if(hi < last_z)  last_z  = int(hi);
+
+    Index first_cell = -1;
+    for(int z=first_z; z<=last_z && first_cell < 0; ++z)
+        first_cell = this->find_cell(internal::CellGrid::key(x, y, z));
+    if(first_cell < 0) return false;
+
+    // the next cells of the row have the next keys
+    const std::uint64_t last_key = internal::CellGrid::key(x, y, last_z);
+    const Index cell_count = m_cell_keys.size();
+    Index last_cell = first_cell;
+    while(last_cell + 1 < cell_count && m_cell_keys[last_cell+1] <= last_key)
+        ++last_cell;
+
+    start = m_cell_starts[first_cell];
+    end   = m_cell_starts[last_cell+1];
+    return true;
+}
+
+} // namespace pdpc
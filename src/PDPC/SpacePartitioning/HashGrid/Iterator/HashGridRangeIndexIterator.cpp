@@ -0,0 +1,53 @@
+#include <PDPC/SpacePartitioning/HashGrid/Iterator/HashGridRangeIndexIterator.h>
+#include <PDPC/SpacePartitioning/HashGrid/Query/HashGridRangeIndexQuery.h>
+
+namespace pdpc {
+
+HashGridRangeIndexIterator::HashGridRangeIndexIterator() :
+    m_query(nullptr),
+    m_index(-1),
+    m_start(0),
+    m_end(0),
+    m_squared_distance(0)
+{
+}
+
+HashGridRangeIndexIterator::HashGridRangeIndexIterator(HashGridRangeIndexQuery* query) :
+    m_query(query),
+    m_index(-1),
+    m_start(0),
+    m_end(0),
+    m_squared_distance(0)
+{
+}
+
+HashGridRangeIndexIterator::HashGridRangeIndexIterator(HashGridRangeIndexQuery* query, Index index) :
+    m_query(query),
+    m_index(index),
+    m_start(0),
+    m_end(0),
+    m_squared_distance(0)
+{
+}
+
+bool HashGridRangeIndexIterator::operator !=(const HashGridRangeIndexIterator& other) const
+{
+    return m_index != other.m_index;
+}
+
+void HashGridRangeIndexIterator::operator ++()
+{
+    m_query->advance(*this);
+}
+
+Index HashGridRangeIndexIterator::operator * () const
+{
+    return m_index;
+}
+
+Scalar HashGridRangeIndexIterator::squared_distance() const
+{
+    return m_squared_distance;
+}
+
+} // namespace pdpc
@@ -0,0 +1,53 @@
+#include <PDPC/SpacePartitioning/HashGrid/Iterator/HashGridRangePointIterator.h>
+#include <PDPC/SpacePartitioning/HashGrid/Query/HashGridRangePointQuery.h>
+
+namespace pdpc {
+
+HashGridRangePointIterator::HashGridRangePointIterator() :
+    m_query(nullptr),
+    m_index(-1),
+    m_start(0),
+    m_end(0),
+    m_squared_distance(0)
+{
+}
+
+HashGridRangePointIterator::HashGridRangePointIterator(HashGridRangePointQuery* query) :
+    m_query(query),
+    m_index(-1),
+    m_start(0),
+    m_end(0),
+    m_squared_distance(0)
+{
+}
+
+HashGridRangePointIterator::HashGridRangePointIterator(HashGridRangePointQuery* query, Index index) :
+    m_query(query),
+    m_index(index),
+    m_start(0),
+    m_end(0),
+    m_squared_distance(0)
+{
+}
+
+bool HashGridRangePointIterator::operator !=(const HashGridRangePointIterator& other) const
+{
+    return m_index != other.m_index;
+}
+
+void HashGridRangePointIterator::operator ++()
+{
+    m_query->advance(*this);
+}
+
+Index HashGridRangePointIterator::operator * () const
+{
+    return m_index;
+}
+
+Scalar HashGridRangePointIterator::squared_distance() const
+{
+    return m_squared_distance;
+}
+
+} // namespace pdpc
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+
+namespace pdpc {
+
+class HashGridRangePointQuery;
+
+class HashGridRangePointIterator
+{
+protected:
+    friend class HashGridRangePointQuery;
+
+public:
+    HashGridRangePointIterator();
+    HashGridRangePointIterator(HashGridRangePointQuery* query);
+    HashGridRangePointIterator(HashGridRangePointQuery* query, Index index);
+
+public:
+    bool operator !=(const HashGridRangePointIterator& other) const;
+    void operator ++();
+    Index operator * () const;
+
+    //! \brief squared_distance returns the squared distance of the current neighbor to the query
+    Scalar squared_distance() const;
+
+protected:
+    HashGridRangePointQuery* m_query;
+    Index  m_index;
+    Index  m_start; //!< position of the next point of the current row
+    Index  m_end;
+    Scalar m_squared_distance;
+};
+
+} // namespace pdpc
@@ -0,0 +1,52 @@
+#include <PDPC/SpacePartitioning/HashGrid/Query/HashGridQuery.h>
+#include <PDPC/SpacePartitioning/HashGrid.h>
+
+namespace pdpc {
+
+HashGridQuery::HashGridQuery() :
+    m_grid(nullptr),
+    m_center(Vector3::Zero()),
+    m_radius(0),
+    m_first(Vector3i::Zero()),
+    m_last(-Vector3i::Ones()),
+    m_x(0),
+    m_y(0)
+{
+}
+
+HashGridQuery::HashGridQuery(const HashGrid* grid) :
+    m_grid(grid),
+    m_center(Vector3::Zero()),
+    m_radius(0),
+    m_first(Vector3i::Zero()),
+    m_last(-Vector3i::Ones()),
+    m_x(0),
+    m_y(0)
+{
+}
+
+void HashGridQuery::initialize_rows(const Vector3& point, Scalar r)
+{
+    m_center  = point;
+    m_radius = r;
+    m_grid->cell_range(point, r, m_first, m_last);
+    m_x = m_first.x();
+    m_y = m_first.y();
+}
+
+bool HashGridQuery::next_row(Index& start, Index& end)
+{
+    while(m_x <= m_last.x() && m_y <= m_last.y())
+    {
+        const bool found = m_grid->row_range(m_center, m_radius, m_x, m_y, m_first.z(), m_last.z(), start, end);
+        if(++m_y > m_last.y())
+        {
+            m_y = m_first.y();
+            ++m_x;
+        }
+        if(found) return true;
+    }
+    return false;
+}
+
+} // namespace pdpc
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+
+namespace pdpc {
+
+class HashGrid;
+
+class HashGridQuery
+{
+public:
+    HashGridQuery();
+    HashGridQuery(const HashGrid* grid);
+
+protected:
+    //! \brief initialize_rows starts the rows of the cells intersecting the ball
+    void initialize_rows(const Vector3& point, Scalar r);
+
+    //! \brief next_row gives the positions of the points of the next non-empty row, returns false after the last one
+    bool next_row(Index& start, Index& end);
+
+protected:
+    const HashGrid* m_grid;
+    Vector3         m_center; //!< center of the ball
+    Scalar          m_radius;
+    Vector3i        m_first; //!< first cell of the stencil
+    Vector3i        m_last;  //!< last cell of the stencil (included)
+    int             m_x;     //!< current row
+    int             m_y;
+};
+
+} // namespace pdpc
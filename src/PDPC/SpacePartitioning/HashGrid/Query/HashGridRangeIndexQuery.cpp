@@ -0,0 +1,78 @@
+#include <PDPC/SpacePartitioning/HashGrid/Query/HashGridRangeIndexQuery.h>
+#include <PDPC/SpacePartitioning/HashGrid.h>
+
+namespace pdpc {
+
+HashGridRangeIndexQuery::HashGridRangeIndexQuery() :
+    HashGridQuery(),
+    RangeIndexQuery()
+{
+}
+
+HashGridRangeIndexQuery::HashGridRangeIndexQuery(const HashGrid* grid) :
+    HashGridQuery(grid),
+    RangeIndexQuery()
+{
+}
+
+HashGridRangeIndexQuery::HashGridRangeIndexQuery(const HashGrid* grid, Scalar radius) :
+    HashGridQuery(grid),
+    RangeIndexQuery(radius)
+{
+}
+
+HashGridRangeIndexQuery::HashGridRangeIndexQuery(const HashGrid* grid, Scalar radius, Index index) :
+    HashGridQuery(grid),
+    RangeIndexQuery(radius, index)
+{
+}
+
+HashGridRangeIndexIterator HashGridRangeIndexQuery::begin()
+{
+    HashGridRangeIndexIterator it(this);
+    this->initialize(it);
+    this->advance(it);
+    return it;
+}
+
+HashGridRangeIndexIterator HashGridRangeIndexQuery::end()
+{
+    return HashGridRangeIndexIterator(this, m_grid->point_count());
+}
+
+void HashGridRangeIndexQuery::initialize(HashGridRangeIndexIterator& it)
+{
+    this->initialize_rows(m_grid->point_data()[m_index], this->radius());
+    it.m_index = -1;
+    it.m_start = 0;
+    it.m_end   = 0;
+    it.m_squared_distance = 0;
+}
+
+void HashGridRangeIndexQuery::advance(HashGridRangeIndexIterator& it)
+{
+    const auto& points  = m_grid->cell_point_data();
+    const auto& indices = m_grid->index_data();
+    const auto& point   = m_grid->point_data()[m_index];
+
+    while(true)
+    {
+        // remaining points of the current row
+        while(it.m_start < it.m_end)
+        {
+            const Index  pos = it.m_start++;
+            const Scalar d2  = (point - points[pos]).squaredNorm();
+            if(d2 < m_squared_radius && indices[pos] != m_index)
+            {
+                it.m_index = indices[pos];
+                it.m_squared_distance = d2;
+                return;
+            }
+        }
+
+        if(!this->next_row(it.m_start, it.m_end)) break;
+    }
+    it.m_index = m_grid->point_count();
+}
+
+} // namespace pdpc
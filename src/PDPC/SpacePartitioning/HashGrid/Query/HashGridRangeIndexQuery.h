@@ -0,0 +1,30 @@
+#pragma once
+
+#include <PDPC/SpacePartitioning/Query/RangeIndexQuery.h>
+#include <PDPC/SpacePartitioning/HashGrid/Query/HashGridQuery.h>
+#include <PDPC/SpacePartitioning/HashGrid/Iterator/HashGridRangeIndexIterator.h>
+
+namespace pdpc {
+
+class HashGridRangeIndexQuery : public HashGridQuery,
+                                public RangeIndexQuery
+{
+protected:
+    friend class HashGridRangeIndexIterator;
+
+public:
+    HashGridRangeIndexQuery();
+    HashGridRangeIndexQuery(const HashGrid* grid);
+    HashGridRangeIndexQuery(const HashGrid* grid, Scalar radius);
+    HashGridRangeIndexQuery(const HashGrid* grid, Scalar radius, Index index);
+
+public:
+    HashGridRangeIndexIterator begin();
+    HashGridRangeIndexIterator end();
+
+protected:
+    void initialize(HashGridRangeIndexIterator& iterator);
+    void advance(HashGridRangeIndexIterator& iterator);
+};
+
+} // namespace pdpc
@@ -0,0 +1,77 @@
+#include <PDPC/SpacePartitioning/HashGrid/Query/HashGridRangePointQuery.h>
+#include <PDPC/SpacePartitioning/HashGrid.h>
+
+namespace pdpc {
+
+HashGridRangePointQuery::HashGridRangePointQuery() :
+    HashGridQuery(),
+    RangePointQuery()
+{
+}
+
+HashGridRangePointQuery::HashGridRangePointQuery(const HashGrid* grid) :
+    HashGridQuery(grid),
+    RangePointQuery()
+{
+}
+
+HashGridRangePointQuery::HashGridRangePointQuery(const HashGrid* grid, Scalar radius) :
+    HashGridQuery(grid),
+    RangePointQuery(radius)
+{
+}
+
+HashGridRangePointQuery::HashGridRangePointQuery(const HashGrid* grid, Scalar radius, const Vector3& point) :
+    HashGridQuery(grid),
+    RangePointQuery(radius, point)
+{
+}
+
+HashGridRangePointIterator HashGridRangePointQuery::begin()
+{
+    HashGridRangePointIterator it(this);
+    this->initialize(it);
+    this->advance(it);
+    return it;
+}
+
+HashGridRangePointIterator HashGridRangePointQuery::end()
+{
+    return HashGridRangePointIterator(this, m_grid->point_count());
+}
+
+void HashGridRangePointQuery::initialize(HashGridRangePointIterator& it)
+{
+    this->initialize_rows(m_point, this->radius());
+    it.m_index = -1;
+    it.m_start = 0;
+    it.m_end   = 0;
+    it.m_squared_distance = 0;
+}
+
+void HashGridRangePointQuery::advance(HashGridRangePointIterator& it)
+{
+    const auto& points  = m_grid->cell_point_data();
+    const auto& indices = m_grid->index_data();
+
+    while(true)
+    {
+        // remaining points of the current row
+        while(it.m_start < it.m_end)
+        {
+            const Index  pos = it.m_start++;
+            const Scalar d2  = (m_point - points[pos]).squaredNorm();
+            if(d2 < m_squared_radius)
+            {
+                it.m_index = indices[pos];
+                it.m_squared_distance = d2;
+                return;
+            }
+        }
+
+        if(!this->next_row(it.m_start, it.m_end)) break;
+    }
+    it.m_index = m_grid->point_count();
+}
+
+} // namespace pdpc
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <PDPC/SpacePartitioning/Query/RangePointQuery.h>
+#include <PDPC/SpacePartitioning/HashGrid/Query/HashGridQuery.h>
+#include <PDPC/SpacePartitioning/HashGrid/Iterator/HashGridRangePointIterator.h>
+
+namespace pdpc {
+
+class HashGridRangePointQuery : public HashGridQuery,
+                                public RangePointQuery
+{
+protected:
+    friend class HashGridRangePointIterator;
+
+public:
+    HashGridRangePointQuery();
+    HashGridRangePointQuery(const HashGrid* grid);
+    HashGridRangePointQuery(const HashGrid* grid, Scalar radius);
+    HashGridRangePointQuery(const HashGrid* grid, Scalar radius, const Vector3& point);
+
+public:
+    HashGridRangePointIterator begin();
+    HashGridRangePointIterator end();
+
+protected:
+    void initialize(HashGridRangePointIterator& iterator);
+    void advance(HashGridRangePointIterator& iterator);
+};
+
+} // namespace pdpc
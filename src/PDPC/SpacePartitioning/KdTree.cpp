@@ -1,15 +1,101 @@
 #include <PDPC/SpacePartitioning/KdTree.h>
+#include <PDPC/SpacePartitioning/internal/BatchQuery.h>
+#include <PDPC/Common/Progress.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <numeric>
 
 namespace pdpc {
 
+namespace {
+
+//!
+//! \brief set_leaf makes node the leaf of the indices [start, end)
+//!
+//! A range that reaches PDPC_KDTREE_MAX_DEPTH (e.g. many equal points) can be
+//! larger than the leaf size field of KdTreeNode.
+//!
+void set_leaf(KdTreeNode& node, Index start, Index end)
+{
+    PDPC_ASSERT_MSG(start >= 0 && start <= end && std::size_t(end - start) <= KdTreeNode::max_id(),
+                    "kd-tree leaf too large, build with PDPC_INDEX_64");
+    node.leaf  = 1;
+    node.start = start;
+    node.size  = end - start;
+}
+
+//!
+//! \brief The AllKnnSeed struct is the closest solved point (parent) of
+//! KdTree::all_knn that has a point to solve among its neighbors
+//!
+struct AllKnnSeed
+{
+    Scalar squared_distance; //!< between the two points
+    Index  parent;
+};
+
+//!
+//! \brief select_nearest keeps the k closest hits, sorted by increasing distance
+//!
+//! The hits are closer than bound: they are counted in as many buckets of
+//! squared distance as hits, then only the buckets up to the k-th hit are
+//! gathered and sorted, which is linear as they hold a few hits each.
+//!
+void select_nearest(std::vector<IndexSquaredDistance>& hits, int k, Scalar bound,
+                    std::vector<int>& starts, std::vector<IndexSquaredDistance>& sorted)
+{
+    const int count = hits.size();
+
+    const auto bucket = [count,bound](Scalar squared_distance)
+    {
+        return std::min(int(squared_distance / bound * count), count - 1);
+    };
+
+    starts.assign(count + 1, 0);
+    for(const IndexSquaredDistance& hit : hits)
+        ++starts[bucket(hit.squared_distance) + 1];
+
+    // the buckets [0,last] hold at least k hits
+    int last = 0;
+    for(int sum = starts[1]; sum < k; sum += starts[last+1])
+        ++last;
+    for(int b=0; b<=last; ++b)
+        starts[b+1] += starts[b];
+
+    sorted.resize(starts[last+1]);
+    for(const IndexSquaredDistance& hit : hits)
+    {
+        const int b = bucket(hit.squared_distance);
+        if(b <= last) sorted[starts[b]++] = hit;
+    }
+
+    for(int i=1; i<int(sorted.size()); ++i)
+    {
+        const IndexSquaredDistance hit = sorted[i];
+        int j = i;
+        for(; j>0 && hit.squared_distance < sorted[j-1].squared_distance; --j)
+            sorted[j] = sorted[j-1];
+        sorted[j] = hit;
+    }
+
+    sorted.resize(k);
+    hits.swap(sorted);
+}
+
+} // namespace
+
 // KdTree ----------------------------------------------------------------------
 
 KdTree::KdTree() :
     m_points(nullptr),
     m_nodes(nullptr),
     m_indices(nullptr),
+    m_levels(nullptr),
+    m_node_levels(nullptr),
+    m_leaf_points(nullptr),
+    m_leaf_stride(0),
     m_min_cell_size(64)
 {
 }
@@ -18,15 +104,23 @@ KdTree::KdTree(std::shared_ptr<Vector3Array>& points) :
     m_points(nullptr),
     m_nodes(nullptr),
     m_indices(nullptr),
+    m_levels(nullptr),
+    m_node_levels(nullptr),
+    m_leaf_points(nullptr),
+    m_leaf_stride(0),
     m_min_cell_size(64)
 {
     this->build(points);
 }
 
-KdTree::KdTree(std::shared_ptr<Vector3Array>& points, const std::vector<int>& sampling) :
+KdTree::KdTree(std::shared_ptr<Vector3Array>& points, const std::vector<Index>& sampling) :
     m_points(nullptr),
     m_nodes(nullptr),
     m_indices(nullptr),
+    m_levels(nullptr),
+    m_node_levels(nullptr),
+    m_leaf_points(nullptr),
+    m_leaf_stride(0),
     m_min_cell_size(64)
 {
     this->build(points, sampling);
@@ -37,6 +131,9 @@ void KdTree::clear()
     m_points  = nullptr;
     m_nodes   = nullptr;
     m_indices = nullptr;
+    m_leaf_points = nullptr;
+    m_leaf_stride = 0;
+    this->clear_levels();
 }
 
 bool KdTree::valid() const
@@ -57,9 +154,9 @@ bool KdTree::valid() const
     }
 
     std::vector<bool> b(m_points->size(), false);
-    for(int idx : *m_indices.get())
+    for(Index idx : *m_indices.get())
     {
-        if(idx < 0 || int(m_points->size()) <= idx || b[idx])
+        if(idx < 0 || Index(m_points->size()) <= idx || b[idx])
         {
             PDPC_DEBUG_ASSERT(false);
             return false;
@@ -112,7 +209,7 @@ std::string KdTree::to_string() const
         const KdTreeNode& node = m_nodes->operator[](n);
         if(node.leaf)
         {
-            int end = node.start + node.size;
+            Index end = node.start + node.size;
             str << "  leaf: start=" << node.start << " end=" << end << " (size=" << node.size << ")\n";
         }
         else
@@ -131,18 +228,20 @@ void KdTree::build(std::shared_ptr<Vector3Array>& points)
 
     m_nodes = std::make_shared<std::vector<KdTreeNode>>();
     m_nodes->reserve(4 * m_points->size() / m_min_cell_size);
-    m_nodes->emplace_back();
-    m_nodes->back().leaf = false;
 
-    m_indices = std::make_shared<std::vector<int>>(m_points->size());
+    PDPC_ASSERT_MSG(m_points->size() <= std::size_t(std::numeric_limits<Index>::max()),
+                    "too many points for the kd-tree indices, build with PDPC_INDEX_64");
+
+    m_indices = std::make_shared<std::vector<Index>>(m_points->size());
     std::iota(m_indices->begin(), m_indices->end(), 0);
 
-    this->build_rec(0, 0, m_points->size(), 1);
+    this->build_root();
+    this->build_leaf_points();
 
     PDPC_DEBUG_ASSERT(this->valid());
 }
 
-void KdTree::build(std::shared_ptr<Vector3Array>& points, const std::vector<int>& sampling)
+void KdTree::build(std::shared_ptr<Vector3Array>& points, const std::vector<Index>& sampling)
 {
     this->clear();
 
@@ -150,27 +249,25 @@ void KdTree::build(std::shared_ptr<Vector3Array>& points, const std::vector<int>
 
     m_nodes = std::make_shared<std::vector<KdTreeNode>>();
     m_nodes->reserve(4 * m_points->size() / m_min_cell_size);
-    m_nodes->emplace_back();
-    m_nodes->back().leaf = false;
 
-    m_indices = std::make_shared<std::vector<int>>(sampling);
+    m_indices = std::make_shared<std::vector<Index>>(sampling);
 
-    this->build_rec(0, 0, m_indices->size(), 1);
+    this->build_root();
+    this->build_leaf_points();
 
     PDPC_DEBUG_ASSERT(this->valid());
 }
 
-void KdTree::rebuild(const std::vector<int>& sampling)
+void KdTree::rebuild(const std::vector<Index>& sampling)
 {
     PDPC_DEBUG_ASSERT(sampling.size() <= m_points->size());
 
-    m_nodes->clear();
-    m_nodes->emplace_back();
-    m_nodes->back().leaf = false;
+    this->clear_levels();
 
     *m_indices = sampling;
 
-    this->build_rec(0, 0, m_indices->size(), 1);
+    this->build_root();
+    this->build_leaf_points();
 
     PDPC_DEBUG_ASSERT(this->valid());
 }
@@ -182,7 +279,7 @@ KdTreeKNearestPointQuery KdTree::k_nearest_neighbors(const Vector3& point, int k
     return KNearestPointQuery(this, k, point);
 }
 
-KdTreeKNearestIndexQuery KdTree::k_nearest_neighbors(int index, int k) const
+KdTreeKNearestIndexQuery KdTree::k_nearest_neighbors(Index index, int k) const
 {
     return KNearestIndexQuery(this, k, index);
 }
@@ -192,7 +289,7 @@ KdTreeNearestPointQuery KdTree::nearest_neighbor(const Vector3& point) const
     return NearestPointQuery(this, point);
 }
 
-KdTreeNearestIndexQuery KdTree::nearest_neighbor(int index) const
+KdTreeNearestIndexQuery KdTree::nearest_neighbor(Index index) const
 {
     return NearestIndexQuery(this, index);
 }
@@ -202,7 +299,7 @@ KdTreeRangePointQuery KdTree::range_neighbors(const Vector3& point, Scalar r) co
     return RangePointQuery(this, r, point);
 }
 
-KdTreeRangeIndexQuery KdTree::range_neighbors(int index, Scalar r) const
+KdTreeRangeIndexQuery KdTree::range_neighbors(Index index, Scalar r) const
 {
     return RangeIndexQuery(this, r, index);
 }
@@ -239,19 +336,287 @@ KdTreeRangeIndexQuery KdTree::range_index_query(Scalar r) const
     return RangeIndexQuery(this, r);
 }
 
+// Batch Query -----------------------------------------------------------------
+
+NeighborLists KdTree::batch_range(const std::vector<Index>& indices, Scalar r,
+                                  bool squared_distances, bool verbose) const
+{
+    NeighborLists lists;
+    internal::batch_query(indices.size(), squared_distances, verbose,
+    [this,r]()
+    {
+        return this->range_index_query(r);
+    },
+    [&indices,squared_distances](RangeIndexQuery& query, Index q, std::vector<Index>& neighbors, std::vector<Scalar>& distances)
+    {
+        query.set_index(indices[q]);
+        for(auto it=query.begin(); it!=query.end(); ++it)
+        {
+            neighbors.push_back(*it);
+            if(squared_distances) distances.push_back(it.squared_distance());
+        }
+    },
+    lists);
+    return lists;
+}
+
+NeighborLists KdTree::batch_knn(const std::vector<Index>& indices, int k,
+                                bool squared_distances, bool verbose) const
+{
+    NeighborLists lists;
+    internal::batch_query(indices.size(), squared_distances, verbose,
+    [this,k]()
+    {
+        return this->k_nearest_index_query(k);
+    },
+    [&indices,squared_distances](KNearestIndexQuery& query, Index q, std::vector<Index>& neighbors, std::vector<Scalar>& distances)
+    {
+        query.set_index(indices[q]);
+        for(const IndexSquaredDistance& neighbor : query.search())
+        {
+            if(neighbor.index < 0) continue;
+            neighbors.push_back(neighbor.index);
+            if(squared_distances) distances.push_back(neighbor.squared_distance);
+        }
+    },
+    lists);
+    return lists;
+}
+
+NeighborLists KdTree::all_knn(int k, bool squared_distances, bool verbose) const
+{
+    const auto& indices = this->index_data();
+    const Index query_count = indices.size();
+
+    // every point has the same neighbor count as all the points are candidates
+    const int count = int(std::max(Index(0), std::min(Index(k), query_count - 1)));
+
+    NeighborLists lists;
+    auto& offsets = lists.offset_data();
+    offsets.resize(query_count + 1);
+    for(Index q=0; q<=query_count; ++q)
+        offsets[q] = std::size_t(q) * count;
+
+    // the neighbors are stored as positions in index_data(), close to each
+    // other in memory, and replaced by their indices at the end
+    auto& neighbor_data = lists.index_data();
+    auto& distance_data = lists.squared_distance_data();
+    neighbor_data.resize(offsets.back());
+    distance_data.resize(squared_distances ? offsets.back() : 0);
+
+    std::vector<Index> positions(this->point_count(), -1);
+    #pragma omp parallel for
+    for(Index q=0; q<query_count; ++q)
+        positions[indices[q]] = q;
+
+    const Scalar* x = this->leaf_x();
+    const Scalar* y = this->leaf_y();
+    const Scalar* z = this->leaf_z();
+
+    constexpr int block_size = 256;
+    const Index block_count = (query_count + block_size - 1) / block_size;
+
+    auto prog = Progress(query_count, verbose);
+    #pragma omp parallel
+    {
+        auto query = this->k_nearest_index_query(k);
+        std::vector<IndexSquaredDistance> hits;
+        std::vector<IndexSquaredDistance> sorted;
+        std::vector<int>        starts;
+        std::vector<Scalar>     seeds;
+        std::vector<AllKnnSeed> best;
+
+        #pragma omp for schedule(dynamic)
+        for(Index b=0; b<block_count; ++b)
+        {
+            const Index begin = b * block_size;
+            const Index end   = std::min(query_count, begin + block_size);
+            best.assign(end - begin, {std::numeric_limits<Scalar>::max(), -1});
+
+            for(Index q=begin; q<end; ++q)
+            {
+                const AllKnnSeed& seed = best[q - begin];
+
+                hits.clear();
+                if(seed.parent >= 0)
+                {
+                    // the parent and its neighbors, q excluded, are k points
+                    // whose k-th distance to q bounds the one of q
+                    const Vector3 point(x[q], y[q], z[q]);
+                    const Index*  parent_neighbors = neighbor_data.data() + offsets[seed.parent];
+
+                    seeds.clear();
+                    seeds.push_back(seed.squared_distance);
+                    for(int i=0; i<k; ++i)
+                    {
+                        const Index j = parent_neighbors[i];
+                        if(j != q)
+                            seeds.push_back((Vector3(x[j], y[j], z[j]) - point).squaredNorm());
+                    }
+                    std::nth_element(seeds.begin(), seeds.begin() + (k-1), seeds.end());
+
+                    // the hits are strictly closer than the bound, which must keep the seeds
+                    const Scalar bound = std::nextafter(seeds[k-1], std::numeric_limits<Scalar>::max());
+
+                    auto visitor = [&hits,q](Index j, Scalar squared_distance)
+                    {
+                        if(j != q) hits.push_back({j, squared_distance});
+                    };
+                    this->visit_positions(point, bound, visitor, 0);
+
+                    // less hits only come from non-finite coordinates
+                    if(int(hits.size()) >= k)
+                        select_nearest(hits, k, bound, starts, sorted);
+                    else
+                        hits.clear();
+                }
+                if(hits.empty())
+                {
+                    query.set_index(indices[q]);
+                    for(const IndexSquaredDistance& neighbor : query.search())
+                    {
+                        if(neighbor.index >= 0)
+                            hits.push_back({positions[neighbor.index], neighbor.squared_distance});
+                    }
+                }
+
+                // q seeds its neighbors of the block that are not solved yet
+                for(int i=0; i<count; ++i)
+                {
+                    const Index j = hits[i].index;
+                    neighbor_data[offsets[q] + i] = j;
+                    if(squared_distances) distance_data[offsets[q] + i] = hits[i].squared_distance;
+
+                    if(count == k && j > q && j < end && hits[i].squared_distance < best[j - begin].squared_distance)
+                        best[j - begin] = {hits[i].squared_distance, q};
+                }
+                ++prog;
+            }
+        }
+    }
+
+    #pragma omp parallel for
+    for(std::size_t n=0; n<neighbor_data.size(); ++n)
+        neighbor_data[n] = indices[neighbor_data[n]];
+
+    return lists;
+}
+
+// Levels ----------------------------------------------------------------------
+
+void KdTree::build_levels(const std::vector<int>& point_levels)
+{
+    PDPC_DEBUG_ASSERT(Index(point_levels.size()) == this->point_count());
+
+    auto& nodes   = *m_nodes.get();
+    auto& indices = *m_indices.get();
+    const Index node_count  = nodes.size();
+    const Index index_count = indices.size();
+
+    m_levels      = std::make_shared<std::vector<int>>(index_count);
+    m_node_levels = std::make_shared<std::vector<int>>(node_count, 0);
+    auto& levels      = *m_levels.get();
+    auto& node_levels = *m_node_levels.get();
+
+    // sort the leaves by decreasing level (then by index for reproducibility)
+    #pragma omp parallel for schedule(dynamic,256)
+    for(Index n=0; n<node_count; ++n)
+    {
+        const KdTreeNode& node = nodes[n];
+        if(!node.leaf || node.size == 0) continue;
+
+        const Index start = node.start;
+        const Index end   = node.start + node.size;
+        std::sort(indices.begin()+start, indices.begin()+end, [&](Index i, Index j)
+        {
+            return point_levels[i] > point_levels[j] || (point_levels[i] == point_levels[j] && i < j);
+        });
+        for(Index i=start; i<end; ++i)
+            levels[i] = point_levels[indices[i]];
+        node_levels[n] = levels[start];
+    }
+
+    // children are always stored after their parent
+    for(Index n=node_count-1; n>=0; --n)
+    {
+        const KdTreeNode& node = nodes[n];
+        if(!node.leaf)
+        {
+            node_levels[n] = std::max(node_levels[node.firstChildId],
+                                      node_levels[node.firstChildId+1]);
+        }
+    }
+
+    this->build_leaf_points();
+
+    PDPC_DEBUG_ASSERT(this->valid());
+}
+
+void KdTree::clear_levels()
+{
+    m_levels      = nullptr;
+    m_node_levels = nullptr;
+}
+
+bool KdTree::has_levels() const
+{
+    return m_levels != nullptr;
+}
+
+int KdTree::level_count() const
+{
+    return m_node_levels ? m_node_levels->front() + 1 : 1;
+}
+
+const std::vector<int>& KdTree::level_data() const
+{
+    return *m_levels.get();
+}
+
+const std::vector<int>& KdTree::node_level_data() const
+{
+    return *m_node_levels.get();
+}
+
+// Leaf points -----------------------------------------------------------------
+
+void KdTree::build_leaf_points()
+{
+    const auto& points  = *m_points.get();
+    const auto& indices = *m_indices.get();
+    const Index index_count = indices.size();
+
+    // each array is padded so that the kernels can load full vectors
+    m_leaf_stride = (index_count + leaf_padding() - 1) / leaf_padding() * leaf_padding() + leaf_padding();
+    m_leaf_points = std::make_shared<std::vector<Scalar>>(3 * std::size_t(m_leaf_stride), Scalar(0));
+
+    Scalar* xs = m_leaf_points->data();
+    Scalar* ys = xs + m_leaf_stride;
+    Scalar* zs = ys + m_leaf_stride;
+
+    #pragma omp parallel for
+    for(Index i=0; i<index_count; ++i)
+    {
+        const Vector3& p = points[indices[i]];
+        xs[i] = p.x();
+        ys[i] = p.y();
+        zs[i] = p.z();
+    }
+}
+
 // Accessors -------------------------------------------------------------------
 
-int KdTree::node_count() const
+Index KdTree::node_count() const
 {
     return m_nodes->size();
 }
 
-int KdTree::index_count() const
+Index KdTree::index_count() const
 {
     return m_indices->size();
 }
 
-int KdTree::point_count() const
+Index KdTree::point_count() const
 {
     return m_points->size();
 }
@@ -286,12 +651,12 @@ std::vector<KdTreeNode>& KdTree::node_data()
     return *m_nodes.get();
 }
 
-const std::vector<int>& KdTree::index_data() const
+const std::vector<Index>& KdTree::index_data() const
 {
     return *m_indices.get();
 }
 
-std::vector<int>& KdTree::index_data()
+std::vector<Index>& KdTree::index_data()
 {
     return *m_indices.get();
 }
@@ -310,15 +675,121 @@ void KdTree::set_min_cell_size(int min_cell_size)
 
 // Internal --------------------------------------------------------------------
 
-void KdTree::build_rec(int node_id, int start, int end, int level)
+void KdTree::build_root()
 {
     auto& nodes = *m_nodes.get();
+    nodes.clear();
+    nodes.emplace_back();
+    nodes.back().leaf = false;
+
+    const Index index_count = m_indices->size();
+    if(index_count <= parallel_size())
+    {
+        this->build_rec(nodes, 0, 0, index_count, 1);
+        return;
+    }
+
+    struct Range
+    {
+        Index node_id;
+        Index start;
+        Index end;
+        int level;
+    };
+
+    // 1. the large nodes are split with parallel passes, level by level
+    std::vector<Range> large(1, Range{0, 0, index_count, 1});
+    std::vector<Range> small;
+    while(!large.empty())
+    {
+        std::vector<Range> next;
+        for(const Range& range : large)
+        {
+            const Aabb aabb = this->bounding_box(range.start, range.end);
+
+            Vector3 diag = Scalar(0.5)*(aabb.max()-aabb.min());
+            int dim;
+            diag.maxCoeff(&dim);
+
+            const Scalar split = aabb.center()(dim);
+            const Index  mid   = this->parallel_partition(range.start, range.end, dim, split);
+
+            const Index child_id = nodes.size();
+            PDPC_ASSERT_MSG(std::size_t(child_id) + 1 <= KdTreeNode::max_id(),
+                            "too many kd-tree nodes, build with PDPC_INDEX_64");
+            nodes[range.node_id].dim          = dim;
+            nodes[range.node_id].splitValue   = split;
+            nodes[range.node_id].firstChildId = child_id;
+
+            const Index starts[2] = {range.start, mid};
+            const Index ends[2]   = {mid, range.end};
+            for(int c=0; c<2; ++c)
+            {
+                KdTreeNode child;
+                child.size = 0;
+                if(ends[c]-starts[c] <= m_min_cell_size || range.level >= PDPC_KDTREE_MAX_DEPTH)
+                {
+                    set_leaf(child, starts[c], ends[c]);
+                }
+                else
+                {
+                    child.leaf = 0;
+                    const Range child_range{child_id+c, starts[c], ends[c], range.level+1};
+                    if(ends[c]-starts[c] > parallel_size())
+                        next.push_back(child_range);
+                    else
+                        small.push_back(child_range);
+                }
+                nodes.push_back(child);
+            }
+        }
+        large.swap(next);
+    }
+
+    // 2. the small nodes are built concurrently with their own nodes
+    const Index subtree_count = small.size();
+    std::vector<std::vector<KdTreeNode>> subtrees(subtree_count);
+
+    #pragma omp parallel for schedule(dynamic,1)
+    for(Index s=0; s<subtree_count; ++s)
+    {
+        subtrees[s].reserve(4 * (small[s].end - small[s].start) / std::max(1, m_min_cell_size));
+        subtrees[s].emplace_back();
+        subtrees[s].back().leaf = false;
+        this->build_rec(subtrees[s], 0, small[s].start, small[s].end, small[s].level);
+    }
+
+    // 3. the subtrees are appended in order, their root replaces the small node
+    std::size_t total_count = nodes.size();
+    for(const auto& subtree : subtrees)
+        total_count += subtree.size() - 1;
+    PDPC_ASSERT_MSG(total_count <= KdTreeNode::max_id(),
+                    "too many kd-tree nodes, build with PDPC_INDEX_64");
+
+    for(Index s=0; s<subtree_count; ++s)
+    {
+        const std::vector<KdTreeNode>& subtree = subtrees[s];
+        const Index offset = Index(nodes.size()) - 1;
+        auto shifted = [offset](KdTreeNode node)
+        {
+            if(!node.leaf) node.firstChildId += offset;
+            return node;
+        };
+
+        nodes[small[s].node_id] = shifted(subtree.front());
+        for(Index n=1; n<Index(subtree.size()); ++n)
+            nodes.push_back(shifted(subtree[n]));
+    }
+}
+
+void KdTree::build_rec(std::vector<KdTreeNode>& nodes, Index node_id, Index start, Index end, int level)
+{
     const auto& points  = *m_points.get();
     const auto& indices = *m_indices.get();
 
     KdTreeNode& node = nodes[node_id];
     Aabb aabb;
-    for(int i=start; i<end; ++i)
+    for(Index i=start; i<end; ++i)
         aabb.extend(points[indices[i]]);
 
     Vector3 diag = Scalar(0.5)*(aabb.max()-aabb.min());
@@ -328,7 +799,9 @@ void KdTree::build_rec(int node_id, int start, int end, int level)
     node.dim = dim;
     node.splitValue = aabb.center()(dim);
 
-    int midId = this->partition(start, end, dim, node.splitValue);
+    Index midId = this->partition(start, end, dim, node.splitValue);
+    PDPC_ASSERT_MSG(nodes.size() + 1 <= KdTreeNode::max_id(),
+                    "too many kd-tree nodes, build with PDPC_INDEX_64");
     node.firstChildId = nodes.size();
 
     {
@@ -339,48 +812,140 @@ void KdTree::build_rec(int node_id, int start, int end, int level)
     }
     {
         // left child
-        int childId = nodes[node_id].firstChildId;
+        Index childId = nodes[node_id].firstChildId;
         KdTreeNode& child = nodes[childId];
         if(midId-start <= m_min_cell_size || level >= PDPC_KDTREE_MAX_DEPTH)
         {
-            child.leaf = 1;
-            child.start = start;
-            child.size = midId-start;
+            set_leaf(child, start, midId);
         }
         else
         {
             child.leaf = 0;
-            this->build_rec(childId, start, midId, level+1);
+            this->build_rec(nodes, childId, start, midId, level+1);
         }
     }
     {
         // right child
-        int childId = nodes[node_id].firstChildId+1;
+        Index childId = nodes[node_id].firstChildId+1;
         KdTreeNode& child = nodes[childId];
         if(end-midId <= m_min_cell_size || level >= PDPC_KDTREE_MAX_DEPTH)
         {
-            child.leaf = 1;
-            child.start = midId;
-            child.size = end-midId;
+            set_leaf(child, midId, end);
         }
         else
         {
             child.leaf = 0;
-            this->build_rec(childId, midId, end, level+1);
+            this->build_rec(nodes, childId, midId, end, level+1);
         }
     }
 }
 
-int KdTree::partition(int start, int end, int dim, Scalar value)
+Index KdTree::partition(Index start, Index end, int dim, Scalar value)
 {
     const auto& points = *m_points.get();
     auto& indices  = *m_indices.get();
 
-    auto it = std::partition(indices.begin()+start, indices.begin()+end, [&](int i)
+    auto it = std::partition(indices.begin()+start, indices.begin()+end, [&](Index i)
     {
         return points[i][dim] < value;
     });
     return std::distance(m_indices->begin(), it);
 }
 
+Index KdTree::parallel_partition(Index start, Index end, int dim, Scalar value)
+{
+    const auto& points = *m_points.get();
+    auto& indices  = *m_indices.get();
+
+    // the chunks are partitioned concurrently, they do not depend on the thread count
+    constexpr Index chunk_size  = 1 << 14;
+    const Index   chunk_count = (end - start + chunk_size - 1) / chunk_size;
+
+    std::vector<Index> left_counts(chunk_count);
+
+    #pragma omp parallel for
+    for(Index c=0; c<chunk_count; ++c)
+    {
+        const Index chunk_begin = start + c * chunk_size;
+        const Index chunk_end   = std::min(end, chunk_begin + chunk_size);
+        auto it = std::partition(indices.begin()+chunk_begin, indices.begin()+chunk_end, [&](Index i)
+        {
+            return points[i][dim] < value;
+        });
+        left_counts[c] = std::distance(indices.begin()+chunk_begin, it);
+    }
+    const Index mid = start + std::accumulate(left_counts.begin(), left_counts.end(), Index(0));
+
+    // the right indices before mid are swapped with the left indices after mid
+    struct Interval
+    {
+        Index begin;
+        Index end;
+    };
+    std::vector<Interval> rights;
+    std::vector<Interval> lefts;
+    std::vector<Index> right_offsets(1, 0);
+    std::vector<Index> left_offsets(1, 0);
+    for(Index c=0; c<chunk_count; ++c)
+    {
+        const Index chunk_begin = start + c * chunk_size;
+        const Index chunk_end   = std::min(end, chunk_begin + chunk_size);
+        const Index chunk_mid   = chunk_begin + left_counts[c];
+        if(chunk_mid < std::min(chunk_end, mid))
+        {
+            rights.push_back(Interval{chunk_mid, std::min(chunk_end, mid)});
+            right_offsets.push_back(right_offsets.back() + rights.back().end - rights.back().begin);
+        }
+        if(std::max(chunk_begin, mid) < chunk_mid)
+        {
+            lefts.push_back(Interval{std::max(chunk_begin, mid), chunk_mid});
+            left_offsets.push_back(left_offsets.back() + lefts.back().end - lefts.back().begin);
+        }
+    }
+    PDPC_DEBUG_ASSERT(right_offsets.back() == left_offsets.back());
+
+    const Index swap_count  = right_offsets.back();
+    const Index block_count = (swap_count + chunk_size - 1) / chunk_size;
+
+    #pragma omp parallel for
+    for(Index b=0; b<block_count; ++b)
+    {
+        const Index begin = b * chunk_size;
+        const Index end   = std::min(swap_count, begin + chunk_size);
+
+        // intervals of the first swap of the block
+        Index r = std::distance(right_offsets.begin(), std::upper_bound(right_offsets.begin(), right_offsets.end(), begin)) - 1;
+        Index l = std::distance(left_offsets.begin(),  std::upper_bound(left_offsets.begin(),  left_offsets.end(),  begin)) - 1;
+        Index i = rights[r].begin + begin - right_offsets[r];
+        Index j = lefts[l].begin  + begin - left_offsets[l];
+        for(Index k=begin; k<end; ++k)
+        {
+            std::swap(indices[i], indices[j]);
+            if(++i == rights[r].end && r+1 < Index(rights.size())) i = rights[++r].begin;
+            if(++j == lefts[l].end  && l+1 < Index(lefts.size()))  j = lefts[++l].begin;
+        }
+    }
+
+    return mid;
+}
+
+Aabb KdTree::bounding_box(Index start, Index end) const
+{
+    const auto& points  = *m_points.get();
+    const auto& indices = *m_indices.get();
+
+    Aabb aabb;
+    #pragma omp parallel
+    {
+        Aabb local;
+        #pragma omp for nowait
+        for(Index i=start; i<end; ++i)
+            local.extend(points[indices[i]]);
+
+        #pragma omp critical
+        aabb.extend(local);
+    }
+    return aabb;
+}
+
 } // namespace pdpc
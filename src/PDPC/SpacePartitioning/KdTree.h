@@ -1,6 +1,8 @@
 #pragma once
 
 #include <PDPC/SpacePartitioning/KdTree/KdTreeNode.h>
+#include <PDPC/SpacePartitioning/KdTree/KdTreeLeafScan.h>
+#include <PDPC/SpacePartitioning/NeighborLists.h>
 
 #include <PDPC/SpacePartitioning/KdTree/Query/KdTreeKNearestIndexQuery.h>
 #include <PDPC/SpacePartitioning/KdTree/Query/KdTreeKNearestPointQuery.h>
@@ -30,12 +32,12 @@ public:
 public:
     KdTree();
     KdTree(std::shared_ptr<Vector3Array>& points);
-    KdTree(std::shared_ptr<Vector3Array>& points, const std::vector<int>& sampling);
+    KdTree(std::shared_ptr<Vector3Array>& points, const std::vector<Index>& sampling);
 
     void clear();
     void build(std::shared_ptr<Vector3Array>& points);
-    void build(std::shared_ptr<Vector3Array>& points, const std::vector<int>& sampling);
-    void rebuild(const std::vector<int>& sampling);
+    void build(std::shared_ptr<Vector3Array>& points, const std::vector<Index>& sampling);
+    void rebuild(const std::vector<Index>& sampling);
 
     bool valid() const;
     std::string to_string() const;
@@ -43,11 +45,61 @@ public:
     // Query -------------------------------------------------------------------
 public:
     KNearestPointQuery k_nearest_neighbors(const Vector3& point, int k) const;
-    KNearestIndexQuery k_nearest_neighbors(int index, int k) const;
+    KNearestIndexQuery k_nearest_neighbors(Index index, int k) const;
     NearestPointQuery  nearest_neighbor(const Vector3& point) const;
-    NearestIndexQuery  nearest_neighbor(int index) const;
+    NearestIndexQuery  nearest_neighbor(Index index) const;
     RangePointQuery    range_neighbors(const Vector3& point, Scalar r) const;
-    RangeIndexQuery    range_neighbors(int index, Scalar r) const;
+    RangeIndexQuery    range_neighbors(Index index, Scalar r) const;
+
+    // Batch Query -------------------------------------------------------------
+public:
+    //!
+    //! \brief batch_range returns the neighbors closer than r of each point of
+    //! indices (the point itself excluded), computed in parallel
+    //!
+    //! The neighbors of a query are in the order of range_neighbors. Queries
+    //! close to each other in indices share the visited nodes and points, so
+    //! indices in the order of index_data() are faster.
+    //!
+    NeighborLists batch_range(const std::vector<Index>& indices, Scalar r,
+                              bool squared_distances = false, bool verbose = false) const;
+
+    //! \brief batch_knn returns the k nearest neighbors of each point of indices, by increasing distance
+    NeighborLists batch_knn(const std::vector<Index>& indices, int k,
+                            bool squared_distances = false, bool verbose = false) const;
+
+    //!
+    //! \brief all_knn returns the k nearest neighbors of each indexed point, in
+    //! the order of index_data(), as batch_knn(index_data(), k)
+    //!
+    //! The points are solved by blocks of consecutive leaves. A point seeds its
+    //! neighbors of the block that are not solved yet: the k-th distance of the
+    //! seeding point and its neighbors to such a point bounds its k-th distance,
+    //! which is close to it when the two points are close. The point is then
+    //! solved by a range visit within this bound, whose hits are selected in
+    //! linear time, instead of a k-nearest query that inserts the points in a
+    //! queue while shrinking its bound. The points that no solved point has as
+    //! neighbor use a k-nearest query.
+    //!
+    NeighborLists all_knn(int k, bool squared_distances = false, bool verbose = false) const;
+
+    // Visitor Query -----------------------------------------------------------
+public:
+    //!
+    //! \brief for_each_in_range calls f(index, squared_distance) for each point
+    //! closer than r, in the order of range_neighbors
+    //!
+    //! The traversal is inlined into the caller without the state of the
+    //! iterators. f may return a bool, false to stop the traversal, in which
+    //! case for_each_in_range returns false. Only the points of the given
+    //! level are visited (see build_levels).
+    //!
+    template<class VisitorT>
+    bool for_each_in_range(const Vector3& point, Scalar r, VisitorT&& f, int level = 0) const;
+
+    //! \brief for_each_in_range visits the neighbors of the point index, excluding itself
+    template<class VisitorT>
+    bool for_each_in_range(Index index, Scalar r, VisitorT&& f, int level = 0) const;
 
     // Empty Query -------------------------------------------------------------
 public:
@@ -58,11 +110,55 @@ public:
     RangePointQuery    range_point_query(Scalar r = 0) const;
     RangeIndexQuery    range_index_query(Scalar r = 0) const;
 
+    // Levels ------------------------------------------------------------------
+public:
+    //!
+    //! \brief build_levels makes the kd-tree usable as a multi-resolution index
+    //!
+    //! point_levels gives for each point the finest level it belongs to, e.g.
+    //! the last index of a sequence of nested samplings that contains it.
+    //! The indices of each leaf are sorted by decreasing level so that the
+    //! points of a level form a prefix of the leaf, and each node stores the
+    //! maximal level of its points. Queries set to a level only visit the
+    //! points of this level, without rebuilding the tree.
+    //!
+    void build_levels(const std::vector<int>& point_levels);
+    void clear_levels();
+
+    bool has_levels() const;
+    int  level_count() const;
+
+    const std::vector<int>& level_data() const;
+    const std::vector<int>& node_level_data() const;
+
+    inline bool node_has_level(Index node_id, int level) const;
+    inline Index leaf_end(const KdTreeNode& leaf, int level) const;
+
+    // Leaf points -------------------------------------------------------------
+public:
+    //!
+    //! \brief build_leaf_points copies the coordinates of the points in the
+    //! order of index_data() into separate x, y and z arrays (SoA)
+    //!
+    //! The points of a leaf are then contiguous so that the queries test them
+    //! with SIMD kernels (see KdTreeLeafScan). The copy is made by the builds
+    //! and build_levels, it must be remade after modifying point_data() or
+    //! index_data() directly.
+    //!
+    void build_leaf_points();
+
+    //! \brief leaf_x returns the x coordinates of the points of index_data(), readable up to index_count() + leaf_padding()
+    inline const Scalar* leaf_x() const;
+    inline const Scalar* leaf_y() const;
+    inline const Scalar* leaf_z() const;
+
+    static constexpr int leaf_padding() {return 16;}
+
     // Accessors ---------------------------------------------------------------
 public:
-    int node_count() const;
-    int index_count() const;
-    int point_count() const;
+    Index node_count() const;
+    Index index_count() const;
+    Index point_count() const;
 
     const Vector3Array& point_data() const;
           Vector3Array& point_data();
@@ -73,8 +169,8 @@ public:
     const std::vector<KdTreeNode>& node_data() const;
           std::vector<KdTreeNode>& node_data();
 
-    const std::vector<int>& index_data() const;
-          std::vector<int>& index_data();
+    const std::vector<Index>& index_data() const;
+          std::vector<Index>& index_data();
 
     // Parameters --------------------------------------------------------------
 public:
@@ -83,16 +179,47 @@ public:
 
     // Internal ----------------------------------------------------------------
 public:
-    void build_rec(int node_id, int start, int end, int level);
-    int partition(int start, int end, int dim, Scalar value);
+    //!
+    //! \brief build_root builds the nodes of the indices
+    //!
+    //! The nodes of more than parallel_size() indices are split one after the
+    //! other with parallel passes, then the smaller subtrees are built
+    //! concurrently and appended to the nodes. The tree does not depend on the
+    //! thread count, and is the one of build_rec for less indices.
+    //!
+    void build_root();
+    void build_rec(std::vector<KdTreeNode>& nodes, Index node_id, Index start, Index end, int level);
+    Index partition(Index start, Index end, int dim, Scalar value);
+
+    Index parallel_partition(Index start, Index end, int dim, Scalar value);
+    Aabb bounding_box(Index start, Index end) const;
+
+    static constexpr int parallel_size() {return 1 << 16;}
+
+    template<class VisitorT>
+    bool visit_range(const Vector3& point, Scalar squared_radius, Index excluded, VisitorT& f, int level) const;
+
+    //!
+    //! \brief visit_positions calls f(position, squared_distance) for each
+    //! point closer than the squared radius, with its position in index_data()
+    //!
+    template<class VisitorT>
+    bool visit_positions(const Vector3& point, Scalar squared_radius, VisitorT& f, int level) const;
 
     // Data --------------------------------------------------------------------
 protected:
     std::shared_ptr<Vector3Array>            m_points;
     std::shared_ptr<std::vector<KdTreeNode>> m_nodes;
-    std::shared_ptr<std::vector<int>>        m_indices;
+    std::shared_ptr<std::vector<Index>>      m_indices;
+    std::shared_ptr<std::vector<int>>        m_levels;
+    std::shared_ptr<std::vector<int>>        m_node_levels;
+    std::shared_ptr<std::vector<Scalar>>     m_leaf_points;
+    Index                                    m_leaf_stride;
 
     int m_min_cell_size;
 };
 
 } // namespace pdpc
+
+#include <PDPC/SpacePartitioning/KdTree.inl>
+#include <PDPC/SpacePartitioning/KdTree.hpp>
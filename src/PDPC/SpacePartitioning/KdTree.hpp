@@ -0,0 +1,94 @@
+#include <PDPC/SpacePartitioning/KdTree.h>
+#include <PDPC/SpacePartitioning/internal/NeighborVisitor.h>
+
+#include <algorithm>
+
+namespace pdpc {
+
+// Visitor Query ---------------------------------------------------------------
+
+template<class VisitorT>
+bool KdTree::for_each_in_range(const Vector3& point, Scalar r, VisitorT&& f, int level) const
+{
+    return this->visit_range(point, r * r, -1, f, level);
+}
+
+template<class VisitorT>
+bool KdTree::for_each_in_range(Index index, Scalar r, VisitorT&& f, int level) const
+{
+    return this->visit_range(this->point_data()[index], r * r, index, f, level);
+}
+
+template<class VisitorT>
+bool KdTree::visit_range(const Vector3& point, Scalar squared_radius, Index excluded, VisitorT& f, int level) const
+{
+    const auto& indices = *m_indices.get();
+
+    auto visitor = [&indices,excluded,&f](Index position, Scalar squared_distance)
+    {
+        const Index idx = indices[position];
+        return idx == excluded || internal::visit_neighbor(f, idx, squared_distance);
+    };
+    return this->visit_positions(point, squared_radius, visitor, level);
+}
+
+template<class VisitorT>
+bool KdTree::visit_positions(const Vector3& point, Scalar squared_radius, VisitorT& f, int level) const
+{
+    const auto& nodes = *m_nodes.get();
+
+    static_stack<IndexSquaredDistance, 2*PDPC_KDTREE_MAX_DEPTH> stack;
+    stack.push({0,0});
+
+    KdTreeLeafHits hits;
+
+    while(!stack.empty())
+    {
+        auto& qnode = stack.top();
+        const auto& node = nodes[qnode.index];
+
+        if(qnode.squared_distance < squared_radius && this->node_has_level(qnode.index, level))
+        {
+            if(node.leaf)
+            {
+                stack.pop();
+                const Index end = this->leaf_end(node, level);
+                for(Index start=node.start; start<end; start+=KdTreeLeafHits::Capacity)
+                {
+                    KdTreeLeafScan::scan(*this, start, std::min(start + KdTreeLeafHits::Capacity, end),
+                                         point, squared_radius, hits);
+                    for(int h=0; h<hits.count; ++h)
+                    {
+                        if(!internal::visit_neighbor(f, hits.position(h), hits.squared_distances[h]))
+                            return false;
+                    }
+                }
+            }
+            else
+            {
+                // replace the stack top by the farthest and push the closest
+                Scalar newOff = point[node.dim] - node.splitValue;
+                stack.push();
+                if(newOff < 0)
+                {
+                    stack.top().index = node.firstChildId;
+                    qnode.index       = node.firstChildId+1;
+                }
+                else
+                {
+                    stack.top().index = node.firstChildId+1;
+                    qnode.index       = node.firstChildId;
+                }
+                stack.top().squared_distance = qnode.squared_distance;
+                qnode.squared_distance       = newOff*newOff;
+            }
+        }
+        else
+        {
+            stack.pop();
+        }
+    }
+    return true;
+}
+
+} // namespace pdpc
@@ -0,0 +1,43 @@
+#include <PDPC/SpacePartitioning/KdTree.h>
+
+#include <algorithm>
+
+namespace pdpc {
+
+// Levels ----------------------------------------------------------------------
+
+bool KdTree::node_has_level(Index node_id, int level) const
+{
+    return level <= 0 || !m_node_levels || (*m_node_levels)[node_id] >= level;
+}
+
+Index KdTree::leaf_end(const KdTreeNode& leaf, int level) const
+{
+    const Index end = leaf.start + leaf.size;
+    if(level <= 0 || !m_levels) return end;
+
+    const auto first = m_levels->begin();
+    return std::distance(first, std::partition_point(first + leaf.start, first + end, [level](int l)
+    {
+        return l >= level;
+    }));
+}
+
+// Leaf points -----------------------------------------------------------------
+
+const Scalar* KdTree::leaf_x() const
+{
+    return m_leaf_points->data();
+}
+
+const Scalar* KdTree::leaf_y() const
+{
+    return m_leaf_points->data() + m_leaf_stride;
+}
+
+const Scalar* KdTree::leaf_z() const
+{
+    return m_leaf_points->data() + 2 * std::size_t(m_leaf_stride);
+}
+
+} // namespace pdpc
@@ -22,7 +22,7 @@ void KdTreeKNearestIndexIterator::operator ++()
     ++m_iterator;
 }
 
-int KdTreeKNearestIndexIterator::operator * () const
+Index KdTreeKNearestIndexIterator::operator * () const
 {
     return m_iterator->index;
 }
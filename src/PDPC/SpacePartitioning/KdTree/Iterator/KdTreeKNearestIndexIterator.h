@@ -13,7 +13,7 @@ public:
 public:
     bool operator !=(const KdTreeKNearestIndexIterator& other) const;
     void operator ++();
-    int  operator * () const;
+    Index operator * () const;
     void operator +=(int i);
 
 protected:
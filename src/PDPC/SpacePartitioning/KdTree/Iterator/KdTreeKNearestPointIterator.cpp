@@ -22,7 +22,7 @@ void KdTreeKNearestPointIterator::operator ++()
     ++m_iterator;
 }
 
-int KdTreeKNearestPointIterator::operator * () const
+Index KdTreeKNearestPointIterator::operator * () const
 {
     return m_iterator->index;
 }
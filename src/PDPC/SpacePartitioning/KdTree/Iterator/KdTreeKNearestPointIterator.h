@@ -13,7 +13,7 @@ public:
 public:
     bool operator !=(const KdTreeKNearestPointIterator& other) const;
     void operator ++();
-    int  operator * () const;
+    Index operator * () const;
 
 protected:
     limited_priority_queue<IndexSquaredDistance>::iterator m_iterator;
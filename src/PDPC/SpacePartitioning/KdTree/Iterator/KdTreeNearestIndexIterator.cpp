@@ -7,7 +7,7 @@ KdTreeNearestIndexIterator::KdTreeNearestIndexIterator() :
 {
 }
 
-KdTreeNearestIndexIterator::KdTreeNearestIndexIterator(int index) :
+KdTreeNearestIndexIterator::KdTreeNearestIndexIterator(Index index) :
     m_index(index)
 {
 }
@@ -22,7 +22,7 @@ void KdTreeNearestIndexIterator::operator ++()
     ++m_index;
 }
 
-int KdTreeNearestIndexIterator::operator * () const
+Index KdTreeNearestIndexIterator::operator * () const
 {
     return m_index;
 }
@@ -1,20 +1,22 @@
 #pragma once
 
+#include <PDPC/Common/Defines.h>
+
 namespace pdpc {
 
 class KdTreeNearestIndexIterator
 {
 public:
     KdTreeNearestIndexIterator();
-    KdTreeNearestIndexIterator(int index);
+    KdTreeNearestIndexIterator(Index index);
 
 public:
     bool operator !=(const KdTreeNearestIndexIterator& other) const;
     void operator ++();
-    int  operator * () const;
+    Index operator * () const;
 
 protected:
-    int m_index;
+    Index m_index;
 };
 
 } // namespace pdpc
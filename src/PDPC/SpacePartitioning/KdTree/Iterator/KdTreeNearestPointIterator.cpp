@@ -7,7 +7,7 @@ KdTreeNearestPointIterator::KdTreeNearestPointIterator() :
 {
 }
 
-KdTreeNearestPointIterator::KdTreeNearestPointIterator(int index) :
+KdTreeNearestPointIterator::KdTreeNearestPointIterator(Index index) :
     m_index(index)
 {
 }
@@ -22,7 +22,7 @@ void KdTreeNearestPointIterator::operator ++()
     ++m_index;
 }
 
-int KdTreeNearestPointIterator::operator * () const
+Index KdTreeNearestPointIterator::operator * () const
 {
     return m_index;
 }
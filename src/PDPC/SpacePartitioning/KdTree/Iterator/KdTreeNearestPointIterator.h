@@ -1,20 +1,22 @@
 #pragma once
 
+#include <PDPC/Common/Defines.h>
+
 namespace pdpc {
 
 class KdTreeNearestPointIterator
 {
 public:
     KdTreeNearestPointIterator();
-    KdTreeNearestPointIterator(int index);
+    KdTreeNearestPointIterator(Index index);
 
 public:
     bool operator !=(const KdTreeNearestPointIterator& other) const;
     void operator ++();
-    int  operator * () const;
+    Index operator * () const;
 
 protected:
-    int m_index;
+    Index m_index;
 };
 
 } // namespace pdpc
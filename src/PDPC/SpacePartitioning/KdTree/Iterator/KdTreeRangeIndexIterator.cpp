@@ -19,7 +19,7 @@ KdTreeRangeIndexIterator::KdTreeRangeIndexIterator(KdTreeRangeIndexQuery* query)
 {
 }
 
-KdTreeRangeIndexIterator::KdTreeRangeIndexIterator(KdTreeRangeIndexQuery* query, int index) :
+KdTreeRangeIndexIterator::KdTreeRangeIndexIterator(KdTreeRangeIndexQuery* query, Index index) :
     m_query(query),
     m_index(index),
     m_start(0),
@@ -37,9 +37,15 @@ void KdTreeRangeIndexIterator::operator ++()
     m_query->advance(*this);
 }
 
-int KdTreeRangeIndexIterator::operator * () const
+Index KdTreeRangeIndexIterator::operator * () const
 {
     return m_index;
 }
 
+Scalar KdTreeRangeIndexIterator::squared_distance() const
+{
+    const KdTreeLeafHits& hits = m_query->m_hits;
+    return hits.squared_distances[hits.next-1];
+}
+
 } // namespace pdpc
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <PDPC/Common/Defines.h>
+
 namespace pdpc {
 
 class KdTreeRangeIndexQuery;
@@ -12,18 +14,21 @@ protected:
 public:
     KdTreeRangeIndexIterator();
     KdTreeRangeIndexIterator(KdTreeRangeIndexQuery* query);
-    KdTreeRangeIndexIterator(KdTreeRangeIndexQuery* query, int index);
+    KdTreeRangeIndexIterator(KdTreeRangeIndexQuery* query, Index index);
 
 public:
     bool operator !=(const KdTreeRangeIndexIterator& other) const;
     void operator ++();
-    int  operator * () const;
+    Index operator * () const;
+
+    //! \brief squared_distance returns the squared distance of the current neighbor to the query
+    Scalar squared_distance() const;
 
 protected:
     KdTreeRangeIndexQuery* m_query;
-    int m_index;
-    int m_start;
-    int m_end;
+    Index m_index;
+    Index m_start;
+    Index m_end;
 };
 
 } // namespace pdpc
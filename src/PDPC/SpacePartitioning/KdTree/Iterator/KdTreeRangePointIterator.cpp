@@ -19,7 +19,7 @@ KdTreeRangePointIterator::KdTreeRangePointIterator(KdTreeRangePointQuery* query)
 {
 }
 
-KdTreeRangePointIterator::KdTreeRangePointIterator(KdTreeRangePointQuery* query, int index) :
+KdTreeRangePointIterator::KdTreeRangePointIterator(KdTreeRangePointQuery* query, Index index) :
     m_query(query),
     m_index(index),
     m_start(0),
@@ -37,7 +37,7 @@ void KdTreeRangePointIterator::operator ++()
     m_query->advance(*this);
 }
 
-int KdTreeRangePointIterator::operator * () const
+Index KdTreeRangePointIterator::operator * () const
 {
     return m_index;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <PDPC/Common/Defines.h>
+
 namespace pdpc {
 
 class KdTreeRangePointQuery;
@@ -12,18 +14,18 @@ protected:
 public:
     KdTreeRangePointIterator();
     KdTreeRangePointIterator(KdTreeRangePointQuery* query);
-    KdTreeRangePointIterator(KdTreeRangePointQuery* query, int index);
+    KdTreeRangePointIterator(KdTreeRangePointQuery* query, Index index);
 
 public:
     bool operator !=(const KdTreeRangePointIterator& other) const;
     void operator ++();
-    int  operator * () const;
+    Index operator * () const;
 
 protected:
     KdTreeRangePointQuery* m_query;
-    int m_index;
-    int m_start;
-    int m_end;
+    Index m_index;
+    Index m_start;
+    Index m_end;
 };
 
 } // namespace pdpc
@@ -0,0 +1,73 @@
+#include <PDPC/SpacePartitioning/KdTree/KdTreeLeafScan.h>
+#include <PDPC/SpacePartitioning/internal/KdTreeLeafScanImpl.h>
+#include <PDPC/SpacePartitioning/KdTree.h>
+
+namespace pdpc {
+
+void KdTreeLeafScan::scan(const KdTree& kdtree,
+                          Index start, Index end,
+                          const Vector3& point,
+                          Scalar squared_bound,
+                          KdTreeLeafHits& hits)
+{
+    scan(simd_level(), kdtree, start, end, point, squared_bound, hits);
+}
+
+void KdTreeLeafScan::scan(SimdLevel level,
+                          const KdTree& kdtree,
+                          Index start, Index end,
+                          const Vector3& point,
+                          Scalar squared_bound,
+                          KdTreeLeafHits& hits)
+{
+    PDPC_DEBUG_ASSERT(end - start <= KdTreeLeafHits::Capacity);
+
+    internal::KdTreeLeafScanArgs args;
+    args.xs    = kdtree.leaf_x() + start;
+    args.ys    = kdtree.leaf_y() + start;
+    args.zs    = kdtree.leaf_z() + start;
+    args.start = 0;
+    args.end   = end - start;
+    args.qx    = point.x();
+    args.qy    = point.y();
+    args.qz    = point.z();
+    args.squared_bound = squared_bound;
+
+    hits.start = start;
+    hits.next  = 0;
+    switch(level)
+    {
+#ifdef PDPC_SIMD_X86
+    case SimdLevel::AVX512: hits.count = internal::kdtree_leaf_scan_avx512(args, hits.offsets, hits.squared_distances); break;
+    case SimdLevel::AVX2:   hits.count = internal::kdtree_leaf_scan_avx2(  args, hits.offsets, hits.squared_distances); break;
+#endif
+    default:                hits.count = internal::kdtree_leaf_scan_scalar(args, hits.offsets, hits.squared_distances); break;
+    }
+}
+
+// Scalar kernel ---------------------------------------------------------------
+
+namespace internal {
+
+int kdtree_leaf_scan_scalar(const KdTreeLeafScanArgs& a, int* positions, Scalar* squared_distances)
+{
+    int count = 0;
+    for(int i=a.start; i<a.end; ++i)
+    {
+        const Scalar dx = a.qx - a.xs[i];
+        const Scalar dy = a.qy - a.ys[i];
+        const Scalar dz = a.qz - a.zs[i];
+        const Scalar d2 = dx*dx + (dy*dy + dz*dz);
+        if(d2 < a.squared_bound)
+        {
+            positions[count]         = i;
+            squared_distances[count] = d2;
+            ++count;
+        }
+    }
+    return count;
+}
+
+} // namespace internal
+
+} // namespace pdpc
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+#include <PDPC/Common/Cpu.h>
+
+namespace pdpc {
+
+class KdTree;
+
+//!
+//! \brief The KdTreeLeafHits struct holds the points of a chunk of a leaf that
+//! are closer to a query than a bound
+//!
+struct KdTreeLeafHits
+{
+    enum {Capacity = 64};
+
+    inline void  clear();
+    inline bool  pending() const;
+    inline Index position(int h) const; //!< position of the hit h in KdTree::index_data()
+
+    Index  start = 0; //!< position of the first point of the scanned chunk
+    int    count = 0; //!< count of hits
+    int    next  = 0; //!< next hit to be visited by a range query
+    int    offsets[Capacity];           //!< positions of the hits relative to start
+    Scalar squared_distances[Capacity];
+};
+
+//!
+//! \brief The KdTreeLeafScan class tests the points of a leaf against a query
+//! with the SoA copy of the leaf points (see KdTree::leaf_x)
+//!
+//! The squared distances are vectorized with AVX2 or AVX-512 depending on
+//! simd_level(), with a scalar fallback. They are rounded as Eigen's
+//! squaredNorm, so that the hits do not depend on the instruction set.
+//!
+class KdTreeLeafScan
+{
+public:
+    //!
+    //! \brief scan writes to hits the positions in [start,end) of the points
+    //! whose squared distance to point is lower than squared_bound
+    //!
+    //! The range must not be larger than KdTreeLeafHits::Capacity.
+    //!
+    static void scan(const KdTree& kdtree,
+                     Index start, Index end,
+                     const Vector3& point,
+                     Scalar squared_bound,
+                     KdTreeLeafHits& hits);
+
+    //! \brief scan uses the given instruction set, which must be supported by the cpu
+    static void scan(SimdLevel level,
+                     const KdTree& kdtree,
+                     Index start, Index end,
+                     const Vector3& point,
+                     Scalar squared_bound,
+                     KdTreeLeafHits& hits);
+};
+
+// KdTreeLeafHits --------------------------------------------------------------
+
+void KdTreeLeafHits::clear()
+{
+    count = 0;
+    next  = 0;
+}
+
+bool KdTreeLeafHits::pending() const
+{
+    return next < count;
+}
+
+Index KdTreeLeafHits::position(int h) const
+{
+    return start + offsets[h];
+}
+
+} // namespace pdpc
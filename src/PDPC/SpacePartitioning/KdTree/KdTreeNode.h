@@ -1,21 +1,49 @@
 #pragma once
 
+#include <PDPC/Common/Defines.h>
+
 namespace pdpc {
 
+//!
+//! \brief The KdTreeNode struct is either an inner node (split plane and index
+//! of its first child, the second one follows) or a leaf (range of indices)
+//!
+//! By default a node takes 8 bytes, with 29 bits for the first child index and
+//! for the leaf size, i.e. at most 2^29 nodes and 2^29 points per leaf. With
+//! PDPC_INDEX_64 a node takes 16 bytes, with 61 bits for the first child
+//! index, the leaf start and the leaf size.
+//!
 struct KdTreeNode
 {
+#ifdef PDPC_INDEX_64
+    using Word = std::uint64_t;
+    enum {IdBits = 61};
+#else
+    using Word = std::uint32_t;
+    enum {IdBits = 29};
+#endif
+
+    //! \brief max_id is the maximal first child index and leaf size
+    static constexpr Word max_id() {return (Word(1) << IdBits) - 1;}
+
     union {
         struct {
-            float          splitValue;
-            unsigned int   firstChildId:24;
-            unsigned int   dim:2;
-            unsigned int   leaf:1;
+            float splitValue;
+            Word  firstChildId:IdBits;
+            Word  dim:2;
+            Word  leaf:1;
         };
         struct {
-            unsigned int   start;
-            unsigned short size;
+            Word  start;
+            Word  size:IdBits;
         };
     };
 };
 
+#ifdef PDPC_INDEX_64
+static_assert(sizeof(KdTreeNode) == 16, "KdTreeNode should take 16 bytes");
+#else
+static_assert(sizeof(KdTreeNode) == 8, "KdTreeNode should take 8 bytes");
+#endif
+
 } // namespace pdpc
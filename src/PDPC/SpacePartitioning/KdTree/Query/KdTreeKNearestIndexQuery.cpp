@@ -1,6 +1,8 @@
 #include <PDPC/SpacePartitioning/KdTree/Query/KdTreeKNearestIndexQuery.h>
 #include <PDPC/SpacePartitioning/KdTree.h>
 
+#include <algorithm>
+
 namespace pdpc {
 
 KdTreeKNearestIndexQuery::KdTreeKNearestIndexQuery() :
@@ -15,7 +17,7 @@ KdTreeKNearestIndexQuery::KdTreeKNearestIndexQuery(const KdTree* kdtree, int k)
 {
 }
 
-KdTreeKNearestIndexQuery::KdTreeKNearestIndexQuery(const KdTree* kdtree, int k, int index) :
+KdTreeKNearestIndexQuery::KdTreeKNearestIndexQuery(const KdTree* kdtree, int k, Index index) :
     KdTreeQuery(kdtree),
     KNearestIndexQuery(k, index)
 {
@@ -35,9 +37,8 @@ KdTreeKNearestIndexIterator KdTreeKNearestIndexQuery::end()
 const limited_priority_queue<IndexSquaredDistance>& KdTreeKNearestIndexQuery::search()
 {
     const auto& nodes   = m_kdtree->node_data();
-    const auto& points  = m_kdtree->point_data();
     const auto& indices = m_kdtree->index_data();
-    const auto& point   = points[m_index];
+    const auto& point   = m_kdtree->point_data()[m_index];
 
     m_stack.clear();
     m_stack.push({0,0});
@@ -50,19 +51,22 @@ const limited_priority_queue<IndexSquaredDistance>& KdTreeKNearestIndexQuery::se
         auto& qnode = m_stack.top();
         const auto& node  = nodes[qnode.index];
 
-        if(qnode.squared_distance < m_queue.bottom().squared_distance)
+        if(qnode.squared_distance < m_queue.bottom().squared_distance && m_kdtree->node_has_level(qnode.index, m_level))
         {
             if(node.leaf)
             {
                 m_stack.pop();
-                int end = node.start + node.size;
-                for(int i=node.start; i<end; ++i)
+                const Index end = m_kdtree->leaf_end(node, m_level);
+                for(Index start=node.start; start<end; start+=KdTreeLeafHits::Capacity)
                 {
-                    int idx = indices[i];
-                    if(m_index == idx) continue;
-
-                    Scalar d = (point - points[idx]).squaredNorm();
-                    m_queue.push({idx, d});
+                    KdTreeLeafScan::scan(*m_kdtree, start, std::min(start + KdTreeLeafHits::Capacity, end),
+                                         point, m_queue.bottom().squared_distance, m_hits);
+                    for(int h=0; h<m_hits.count; ++h)
+                    {
+                        const Index idx = indices[m_hits.position(h)];
+                        if(m_index == idx) continue;
+                        m_queue.push({idx, m_hits.squared_distances[h]});
+                    }
                 }
             }
             else
@@ -12,7 +12,7 @@ class KdTreeKNearestIndexQuery : public KdTreeQuery,
 public:
     KdTreeKNearestIndexQuery();
     KdTreeKNearestIndexQuery(const KdTree* kdtree, int k);
-    KdTreeKNearestIndexQuery(const KdTree* kdtree, int k, int index);
+    KdTreeKNearestIndexQuery(const KdTree* kdtree, int k, Index index);
 
 public:
     KdTreeKNearestIndexIterator begin();
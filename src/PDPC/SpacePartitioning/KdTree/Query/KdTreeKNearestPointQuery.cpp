@@ -1,6 +1,8 @@
 #include <PDPC/SpacePartitioning/KdTree/Query/KdTreeKNearestPointQuery.h>
 #include <PDPC/SpacePartitioning/KdTree.h>
 
+#include <algorithm>
+
 namespace pdpc {
 
 KdTreeKNearestPointQuery::KdTreeKNearestPointQuery() :
@@ -35,7 +37,6 @@ KdTreeKNearestPointIterator KdTreeKNearestPointQuery::end()
 const limited_priority_queue<IndexSquaredDistance>& KdTreeKNearestPointQuery::search()
 {
     const auto& nodes   = m_kdtree->node_data();
-    const auto& points  = m_kdtree->point_data();
     const auto& indices = m_kdtree->index_data();
 
     m_stack.clear();
@@ -49,18 +50,21 @@ const limited_priority_queue<IndexSquaredDistance>& KdTreeKNearestPointQuery::se
         auto& qnode = m_stack.top();
         const auto& node  = nodes[qnode.index];
 
-        if(qnode.squared_distance < m_queue.bottom().squared_distance)
+        if(qnode.squared_distance < m_queue.bottom().squared_distance && m_kdtree->node_has_level(qnode.index, m_level))
         {
             if(node.leaf)
             {
                 m_stack.pop();
-                int end = node.start + node.size;
-                for(int i=node.start; i<end; ++i)
+                const Index end = m_kdtree->leaf_end(node, m_level);
+                for(Index start=node.start; start<end; start+=KdTreeLeafHits::Capacity)
                 {
-                    int idx = indices[i];
-
-                    Scalar d = (m_point - points[idx]).squaredNorm();
-                    m_queue.push({idx, d});
+                    KdTreeLeafScan::scan(*m_kdtree, start, std::min(start + KdTreeLeafHits::Capacity, end),
+                                         m_point, m_queue.bottom().squared_distance, m_hits);
+                    for(int h=0; h<m_hits.count; ++h)
+                    {
+                        const Index idx = indices[m_hits.position(h)];
+                        m_queue.push({idx, m_hits.squared_distances[h]});
+                    }
                 }
             }
             else
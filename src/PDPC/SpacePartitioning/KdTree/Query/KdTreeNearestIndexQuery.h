@@ -12,7 +12,7 @@ class KdTreeNearestIndexQuery : public KdTreeQuery,
 public:
     KdTreeNearestIndexQuery();
     KdTreeNearestIndexQuery(const KdTree* kdtree);
-    KdTreeNearestIndexQuery(const KdTree* kdtree, int index);
+    KdTreeNearestIndexQuery(const KdTree* kdtree, Index index);
 
 public:
     KdTreeNearestIndexIterator begin();
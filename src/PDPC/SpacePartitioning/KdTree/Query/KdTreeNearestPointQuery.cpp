@@ -1,6 +1,8 @@
 #include <PDPC/SpacePartitioning/KdTree/Query/KdTreeNearestPointQuery.h>
 #include <PDPC/SpacePartitioning/KdTree.h>
 
+#include <algorithm>
+
 namespace pdpc {
 
 KdTreeNearestPointQuery::KdTreeNearestPointQuery() :
@@ -35,35 +37,37 @@ KdTreeNearestPointIterator KdTreeNearestPointQuery::end()
 void KdTreeNearestPointQuery::search()
 {
     const auto& nodes   = m_kdtree->node_data();
-    const auto& points  = m_kdtree->point_data();
     const auto& indices = m_kdtree->index_data();
 
     m_stack.clear();
     m_stack.push({0,0});
 
-    m_nearest = indices[0];
-    m_squared_distance = (m_point - points[m_nearest]).squaredNorm();
+    m_nearest = -1;
+    m_squared_distance = std::numeric_limits<Scalar>::max();
 
     while(!m_stack.empty())
     {
         auto& qnode = m_stack.top();
         const auto& node  = nodes[qnode.index];
 
-        if(qnode.squared_distance < m_squared_distance)
+        if(qnode.squared_distance < m_squared_distance && m_kdtree->node_has_level(qnode.index, m_level))
         {
             if(node.leaf)
             {
                 m_stack.pop();
-                int end = node.start + node.size;
-                for(int i=node.start; i<end; ++i)
+                const Index end = m_kdtree->leaf_end(node, m_level);
+                for(Index start=node.start; start<end; start+=KdTreeLeafHits::Capacity)
                 {
-                    int idx = indices[i];
-
-                    Scalar d = (m_point - points[idx]).squaredNorm();
-                    if(d < m_squared_distance)
+                    KdTreeLeafScan::scan(*m_kdtree, start, std::min(start + KdTreeLeafHits::Capacity, end),
+                                         m_point, m_squared_distance, m_hits);
+                    for(int h=0; h<m_hits.count; ++h)
                     {
-                        m_nearest = idx;
-                        m_squared_distance = d;
+                        const Index idx = indices[m_hits.position(h)];
+                        if(m_hits.squared_distances[h] < m_squared_distance)
+                        {
+                            m_nearest = idx;
+                            m_squared_distance = m_hits.squared_distances[h];
+                        }
                     }
                 }
             }
@@ -3,13 +3,25 @@
 namespace pdpc {
 
 KdTreeQuery::KdTreeQuery() :
-    m_kdtree(nullptr)
+    m_kdtree(nullptr),
+    m_level(0)
 {
 }
 
 KdTreeQuery::KdTreeQuery(const KdTree* kdtree) :
-    m_kdtree(kdtree)
+    m_kdtree(kdtree),
+    m_level(0)
 {
 }
 
+int KdTreeQuery::level() const
+{
+    return m_level;
+}
+
+void KdTreeQuery::set_level(int level)
+{
+    m_level = level;
+}
+
 } // namespace pdpc
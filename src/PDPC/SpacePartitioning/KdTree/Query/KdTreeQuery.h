@@ -1,6 +1,7 @@
 #pragma once
 
 #include <PDPC/SpacePartitioning/internal/IndexSquaredDistance.h>
+#include <PDPC/SpacePartitioning/KdTree/KdTreeLeafScan.h>
 #include <PDPC/Common/Containers/static_stack.h>
 
 #define PDPC_KDTREE_MAX_DEPTH 32
@@ -15,9 +16,16 @@ public:
     KdTreeQuery();
     KdTreeQuery(const KdTree* kdtree);
 
+public:
+    //! \brief level restricts the query to the points of a level (see KdTree::build_levels)
+    int  level() const;
+    void set_level(int level);
+
 protected:
     const KdTree* m_kdtree;
+    int           m_level;
     static_stack<IndexSquaredDistance, 2*PDPC_KDTREE_MAX_DEPTH> m_stack;
+    KdTreeLeafHits m_hits;
 };
 
 } // namespace pdpc
@@ -1,6 +1,8 @@
 #include <PDPC/SpacePartitioning/KdTree/Query/KdTreeRangeIndexQuery.h>
 #include <PDPC/SpacePartitioning/KdTree.h>
 
+#include <algorithm>
+
 namespace pdpc {
 
 KdTreeRangeIndexQuery::KdTreeRangeIndexQuery() :
@@ -21,7 +23,7 @@ KdTreeRangeIndexQuery::KdTreeRangeIndexQuery(const KdTree* kdtree, Scalar radius
 {
 }
 
-KdTreeRangeIndexQuery::KdTreeRangeIndexQuery(const KdTree* kdtree, Scalar radius, int index) :
+KdTreeRangeIndexQuery::KdTreeRangeIndexQuery(const KdTree* kdtree, Scalar radius, Index index) :
     KdTreeQuery(kdtree),
     RangeIndexQuery(radius, index)
 {
@@ -49,54 +51,47 @@ void KdTreeRangeIndexQuery::initialize(KdTreeRangeIndexIterator& it)
     it.m_index = -1;
     it.m_start = 0;
     it.m_end   = 0;
+    m_hits.clear();
 }
 
 void KdTreeRangeIndexQuery::advance(KdTreeRangeIndexIterator& it)
 {
     const auto& nodes   = m_kdtree->node_data();
-    const auto& points  = m_kdtree->point_data();
     const auto& indices = m_kdtree->index_data();
-    const auto& point   = points[m_index];
+    const auto& point   = m_kdtree->point_data()[m_index];
 
-    for(int i=it.m_start; i<it.m_end; ++i)
+    while(true)
     {
-        int idx = indices[i];
-        if(idx == m_index) continue;
-
-        Scalar d = (point - points[idx]).squaredNorm();
-        if(d < m_squared_radius)
+        // remaining hits of the current chunk
+        while(m_hits.pending())
         {
+            const Index idx = indices[m_hits.position(m_hits.next++)];
+            if(idx == m_index) continue;
             it.m_index = idx;
-            it.m_start = i+1;
             return;
         }
-    }
 
-    while(!m_stack.empty())
-    {
+        // next chunk of the current leaf
+        if(it.m_start < it.m_end)
+        {
+            const Index end = std::min(it.m_start + KdTreeLeafHits::Capacity, it.m_end);
+            KdTreeLeafScan::scan(*m_kdtree, it.m_start, end, point, m_squared_radius, m_hits);
+            it.m_start = end;
+            continue;
+        }
+
+        if(m_stack.empty()) break;
+
         auto& qnode = m_stack.top();
         const auto& node = nodes[qnode.index];
 
-        if(qnode.squared_distance < m_squared_radius)
+        if(qnode.squared_distance < m_squared_radius && m_kdtree->node_has_level(qnode.index, m_level))
         {
             if(node.leaf)
             {
                 m_stack.pop();
                 it.m_start = node.start;
-                it.m_end   = node.start + node.size;
-                for(int i=it.m_start; i<it.m_end; ++i)
-                {
-                    int idx = indices[i];
-                    if(idx == m_index) continue;
-
-                    Scalar d = (point - points[idx]).squaredNorm();
-                    if(d < m_squared_radius)
-                    {
-                        it.m_index = idx;
-                        it.m_start = i+1;
-                        return;
-                    }
-                }
+                it.m_end   = m_kdtree->leaf_end(node, m_level);
             }
             else
             {
@@ -16,7 +16,7 @@ public:
     KdTreeRangeIndexQuery();
     KdTreeRangeIndexQuery(const KdTree* kdtree);
     KdTreeRangeIndexQuery(const KdTree* kdtree, Scalar radius);
-    KdTreeRangeIndexQuery(const KdTree* kdtree, Scalar radius, int index);
+    KdTreeRangeIndexQuery(const KdTree* kdtree, Scalar radius, Index index);
 
 public:
     KdTreeRangeIndexIterator begin();
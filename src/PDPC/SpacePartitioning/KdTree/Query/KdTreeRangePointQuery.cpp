@@ -1,6 +1,8 @@
 #include <PDPC/SpacePartitioning/KdTree/Query/KdTreeRangePointQuery.h>
 #include <PDPC/SpacePartitioning/KdTree.h>
 
+#include <algorithm>
+
 namespace pdpc {
 
 KdTreeRangePointQuery::KdTreeRangePointQuery() :
@@ -49,51 +51,45 @@ void KdTreeRangePointQuery::initialize(KdTreeRangePointIterator& it)
     it.m_index = -1;
     it.m_start = 0;
     it.m_end   = 0;
+    m_hits.clear();
 }
 
 void KdTreeRangePointQuery::advance(KdTreeRangePointIterator& it)
 {
     const auto& nodes   = m_kdtree->node_data();
-    const auto& points  = m_kdtree->point_data();
     const auto& indices = m_kdtree->index_data();
 
-    for(int i=it.m_start; i<it.m_end; ++i)
+    while(true)
     {
-        int idx = indices[i];
-
-        Scalar d = (m_point - points[idx]).squaredNorm();
-        if(d < m_squared_radius)
+        // remaining hits of the current chunk
+        while(m_hits.pending())
         {
+            const Index idx = indices[m_hits.position(m_hits.next++)];
             it.m_index = idx;
-            it.m_start = i+1;
             return;
         }
-    }
 
-    while(!m_stack.empty())
-    {
+        // next chunk of the current leaf
+        if(it.m_start < it.m_end)
+        {
+            const Index end = std::min(it.m_start + KdTreeLeafHits::Capacity, it.m_end);
+            KdTreeLeafScan::scan(*m_kdtree, it.m_start, end, m_point, m_squared_radius, m_hits);
+            it.m_start = end;
+            continue;
+        }
+
+        if(m_stack.empty()) break;
+
         auto& qnode = m_stack.top();
         const auto& node = nodes[qnode.index];
 
-        if(qnode.squared_distance < m_squared_radius)
+        if(qnode.squared_distance < m_squared_radius && m_kdtree->node_has_level(qnode.index, m_level))
         {
             if(node.leaf)
             {
                 m_stack.pop();
                 it.m_start = node.start;
-                it.m_end   = node.start + node.size;
-                for(int i=it.m_start; i<it.m_end; ++i)
-                {
-                    int idx = indices[i];
-
-                    Scalar d = (m_point - points[idx]).squaredNorm();
-                    if(d < m_squared_radius)
-                    {
-                        it.m_index = idx;
-                        it.m_start = i+1;
-                        return;
-                    }
-                }
+                it.m_end   = m_kdtree->leaf_end(node, m_level);
             }
             else
             {
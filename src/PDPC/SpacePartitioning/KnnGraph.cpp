@@ -1,7 +1,9 @@
 #include <PDPC/SpacePartitioning/KnnGraph.h>
 #include <PDPC/SpacePartitioning/KdTree.h>
+#include <PDPC/SpacePartitioning/internal/BatchQuery.h>
 
-#include <PDPC/Common/Progress.h>
+#include <algorithm>
+#include <numeric>
 
 namespace pdpc {
 
@@ -38,21 +40,26 @@ void KnnGraph::build(const KdTree& kdtree, bool verbose)
     m_indices = std::make_shared<std::vector<int>>(size * m_k, -1);
     auto& indices = *m_indices.get();
 
-    auto q = kdtree.k_nearest_index_query(m_k);
-
-    auto prog = Progress(size, verbose);
-    #pragma omp parallel for firstprivate(q)
-    for(int i=0; i<size; ++i)
+    // all_knn solves the points in the order of the leaves when the kd-tree
+    // indexes all of them, otherwise each point has its own query
+    std::vector<Index> order = kdtree.index_data();
+    NeighborLists lists;
+    if(int(order.size()) == size)
     {
-        q.set_index(i);
+        lists = kdtree.all_knn(m_k, false, verbose);
+    }
+    else
+    {
+        order.resize(size);
+        std::iota(order.begin(), order.end(), 0);
+        lists = kdtree.batch_knn(order, m_k, false, verbose);
+    }
 
-        int j = 0;
-        for(int n : q)
-        {
-            indices[i * m_k + j] = n;
-            ++j;
-        }
-        ++prog;
+    #pragma omp parallel for
+    for(int n=0; n<size; ++n)
+    {
+        const NeighborLists::Range neighbors = lists.neighbors(n);
+        std::copy(neighbors.begin(), neighbors.end(), indices.begin() + std::size_t(order[n]) * m_k);
     }
 }
 
@@ -72,21 +79,14 @@ void KnnGraph::build(const KdTree& kdtree, const std::vector<int>& indices, bool
 
     m_indices = std::make_shared<std::vector<int>>(size * m_k, -1);
 
-    auto q = kdtree.k_nearest_index_query(m_k);
+    const std::vector<Index> queries(indices.begin(), indices.end());
+    const NeighborLists lists = kdtree.batch_knn(queries, m_k, false, verbose);
 
-    auto prog = Progress(size, verbose);
-    #pragma omp parallel for firstprivate(q)
+    #pragma omp parallel for
     for(int i=0; i<size; ++i)
     {
-        q.set_index(indices[i]);
-
-        int j = 0;
-        for(int n : q)
-        {
-            (*m_indices)[i * m_k + j] = n;
-            ++j;
-        }
-        ++prog;
+        const NeighborLists::Range neighbors = lists.neighbors(i);
+        std::copy(neighbors.begin(), neighbors.end(), m_indices->begin() + std::size_t(i) * m_k);
     }
 }
 
@@ -113,6 +113,32 @@ int KnnGraph::k_neighbor(int idx_point, int i) const
     return m_indices->operator[](idx_point * m_k + i);
 }
 
+// Batch Query -----------------------------------------------------------------
+
+NeighborLists KnnGraph::batch_range(const std::vector<int>& indices, Scalar r,
+                                    bool squared_distances, bool verbose) const
+{
+    const Vector3Array& points = this->point_data();
+
+    NeighborLists lists;
+    internal::batch_query(indices.size(), squared_distances, verbose,
+    [this,r]()
+    {
+        return this->range_query(r);
+    },
+    [&indices,&points,squared_distances](RangeIndexQuery& query, Index q, std::vector<Index>& neighbors, std::vector<Scalar>& distances)
+    {
+        query.set_index(indices[q]);
+        for(int j : query)
+        {
+            neighbors.push_back(j);
+            if(squared_distances) distances.push_back((points[j] - points[indices[q]]).squaredNorm());
+        }
+    },
+    lists);
+    return lists;
+}
+
 // Empty Query -----------------------------------------------------------------
 
 KnnGraphRangeQuery KnnGraph::range_query(Scalar r) const
@@ -2,6 +2,7 @@
 
 #include <PDPC/SpacePartitioning/KnnGraph/Query/KnnGraphQuery.h>
 #include <PDPC/SpacePartitioning/KnnGraph/Query/KnnGraphRangeQuery.h>
+#include <PDPC/SpacePartitioning/NeighborLists.h>
 
 #include <memory>
 
@@ -35,6 +36,18 @@ public:
 
     int k_neighbor(int index, int i) const;
 
+    // Batch Query -------------------------------------------------------------
+public:
+    //!
+    //! \brief batch_range returns the points of range_neighbors(index, r) for
+    //! each index of indices (the point itself included), computed in parallel
+    //!
+    //! Each thread reuses one query, so that the cost of a query is the count
+    //! of points it visits.
+    //!
+    NeighborLists batch_range(const std::vector<int>& indices, Scalar r,
+                              bool squared_distances = false, bool verbose = false) const;
+
     // Empty Query -------------------------------------------------------------
 public:
     RangeIndexQuery range_query(Scalar r = 0) const;
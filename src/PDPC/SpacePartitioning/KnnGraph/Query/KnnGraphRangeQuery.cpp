@@ -7,7 +7,8 @@ namespace pdpc {
 KnnGraphRangeQuery::KnnGraphRangeQuery() :
     RangeIndexQuery(),
     m_graph(nullptr),
-    m_flag(),
+    m_stamps(),
+    m_stamp(0),
     m_stack()
 {
 }
@@ -15,7 +16,8 @@ KnnGraphRangeQuery::KnnGraphRangeQuery() :
 KnnGraphRangeQuery::KnnGraphRangeQuery(const KnnGraph* graph) :
     RangeIndexQuery(),
     m_graph(graph),
-    m_flag(graph->size()),
+    m_stamps(),
+    m_stamp(0),
     m_stack()
 {
 }
@@ -23,7 +25,8 @@ KnnGraphRangeQuery::KnnGraphRangeQuery(const KnnGraph* graph) :
 KnnGraphRangeQuery::KnnGraphRangeQuery(const KnnGraph* graph, Scalar radius) :
     RangeIndexQuery(radius),
     m_graph(graph),
-    m_flag(graph->size()),
+    m_stamps(),
+    m_stamp(0),
     m_stack()
 {
 }
@@ -31,7 +34,8 @@ KnnGraphRangeQuery::KnnGraphRangeQuery(const KnnGraph* graph, Scalar radius) :
 KnnGraphRangeQuery::KnnGraphRangeQuery(const KnnGraph* graph, Scalar radius, int index) :
     RangeIndexQuery(radius, index),
     m_graph(graph),
-    m_flag(graph->size()),
+    m_stamps(),
+    m_stamp(0),
     m_stack()
 {
 }
@@ -51,12 +55,17 @@ KnnGraphRangeIterator KnnGraphRangeQuery::end()
 
 void KnnGraphRangeQuery::initialize(KnnGraphRangeIterator& iterator)
 {
-    m_flag.resize(m_graph->size());
-    std::fill(m_flag.begin(), m_flag.end(), false);
+    // a new stamp marks the points visited by this search
+    if(m_stamps.size() != std::size_t(m_graph->size()) || ++m_stamp == 0)
+    {
+        m_stamps.assign(m_graph->size(), 0);
+        m_stamp = 1;
+    }
 
-    PDPC_DEBUG_ASSERT(m_stack.empty());
-    m_stack.push(m_index);
-    m_flag[m_index] = true;
+    // the previous search may have been left before its end
+    m_stack.clear();
+    m_stack.push_back(m_index);
+    m_stamps[m_index] = m_stamp;
 
     iterator.m_index = -1;
 }
@@ -72,8 +81,8 @@ void KnnGraphRangeQuery::advance(KnnGraphRangeIterator& iterator)
     }
     else
     {
-        int idx_current = m_stack.top();
-        m_stack.pop();
+        int idx_current = m_stack.back();
+        m_stack.pop_back();
 
         PDPC_DEBUG_ASSERT((point - points[idx_current]).squaredNorm() < m_squared_radius);
 
@@ -81,10 +90,10 @@ void KnnGraphRangeQuery::advance(KnnGraphRangeIterator& iterator)
 
         for(int idx_nei : m_graph->k_nearest_neighbors(idx_current))
         {
-            if(!m_flag[idx_nei] && (point - points[idx_nei]).squaredNorm() < m_squared_radius)
+            if(m_stamps[idx_nei] != m_stamp && (point - points[idx_nei]).squaredNorm() < m_squared_radius)
             {
-                m_flag[idx_nei] = true;
-                m_stack.push(idx_nei);
+                m_stamps[idx_nei] = m_stamp;
+                m_stack.push_back(idx_nei);
             }
         }
     }
@@ -3,13 +3,22 @@
 #include <PDPC/SpacePartitioning/Query/RangeIndexQuery.h>
 #include <PDPC/SpacePartitioning/KnnGraph/Iterator/KnnGraphRangeIterator.h>
 
+#include <cstdint>
 #include <vector>
-#include <stack>
 
 namespace pdpc {
 
 class KnnGraph;
 
+//!
+//! \brief The KnnGraphRangeQuery class visits the points connected to the
+//! query point in the kNN graph that are closer than the radius
+//!
+//! The visited points are marked with a stamp that changes at each search, so
+//! that a query reused for several points (see KnnGraph::range_query() and
+//! set_index()) costs the count of visited points rather than the size of the
+//! graph. The stamps are only reset when their counter wraps around.
+//!
 class KnnGraphRangeQuery : public RangeIndexQuery
 {
 protected:
@@ -30,9 +39,10 @@ protected:
     void advance(KnnGraphRangeIterator& iterator);
 
 protected:
-    const KnnGraph*   m_graph;
-    std::vector<bool> m_flag;
-    std::stack<int>   m_stack;
+    const KnnGraph*            m_graph;
+    std::vector<std::uint32_t> m_stamps;
+    std::uint32_t              m_stamp;
+    std::vector<int>           m_stack;
 };
 
 } // namespace pdpc
@@ -0,0 +1,83 @@
+#include <PDPC/SpacePartitioning/NeighborLists.h>
+
+namespace pdpc {
+
+// NeighborLists ---------------------------------------------------------------
+
+NeighborLists::NeighborLists() :
+    m_offsets(1, 0),
+    m_indices(),
+    m_squared_distances()
+{
+}
+
+void NeighborLists::clear()
+{
+    m_offsets.assign(1, 0);
+    m_indices.clear();
+    m_squared_distances.clear();
+}
+
+// Accessors -------------------------------------------------------------------
+
+int NeighborLists::query_count() const
+{
+    return m_offsets.size() - 1;
+}
+
+std::size_t NeighborLists::neighbor_count() const
+{
+    return m_indices.size();
+}
+
+bool NeighborLists::has_squared_distances() const
+{
+    return m_squared_distances.size() == m_indices.size();
+}
+
+int NeighborLists::size(int q) const
+{
+    return m_offsets[q+1] - m_offsets[q];
+}
+
+NeighborLists::Range NeighborLists::neighbors(int q) const
+{
+    return Range{m_indices.data() + m_offsets[q], m_indices.data() + m_offsets[q+1]};
+}
+
+const Scalar* NeighborLists::squared_distances(int q) const
+{
+    return m_squared_distances.data() + m_offsets[q];
+}
+
+const std::vector<std::size_t>& NeighborLists::offset_data() const
+{
+    return m_offsets;
+}
+
+std::vector<std::size_t>& NeighborLists::offset_data()
+{
+    return m_offsets;
+}
+
+const std::vector<Index>& NeighborLists::index_data() const
+{
+    return m_indices;
+}
+
+std::vector<Index>& NeighborLists::index_data()
+{
+    return m_indices;
+}
+
+const std::vector<Scalar>& NeighborLists::squared_distance_data() const
+{
+    return m_squared_distances;
+}
+
+std::vector<Scalar>& NeighborLists::squared_distance_data()
+{
+    return m_squared_distances;
+}
+
+} // namespace pdpc
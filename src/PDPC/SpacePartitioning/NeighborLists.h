@@ -0,0 +1,64 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+
+#include <vector>
+
+namespace pdpc {
+
+//!
+//! \brief The NeighborLists class stores the neighbors of a batch of queries
+//! in compressed sparse rows (CSR)
+//!
+//! The neighbors of the query q are index_data()[offset_data()[q]] to
+//! index_data()[offset_data()[q+1]] (excluded). The squared distances to the
+//! query are stored in the same order if they were requested.
+//!
+class NeighborLists
+{
+    // Types -------------------------------------------------------------------
+public:
+    struct Range
+    {
+        const Index* first;
+        const Index* last;
+
+        const Index* begin() const {return first;}
+        const Index* end()   const {return last;}
+    };
+
+    // NeighborLists -----------------------------------------------------------
+public:
+    NeighborLists();
+
+    void clear();
+
+    // Accessors ---------------------------------------------------------------
+public:
+    int         query_count() const;
+    std::size_t neighbor_count() const;
+    bool        has_squared_distances() const;
+
+    int   size(int q) const;
+    Range neighbors(int q) const;
+
+    //! \brief squared_distances returns the squared distances of the neighbors of q (if has_squared_distances())
+    const Scalar* squared_distances(int q) const;
+
+    const std::vector<std::size_t>& offset_data() const;
+          std::vector<std::size_t>& offset_data();
+
+    const std::vector<Index>& index_data() const;
+          std::vector<Index>& index_data();
+
+    const std::vector<Scalar>& squared_distance_data() const;
+          std::vector<Scalar>& squared_distance_data();
+
+    // Data --------------------------------------------------------------------
+protected:
+    std::vector<std::size_t> m_offsets;
+    std::vector<Index>       m_indices;
+    std::vector<Scalar>      m_squared_distances;
+};
+
+} // namespace pdpc
@@ -0,0 +1,423 @@
+#include <PDPC/SpacePartitioning/Octree.h>
+#include <PDPC/Common/Algorithms/parallel_radix_sort.h>
+#include <PDPC/Common/Assert.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace pdpc {
+
+namespace {
+
+//!
+//! \brief split_node computes the ranges of the children of a node in the
+//! sorted codes, the child d holding the positions [bounds[d], bounds[d+1]),
+//! and returns the count of non-empty children (0 for a leaf)
+//!
+//! The children are split by the highest digit of 3 bits that differs in the
+//! range, i.e. cells whose points all fall in one child are skipped.
+//!
+int split_node(const std::vector<std::uint64_t>& codes, const OctreeNode& node, int min_cell_size, Index bounds[9])
+{
+    if(node.size() <= min_cell_size) return 0;
+
+    const std::uint64_t diff = codes[node.start] ^ codes[node.end-1];
+    if(diff == 0) return 0;
+
+    int high = 63;
+    while(!(diff >> high)) --high;
+    const int shift = 3 * (high / 3);
+
+    // the codes of the range share their bits above the digit
+    const auto first = codes.begin() + node.start;
+    const auto last  = codes.begin() + node.end;
+    int count = 0;
+    bounds[0] = node.start;
+    for(int d=1; d<8; ++d)
+    {
+        bounds[d] = std::partition_point(first, last, [shift,d](std::uint64_t code)
+        {
+            return int((code >> shift) & 7) < d;
+        }) - codes.begin();
+        count += bounds[d] > bounds[d-1];
+    }
+    bounds[8] = node.end;
+    count += bounds[8] > bounds[7];
+    return count;
+}
+
+} // namespace
+
+// Octree ----------------------------------------------------------------------
+
+Octree::Octree() :
+    m_points(nullptr),
+    m_nodes(),
+    m_indices(),
+    m_codes(),
+    m_sorted_points(),
+    m_origin(Vector3::Zero()),
+    m_scale(1),
+    m_min_cell_size(32)
+{
+}
+
+Octree::Octree(std::shared_ptr<Vector3Array>& points) :
+    Octree()
+{
+    this->build(points);
+}
+
+Octree::Octree(std::shared_ptr<Vector3Array>& points, const std::vector<Index>& sampling) :
+    Octree()
+{
+    this->build(points, sampling);
+}
+
+void Octree::clear()
+{
+    m_points = nullptr;
+    m_nodes.clear();
+    m_indices.clear();
+    m_codes.clear();
+    m_sorted_points.clear();
+    m_origin = Vector3::Zero();
+    m_scale  = 1;
+}
+
+void Octree::build(std::shared_ptr<Vector3Array>& points)
+{
+    std::vector<Index> sampling(points->size());
+    std::iota(sampling.begin(), sampling.end(), 0);
+    this->build(points, sampling);
+}
+
+void Octree::build(std::shared_ptr<Vector3Array>& points, const std::vector<Index>& sampling)
+{
+    PDPC_ASSERT_MSG(sampling.size() <= std::size_t(std::numeric_limits<Index>::max()),
+                    "too many points, build with PDPC_INDEX_64");
+
+    this->clear();
+
+    m_points = points;
+
+    const Vector3Array& pts = *m_points.get();
+    const Index size = sampling.size();
+
+    // 1. bounding cube --------------------------------------------------------
+    Aabb aabb;
+    #pragma omp parallel
+    {
+        Aabb local;
+        #pragma omp for nowait
+        for(Index n=0; n<size; ++n)
+            local.extend(pts[sampling[n]]);
+
+        #pragma omp critical (Octree_aabb)
+        aabb.extend(local);
+    }
+
+    const Scalar extent = size > 0 ? aabb.sizes().maxCoeff() : 0;
+    m_origin = size > 0 ? Vector3(aabb.min()) : Vector3::Zero();
+    m_scale  = extent > 0 ? Scalar(1 << code_bits()) / extent : 1;
+
+    // 2. indices sorted by Morton code ----------------------------------------
+    m_indices = sampling;
+    m_codes.resize(size);
+    #pragma omp parallel for
+    for(Index n=0; n<size; ++n)
+        m_codes[n] = this->morton_code(pts[sampling[n]]);
+
+    parallel_radix_sort(m_codes, m_indices, 3 * code_bits());
+
+    m_sorted_points.resize(size);
+    #pragma omp parallel for
+    for(Index n=0; n<size; ++n)
+        m_sorted_points[n] = pts[m_indices[n]];
+
+    // 3. nodes ----------------------------------------------------------------
+    this->build_nodes();
+
+    PDPC_DEBUG_ASSERT(this->valid());
+}
+
+bool Octree::valid() const
+{
+    if(!m_points)
+        return m_nodes.empty() && m_indices.empty();
+
+    const Index size = m_indices.size();
+    if(m_nodes.empty() || m_nodes[0].start != 0 || m_nodes[0].end != size ||
+       Index(m_codes.size()) != size || Index(m_sorted_points.size()) != size)
+    {
+        PDPC_DEBUG_ASSERT(false);
+        return false;
+    }
+
+    for(Index n=0; n<size; ++n)
+    {
+        if((n > 0 && m_codes[n-1] > m_codes[n]) ||
+           m_sorted_points[n] != (*m_points)[m_indices[n]] ||
+           m_codes[n] != this->morton_code(m_sorted_points[n]))
+        {
+            PDPC_DEBUG_ASSERT(false);
+            return false;
+        }
+    }
+
+    for(const OctreeNode& node : m_nodes)
+    {
+        if(node.is_leaf())
+        {
+            for(Index pos=node.start; pos<node.end; ++pos)
+            {
+                if(node.squared_distance(m_sorted_points[pos]) != 0)
+                {
+                    PDPC_DEBUG_ASSERT(false);
+                    return false;
+                }
+            }
+        }
+        else
+        {
+            // the children partition the range of their parent
+            Index start = node.start;
+            for(int c=0; c<node.child_count; ++c)
+            {
+                const OctreeNode& child = m_nodes[node.first_child + c];
+                if(child.start != start || child.end <= child.start ||
+                   (child.min.array() < node.min.array()).any() ||
+                   (child.max.array() > node.max.array()).any())
+                {
+                    PDPC_DEBUG_ASSERT(false);
+                    return false;
+                }
+                start = child.end;
+            }
+            if(start != node.end)
+            {
+                PDPC_DEBUG_ASSERT(false);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Query -----------------------------------------------------------------------
+
+OctreeKNearestPointQuery Octree::k_nearest_neighbors(const Vector3& point, int k) const
+{
+    return KNearestPointQuery(this, k, point);
+}
+
+OctreeKNearestIndexQuery Octree::k_nearest_neighbors(Index index, int k) const
+{
+    return KNearestIndexQuery(this, k, index);
+}
+
+OctreeNearestPointQuery Octree::nearest_neighbor(const Vector3& point) const
+{
+    return NearestPointQuery(this, point);
+}
+
+OctreeNearestIndexQuery Octree::nearest_neighbor(Index index) const
+{
+    return NearestIndexQuery(this, index);
+}
+
+OctreeRangePointQuery Octree::range_neighbors(const Vector3& point, Scalar r) const
+{
+    return RangePointQuery(this, r, point);
+}
+
+OctreeRangeIndexQuery Octree::range_neighbors(Index index, Scalar r) const
+{
+    return RangeIndexQuery(this, r, index);
+}
+
+// Empty Query -----------------------------------------------------------------
+
+OctreeKNearestPointQuery Octree::k_nearest_point_query(int k) const
+{
+    return KNearestPointQuery(this, k);
+}
+
+OctreeKNearestIndexQuery Octree::k_nearest_index_query(int k) const
+{
+    return KNearestIndexQuery(this, k);
+}
+
+OctreeNearestPointQuery Octree::nearest_point_query() const
+{
+    return NearestPointQuery(this);
+}
+
+OctreeNearestIndexQuery Octree::nearest_index_query() const
+{
+    return NearestIndexQuery(this);
+}
+
+OctreeRangePointQuery Octree::range_point_query(Scalar r) const
+{
+    return RangePointQuery(this, r);
+}
+
+OctreeRangeIndexQuery Octree::range_index_query(Scalar r) const
+{
+    return RangeIndexQuery(this, r);
+}
+
+// Accessors -------------------------------------------------------------------
+
+Index Octree::node_count() const
+{
+    return m_nodes.size();
+}
+
+Index Octree::index_count() const
+{
+    return m_indices.size();
+}
+
+Index Octree::point_count() const
+{
+    return m_points ? Index(m_points->size()) : 0;
+}
+
+const Vector3Array& Octree::point_data() const
+{
+    return *m_points.get();
+}
+
+const std::shared_ptr<Vector3Array>& Octree::point_ptr() const
+{
+    return m_points;
+}
+
+const std::vector<OctreeNode>& Octree::node_data() const
+{
+    return m_nodes;
+}
+
+const std::vector<Index>& Octree::index_data() const
+{
+    return m_indices;
+}
+
+const std::vector<std::uint64_t>& Octree::code_data() const
+{
+    return m_codes;
+}
+
+const Vector3Array& Octree::sorted_point_data() const
+{
+    return m_sorted_points;
+}
+
+// Parameters ------------------------------------------------------------------
+
+int Octree::min_cell_size() const
+{
+    return m_min_cell_size;
+}
+
+void Octree::set_min_cell_size(int min_cell_size)
+{
+    PDPC_DEBUG_ASSERT(min_cell_size > 0);
+    m_min_cell_size = min_cell_size;
+}
+
+// Internal --------------------------------------------------------------------
+
+void Octree::build_nodes()
+{
+    constexpr Scalar max = std::numeric_limits<Scalar>::max();
+
+    OctreeNode root;
+    root.start       = 0;
+    root.end         = m_indices.size();
+    root.first_child = -1;
+    root.child_count = 0;
+    root.min         = Vector3::Constant( max);
+    root.max         = Vector3::Constant(-max);
+
+    m_nodes.assign(1, root);
+
+    // 1. nodes, level by level ------------------------------------------------
+    std::vector<Index> level_starts(1, 0);
+    std::vector<int>   child_counts;
+    Index begin = 0;
+    Index end   = 1;
+    while(begin < end)
+    {
+        child_counts.resize(end - begin);
+
+        #pragma omp parallel for
+        for(Index i=begin; i<end; ++i)
+        {
+            Index bounds[9];
+            child_counts[i-begin] = split_node(m_codes, m_nodes[i], m_min_cell_size, bounds);
+        }
+
+        Index offset = end;
+        for(Index i=begin; i<end; ++i)
+        {
+            m_nodes[i].first_child = child_counts[i-begin] > 0 ? offset : -1;
+            m_nodes[i].child_count = child_counts[i-begin];
+            offset += child_counts[i-begin];
+        }
+        m_nodes.resize(offset, root);
+
+        #pragma omp parallel for
+        for(Index i=begin; i<end; ++i)
+        {
+            if(m_nodes[i].is_leaf()) continue;
+
+            Index bounds[9];
+            split_node(m_codes, m_nodes[i], m_min_cell_size, bounds);
+
+            Index child = m_nodes[i].first_child;
+            for(int d=0; d<8; ++d)
+            {
+                if(bounds[d] == bounds[d+1]) continue;
+                m_nodes[child].start = bounds[d];
+                m_nodes[child].end   = bounds[d+1];
+                ++child;
+            }
+        }
+
+        level_starts.push_back(end);
+        begin = end;
+        end   = offset;
+    }
+
+    // 2. boxes, from the leaves up --------------------------------------------
+    for(int level=int(level_starts.size())-2; level>=0; --level)
+    {
+        #pragma omp parallel for
+        for(Index i=level_starts[level]; i<level_starts[level+1]; ++i)
+        {
+            OctreeNode& node = m_nodes[i];
+            if(node.is_leaf())
+            {
+                for(Index pos=node.start; pos<node.end; ++pos)
+                {
+                    node.min = node.min.cwiseMin(m_sorted_points[pos]);
+                    node.max = node.max.cwiseMax(m_sorted_points[pos]);
+                }
+            }
+            else
+            {
+                for(int c=0; c<node.child_count; ++c)
+                {
+                    node.min = node.min.cwiseMin(m_nodes[node.first_child + c].min);
+                    node.max = node.max.cwiseMax(m_nodes[node.first_child + c].max);
+                }
+            }
+        }
+    }
+}
+
+} // namespace pdpc
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <PDPC/SpacePartitioning/Octree/OctreeNode.h>
+
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeKNearestIndexQuery.h>
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeKNearestPointQuery.h>
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeNearestIndexQuery.h>
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeNearestPointQuery.h>
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeRangeIndexQuery.h>
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeRangePointQuery.h>
+
+#include <cstdint>
+#include <memory>
+
+namespace pdpc {
+
+//!
+//! \brief The Octree class is a linear octree built from the Morton codes of
+//! the points
+//!
+//! The points are quantized on 21 bits per axis in the bounding cube of the
+//! points, their coordinates are interleaved in 63-bit Morton codes, and the
+//! indices are radix sorted by code. The points of any octree cell are then
+//! contiguous, and the nodes are the Morton prefixes where the sorted codes
+//! split, built breadth first with parallel passes. Cells with a single child
+//! are skipped, so that the depth is at most 21.
+//!
+//! The points are also copied in the Morton order, so that the traversals
+//! read the memory mostly sequentially. The Morton order of index_data() is
+//! a spatial reordering of the points, and tile_key() groups them by cells
+//! of a given depth.
+//!
+class Octree
+{
+    // Types -------------------------------------------------------------------
+public:
+    using KNearestPointQuery = OctreeKNearestPointQuery;
+    using KNearestIndexQuery = OctreeKNearestIndexQuery;
+    using NearestPointQuery  = OctreeNearestPointQuery;
+    using NearestIndexQuery  = OctreeNearestIndexQuery;
+    using RangePointQuery    = OctreeRangePointQuery;
+    using RangeIndexQuery    = OctreeRangeIndexQuery;
+
+    // Octree ------------------------------------------------------------------
+public:
+    Octree();
+    Octree(std::shared_ptr<Vector3Array>& points);
+    Octree(std::shared_ptr<Vector3Array>& points, const std::vector<Index>& sampling);
+
+    void clear();
+    void build(std::shared_ptr<Vector3Array>& points);
+    void build(std::shared_ptr<Vector3Array>& points, const std::vector<Index>& sampling);
+
+    bool valid() const;
+
+    // Query -------------------------------------------------------------------
+public:
+    KNearestPointQuery k_nearest_neighbors(const Vector3& point, int k) const;
+    KNearestIndexQuery k_nearest_neighbors(Index index, int k) const;
+    NearestPointQuery  nearest_neighbor(const Vector3& point) const;
+    NearestIndexQuery  nearest_neighbor(Index index) const;
+    RangePointQuery    range_neighbors(const Vector3& point, Scalar r) const;
+    RangeIndexQuery    range_neighbors(Index index, Scalar r) const;
+
+    // Visitor Query -----------------------------------------------------------
+public:
+    //!
+    //! \brief for_each_in_range calls f(index, squared_distance) for each point
+    //! closer than r, in the order of range_neighbors
+    //!
+    //! f may return a bool, false to stop the traversal, in which case
+    //! for_each_in_range returns false (see KdTree::for_each_in_range).
+    //!
+    template<class VisitorT>
+    bool for_each_in_range(const Vector3& point, Scalar r, VisitorT&& f) const;
+
+    //! \brief for_each_in_range visits the neighbors of the point index, excluding itself
+    template<class VisitorT>
+    bool for_each_in_range(Index index, Scalar r, VisitorT&& f) const;
+
+    // Empty Query -------------------------------------------------------------
+public:
+    KNearestPointQuery k_nearest_point_query(int k = 0) const;
+    KNearestIndexQuery k_nearest_index_query(int k = 0) const;
+    NearestPointQuery  nearest_point_query() const;
+    NearestIndexQuery  nearest_index_query() const;
+    RangePointQuery    range_point_query(Scalar r = 0) const;
+    RangeIndexQuery    range_index_query(Scalar r = 0) const;
+
+    // Morton codes ------------------------------------------------------------
+public:
+    static constexpr int code_bits() {return 21;}
+
+    //! \brief morton_code interleaves the bits of the quantized coordinates, x being the most significant
+    static inline std::uint64_t morton_code(std::uint32_t x, std::uint32_t y, std::uint32_t z);
+
+    //! \brief morton_code returns the code of a point quantized in the bounding cube of the octree
+    inline std::uint64_t morton_code(const Vector3& point) const;
+
+    //!
+    //! \brief tile_key returns the prefix of code identifying its cell at the
+    //! given depth (0 for the root, code_bits() for the finest cells)
+    //!
+    //! The points of a tile are contiguous in index_data().
+    //!
+    static inline std::uint64_t tile_key(std::uint64_t code, int depth);
+
+    // Accessors ---------------------------------------------------------------
+public:
+    Index node_count() const;
+    Index index_count() const;
+    Index point_count() const;
+
+    const Vector3Array& point_data() const;
+
+    const std::shared_ptr<Vector3Array>& point_ptr() const;
+
+    const std::vector<OctreeNode>& node_data() const;
+
+    //! \brief index_data gives the indexed points in the Morton order
+    const std::vector<Index>& index_data() const;
+
+    //! \brief code_data gives the sorted Morton codes of the points of index_data()
+    const std::vector<std::uint64_t>& code_data() const;
+
+    //! \brief sorted_point_data gives the points in the order of index_data()
+    const Vector3Array& sorted_point_data() const;
+
+    // Parameters --------------------------------------------------------------
+public:
+    int min_cell_size() const;
+    void set_min_cell_size(int min_cell_size);
+
+    // Internal ----------------------------------------------------------------
+public:
+    //!
+    //! \brief build_nodes builds the nodes from the sorted codes, one level
+    //! after the other, then computes their boxes from the leaves up
+    //!
+    void build_nodes();
+
+    //!
+    //! \brief push_children pushes the children of node closer than bound,
+    //! the closest on top if closest_first, in the Morton order otherwise
+    //!
+    template<class StackT>
+    inline void push_children(StackT& stack, const OctreeNode& node, const Vector3& point,
+                              Scalar bound, bool closest_first) const;
+
+    template<class VisitorT>
+    bool visit_range(const Vector3& point, Scalar squared_radius, Index excluded, VisitorT& f) const;
+
+    // Data --------------------------------------------------------------------
+protected:
+    std::shared_ptr<Vector3Array> m_points;
+    std::vector<OctreeNode>       m_nodes;
+    std::vector<Index>            m_indices;       //!< indexed points in the Morton order
+    std::vector<std::uint64_t>    m_codes;         //!< Morton codes of m_indices
+    Vector3Array                  m_sorted_points; //!< points in the order of m_indices
+    Vector3                       m_origin;        //!< min corner of the bounding cube
+    Scalar                        m_scale;         //!< quantization scale of the coordinates
+
+    int m_min_cell_size;
+};
+
+} // namespace pdpc
+
+#include <PDPC/SpacePartitioning/Octree.inl>
+#include <PDPC/SpacePartitioning/Octree.hpp>
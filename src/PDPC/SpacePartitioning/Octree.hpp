@@ -0,0 +1,79 @@
+#include <PDPC/SpacePartitioning/Octree.h>
+#include <PDPC/SpacePartitioning/internal/NeighborVisitor.h>
+
+namespace pdpc {
+
+// Visitor Query ---------------------------------------------------------------
+
+template<class VisitorT>
+bool Octree::for_each_in_range(const Vector3& point, Scalar r, VisitorT&& f) const
+{
+    return this->visit_range(point, r * r, -1, f);
+}
+
+template<class VisitorT>
+bool Octree::for_each_in_range(Index index, Scalar r, VisitorT&& f) const
+{
+    return this->visit_range(this->point_data()[index], r * r, index, f);
+}
+
+template<class VisitorT>
+bool Octree::visit_range(const Vector3& point, Scalar squared_radius, Index excluded, VisitorT& f) const
+{
+    static_stack<IndexSquaredDistance, PDPC_OCTREE_STACK_SIZE> stack;
+    if(m_nodes[0].squared_distance(point) < squared_radius)
+        stack.push({0,0});
+
+    while(!stack.empty())
+    {
+        const OctreeNode& node = m_nodes[stack.top().index];
+        stack.pop();
+
+        if(node.is_leaf())
+        {
+            for(Index pos=node.start; pos<node.end; ++pos)
+            {
+                const Scalar d2 = (point - m_sorted_points[pos]).squaredNorm();
+                if(d2 < squared_radius && m_indices[pos] != excluded)
+                {
+                    if(!internal::visit_neighbor(f, m_indices[pos], d2))
+                        return false;
+                }
+            }
+        }
+        else
+        {
+            this->push_children(stack, node, point, squared_radius, false);
+        }
+    }
+    return true;
+}
+
+// Internal --------------------------------------------------------------------
+
+template<class StackT>
+void Octree::push_children(StackT& stack, const OctreeNode& node, const Vector3& point,
+                           Scalar bound, bool closest_first) const
+{
+    IndexSquaredDistance children[8];
+    int count = 0;
+    for(int c=node.child_count-1; c>=0; --c)
+    {
+        const Index  id = node.first_child + c;
+        const Scalar d2 = m_nodes[id].squared_distance(point);
+        if(d2 >= bound) continue;
+
+        // insertion by decreasing distance, the last pushed being on top
+        int i = count++;
+        if(closest_first)
+        {
+            for(; i>0 && children[i-1].squared_distance < d2; --i)
+                children[i] = children[i-1];
+        }
+        children[i] = {id, d2};
+    }
+    for(int i=0; i<count; ++i)
+        stack.push(children[i]);
+}
+
+} // namespace pdpc
@@ -0,0 +1,48 @@
+#include <PDPC/SpacePartitioning/Octree.h>
+
+#include <algorithm>
+
+namespace pdpc {
+
+// Morton codes ----------------------------------------------------------------
+
+namespace internal {
+
+//! \brief spread_bits inserts two zeros between the 21 lower bits of x
+inline std::uint64_t spread_bits(std::uint32_t x)
+{
+    std::uint64_t v = x & 0x1FFFFF;
+    v = (v | (v << 32)) & 0x001F00000000FFFFull;
+    v = (v | (v << 16)) & 0x001F0000FF0000FFull;
+    v = (v | (v <<  8)) & 0x100F00F00F00F00Full;
+    v = (v | (v <<  4)) & 0x10C30C30C30C30C3ull;
+    v = (v | (v <<  2)) & 0x1249249249249249ull;
+    return v;
+}
+
+} // namespace internal
+
+std::uint64_t Octree::morton_code(std::uint32_t x, std::uint32_t y, std::uint32_t z)
+{
+    return (internal::spread_bits(x) << 2) | (internal::spread_bits(y) << 1) | internal::spread_bits(z);
+}
+
+std::uint64_t Octree::morton_code(const Vector3& point) const
+{
+    constexpr Scalar cell_max = (1 << code_bits()) - 1;
+
+    std::uint32_t q[3];
+    for(int k=0; k<3; ++k)
+    {
+        const Scalar c = (point[k] - m_origin[k]) * m_scale;
+        q[k] = c <= 0 ? 0 : c >= cell_max ? std::uint32_t(cell_max) : std::uint32_t(c);
+    }
+    return morton_code(q[0], q[1], q[2]);
+}
+
+std::uint64_t Octree::tile_key(std::uint64_t code, int depth)
+{
+    return code >> (3 * (code_bits() - depth));
+}
+
+} // namespace pdpc
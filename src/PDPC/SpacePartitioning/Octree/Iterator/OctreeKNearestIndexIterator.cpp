@@ -0,0 +1,35 @@
+#include <PDPC/SpacePartitioning/Octree/Iterator/OctreeKNearestIndexIterator.h>
+
+namespace pdpc {
+
+OctreeKNearestIndexIterator::OctreeKNearestIndexIterator() :
+    m_iterator()
+{
+}
+
+OctreeKNearestIndexIterator::OctreeKNearestIndexIterator(limited_priority_queue<IndexSquaredDistance>::iterator iterator) :
+    m_iterator(iterator)
+{
+}
+
+bool OctreeKNearestIndexIterator::operator !=(const OctreeKNearestIndexIterator& other) const
+{
+    return m_iterator != other.m_iterator;
+}
+
+void OctreeKNearestIndexIterator::operator ++()
+{
+    ++m_iterator;
+}
+
+Index OctreeKNearestIndexIterator::operator * () const
+{
+    return m_iterator->index;
+}
+
+void OctreeKNearestIndexIterator::operator +=(int i)
+{
+    m_iterator += i;
+}
+
+} // namespace pdpc
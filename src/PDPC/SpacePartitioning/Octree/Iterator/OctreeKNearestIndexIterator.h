@@ -0,0 +1,23 @@
+#pragma once
+
+#include <PDPC/SpacePartitioning/Query/KNearestQuery.h>
+
+namespace pdpc {
+
+class OctreeKNearestIndexIterator
+{
+public:
+    OctreeKNearestIndexIterator();
+    OctreeKNearestIndexIterator(limited_priority_queue<IndexSquaredDistance>::iterator iterator);
+
+public:
+    bool operator !=(const OctreeKNearestIndexIterator& other) const;
+    void operator ++();
+    Index operator * () const;
+    void operator +=(int i);
+
+protected:
+    limited_priority_queue<IndexSquaredDistance>::iterator m_iterator;
+};
+
+} // namespace pdpc
@@ -0,0 +1,30 @@
+#include <PDPC/SpacePartitioning/Octree/Iterator/OctreeKNearestPointIterator.h>
+
+namespace pdpc {
+
+OctreeKNearestPointIterator::OctreeKNearestPointIterator() :
+    m_iterator()
+{
+}
+
+OctreeKNearestPointIterator::OctreeKNearestPointIterator(limited_priority_queue<IndexSquaredDistance>::iterator iterator) :
+    m_iterator(iterator)
+{
+}
+
+bool OctreeKNearestPointIterator::operator !=(const OctreeKNearestPointIterator& other) const
+{
+    return m_iterator != other.m_iterator;
+}
+
+void OctreeKNearestPointIterator::operator ++()
+{
+    ++m_iterator;
+}
+
+Index OctreeKNearestPointIterator::operator * () const
+{
+    return m_iterator->index;
+}
+
+} // namespace pdpc
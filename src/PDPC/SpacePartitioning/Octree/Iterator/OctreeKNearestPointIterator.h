@@ -0,0 +1,22 @@
+#pragma once
+
+#include <PDPC/SpacePartitioning/Query/KNearestQuery.h>
+
+namespace pdpc {
+
+class OctreeKNearestPointIterator
+{
+public:
+    OctreeKNearestPointIterator();
+    OctreeKNearestPointIterator(limited_priority_queue<IndexSquaredDistance>::iterator iterator);
+
+public:
+    bool operator !=(const OctreeKNearestPointIterator& other) const;
+    void operator ++();
+    Index operator * () const;
+
+protected:
+    limited_priority_queue<IndexSquaredDistance>::iterator m_iterator;
+};
+
+} // namespace pdpc
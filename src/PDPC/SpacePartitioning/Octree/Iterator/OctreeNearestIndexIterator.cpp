@@ -0,0 +1,30 @@
+#include <PDPC/SpacePartitioning/Octree/Iterator/OctreeNearestIndexIterator.h>
+
+namespace pdpc {
+
+OctreeNearestIndexIterator::OctreeNearestIndexIterator() :
+    m_index(-1)
+{
+}
+
+OctreeNearestIndexIterator::OctreeNearestIndexIterator(Index index) :
+    m_index(index)
+{
+}
+
+bool OctreeNearestIndexIterator::operator !=(const OctreeNearestIndexIterator& other) const
+{
+    return m_index != other.m_index;
+}
+
+void OctreeNearestIndexIterator::operator ++()
+{
+    ++m_index;
+}
+
+Index OctreeNearestIndexIterator::operator * () const
+{
+    return m_index;
+}
+
+} // namespace pdpc
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+
+namespace pdpc {
+
+class OctreeNearestIndexIterator
+{
+public:
+    OctreeNearestIndexIterator();
+    OctreeNearestIndexIterator(Index index);
+
+public:
+    bool operator !=(const OctreeNearestIndexIterator& other) const;
+    void operator ++();
+    Index operator * () const;
+
+protected:
+    Index m_index;
+};
+
+} // namespace pdpc
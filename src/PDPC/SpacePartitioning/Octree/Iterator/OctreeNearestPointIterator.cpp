@@ -0,0 +1,30 @@
+#include <PDPC/SpacePartitioning/Octree/Iterator/OctreeNearestPointIterator.h>
+
+namespace pdpc {
+
+OctreeNearestPointIterator::OctreeNearestPointIterator() :
+    m_index(-1)
+{
+}
+
+OctreeNearestPointIterator::OctreeNearestPointIterator(Index index) :
+    m_index(index)
+{
+}
+
+bool OctreeNearestPointIterator::operator !=(const OctreeNearestPointIterator& other) const
+{
+    return m_index != other.m_index;
+}
+
+void OctreeNearestPointIterator::operator ++()
+{
+    ++m_index;
+}
+
+Index OctreeNearestPointIterator::operator * () const
+{
+    return m_index;
+}
+
+} // namespace pdpc
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+
+namespace pdpc {
+
+class OctreeNearestPointIterator
+{
+public:
+    OctreeNearestPointIterator();
+    OctreeNearestPointIterator(Index index);
+
+public:
+    bool operator !=(const OctreeNearestPointIterator& other) const;
+    void operator ++();
+    Index operator * () const;
+
+protected:
+    Index m_index;
+};
+
+} // namespace pdpc
@@ -0,0 +1,53 @@
+#include <PDPC/SpacePartitioning/Octree/Iterator/OctreeRangeIndexIterator.h>
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeRangeIndexQuery.h>
+
+namespace pdpc {
+
+OctreeRangeIndexIterator::OctreeRangeIndexIterator() :
+    m_query(nullptr),
+    m_index(-1),
+    m_start(0),
+    m_end(0),
+    m_squared_distance(0)
+{
+}
+
+OctreeRangeIndexIterator::OctreeRangeIndexIterator(OctreeRangeIndexQuery* query) :
+    m_query(query),
+    m_index(-1),
+    m_start(0),
+    m_end(0),
+    m_squared_distance(0)
+{
+}
+
+OctreeRangeIndexIterator::OctreeRangeIndexIterator(OctreeRangeIndexQuery* query, Index index) :
+    m_query(query),
+    m_index(index),
+    m_start(0),
+    m_end(0),
+    m_squared_distance(0)
+{
+}
+
+bool OctreeRangeIndexIterator::operator !=(const OctreeRangeIndexIterator& other) const
+{
+    return m_index != other.m_index;
+}
+
+void OctreeRangeIndexIterator::operator ++()
+{
+    m_query->advance(*this);
+}
+
+Index OctreeRangeIndexIterator::operator * () const
+{
+    return m_index;
+}
+
+Scalar OctreeRangeIndexIterator::squared_distance() const
+{
+    return m_squared_distance;
+}
+
+} // namespace pdpc
@@ -0,0 +1,53 @@
+#include <PDPC/SpacePartitioning/Octree/Iterator/OctreeRangePointIterator.h>
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeRangePointQuery.h>
+
+namespace pdpc {
+
+OctreeRangePointIterator::OctreeRangePointIterator() :
+    m_query(nullptr),
+    m_index(-1),
+    m_start(0),
+    m_end(0),
+    m_squared_distance(0)
+{
+}
+
+OctreeRangePointIterator::OctreeRangePointIterator(OctreeRangePointQuery* query) :
+    m_query(query),
+    m_index(-1),
+    m_start(0),
+    m_end(0),
+    m_squared_distance(0)
+{
+}
+
+OctreeRangePointIterator::OctreeRangePointIterator(OctreeRangePointQuery* query, Index index) :
+    m_query(query),
+    m_index(index),
+    m_start(0),
+    m_end(0),
+    m_squared_distance(0)
+{
+}
+
+bool OctreeRangePointIterator::operator !=(const OctreeRangePointIterator& other) const
+{
+    return m_index != other.m_index;
+}
+
+void OctreeRangePointIterator::operator ++()
+{
+    m_query->advance(*this);
+}
+
+Index OctreeRangePointIterator::operator * () const
+{
+    return m_index;
+}
+
+Scalar OctreeRangePointIterator::squared_distance() const
+{
+    return m_squared_distance;
+}
+
+} // namespace pdpc
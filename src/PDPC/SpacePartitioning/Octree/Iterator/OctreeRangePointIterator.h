@@ -0,0 +1,35 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+
+namespace pdpc {
+
+class OctreeRangePointQuery;
+
+class OctreeRangePointIterator
+{
+protected:
+    friend class OctreeRangePointQuery;
+
+public:
+    OctreeRangePointIterator();
+    OctreeRangePointIterator(OctreeRangePointQuery* query);
+    OctreeRangePointIterator(OctreeRangePointQuery* query, Index index);
+
+public:
+    bool operator !=(const OctreeRangePointIterator& other) const;
+    void operator ++();
+    Index operator * () const;
+
+    //! \brief squared_distance returns the squared distance of the current neighbor to the query
+    Scalar squared_distance() const;
+
+protected:
+    OctreeRangePointQuery* m_query;
+    Index  m_index;
+    Index  m_start; //!< position of the next point of the current leaf
+    Index  m_end;
+    Scalar m_squared_distance;
+};
+
+} // namespace pdpc
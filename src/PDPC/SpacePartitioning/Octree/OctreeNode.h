@@ -0,0 +1,42 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+
+#include <algorithm>
+
+namespace pdpc {
+
+//!
+//! \brief The OctreeNode struct is a cell of the linear octree, either an
+//! inner node (its children are contiguous) or a leaf, with the range of its
+//! points in the Morton order and their bounding box
+//!
+//! The box is the tight bounding box of the points rather than the cube of
+//! the cell, so that the queries prune more nodes on surfaces.
+//!
+struct OctreeNode
+{
+    Index   start;
+    Index   end;
+    Index   first_child;
+    int     child_count; //!< 0 for a leaf
+    Vector3 min;
+    Vector3 max;
+
+    bool  is_leaf() const {return child_count == 0;}
+    Index size() const {return end - start;}
+
+    //! \brief squared_distance returns the squared distance from point to the box, 0 inside
+    inline Scalar squared_distance(const Vector3& point) const
+    {
+        Scalar d2 = 0;
+        for(int k=0; k<3; ++k)
+        {
+            const Scalar d = std::max({min[k] - point[k], point[k] - max[k], Scalar(0)});
+            d2 += d * d;
+        }
+        return d2;
+    }
+};
+
+} // namespace pdpc
@@ -0,0 +1,75 @@
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeKNearestIndexQuery.h>
+#include <PDPC/SpacePartitioning/Octree.h>
+
+#include <algorithm>
+
+namespace pdpc {
+
+OctreeKNearestIndexQuery::OctreeKNearestIndexQuery() :
+    OctreeQuery(),
+    KNearestIndexQuery()
+{
+}
+
+OctreeKNearestIndexQuery::OctreeKNearestIndexQuery(const Octree* octree, int k) :
+    OctreeQuery(octree),
+    KNearestIndexQuery(k)
+{
+}
+
+OctreeKNearestIndexQuery::OctreeKNearestIndexQuery(const Octree* octree, int k, Index index) :
+    OctreeQuery(octree),
+    KNearestIndexQuery(k, index)
+{
+}
+
+OctreeKNearestIndexIterator OctreeKNearestIndexQuery::begin()
+{
+    this->search();
+    return OctreeKNearestIndexIterator(m_queue.begin());
+}
+
+OctreeKNearestIndexIterator OctreeKNearestIndexQuery::end()
+{
+    return OctreeKNearestIndexIterator(m_queue.end());
+}
+
+const limited_priority_queue<IndexSquaredDistance>& OctreeKNearestIndexQuery::search()
+{
+    const auto& nodes   = m_octree->node_data();
+    const auto& indices = m_octree->index_data();
+    const auto& points  = m_octree->sorted_point_data();
+    const auto& point   = m_octree->point_data()[m_index];
+
+    m_stack.clear();
+    m_stack.push({0,0});
+
+    m_queue.clear();
+    m_queue.push({-1,std::numeric_limits<Scalar>::max()});
+
+    while(!m_stack.empty())
+    {
+        const IndexSquaredDistance qnode = m_stack.top();
+        m_stack.pop();
+        if(qnode.squared_distance >= m_queue.bottom().squared_distance) continue;
+
+        const OctreeNode& node = nodes[qnode.index];
+        if(node.is_leaf())
+        {
+            for(Index pos=node.start; pos<node.end; ++pos)
+            {
+                if(indices[pos] == m_index) continue;
+                const Scalar d2 = (point - points[pos]).squaredNorm();
+                if(d2 < m_queue.bottom().squared_distance)
+                    m_queue.push({indices[pos], d2});
+            }
+        }
+        else
+        {
+            m_octree->push_children(m_stack, node, point, m_queue.bottom().squared_distance, true);
+        }
+    }
+    return m_queue;
+}
+
+} // namespace pdpc
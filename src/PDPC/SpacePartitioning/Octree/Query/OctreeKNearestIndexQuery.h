@@ -0,0 +1,25 @@
+#pragma once
+
+#include <PDPC/SpacePartitioning/Query/KNearestIndexQuery.h>
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeQuery.h>
+#include <PDPC/SpacePartitioning/Octree/Iterator/OctreeKNearestIndexIterator.h>
+
+namespace pdpc {
+
+class OctreeKNearestIndexQuery : public OctreeQuery,
+                                 public KNearestIndexQuery
+{
+public:
+    OctreeKNearestIndexQuery();
+    OctreeKNearestIndexQuery(const Octree* octree, int k);
+    OctreeKNearestIndexQuery(const Octree* octree, int k, Index index);
+
+public:
+    OctreeKNearestIndexIterator begin();
+    OctreeKNearestIndexIterator end();
+
+public:
+    const limited_priority_queue<IndexSquaredDistance>& search();
+};
+
+} // namespace pdpc
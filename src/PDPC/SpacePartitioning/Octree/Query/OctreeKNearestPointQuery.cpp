@@ -0,0 +1,74 @@
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeKNearestPointQuery.h>
+#include <PDPC/SpacePartitioning/Octree.h>
+
+#include <algorithm>
+
+namespace pdpc {
+
+OctreeKNearestPointQuery::OctreeKNearestPointQuery() :
+    OctreeQuery(),
+    KNearestPointQuery()
+{
+}
+
+OctreeKNearestPointQuery::OctreeKNearestPointQuery(const Octree* octree, int k) :
+    OctreeQuery(octree),
+    KNearestPointQuery(k)
+{
+}
+
+OctreeKNearestPointQuery::OctreeKNearestPointQuery(const Octree* octree, int k, const Vector3& point) :
+    OctreeQuery(octree),
+    KNearestPointQuery(k, point)
+{
+}
+
+OctreeKNearestPointIterator OctreeKNearestPointQuery::begin()
+{
+    this->search();
+    return OctreeKNearestPointIterator(m_queue.begin());
+}
+
+OctreeKNearestPointIterator OctreeKNearestPointQuery::end()
+{
+    return OctreeKNearestPointIterator(m_queue.end());
+}
+
+const limited_priority_queue<IndexSquaredDistance>& OctreeKNearestPointQuery::search()
+{
+    const auto& nodes   = m_octree->node_data();
+    const auto& indices = m_octree->index_data();
+    const auto& points  = m_octree->sorted_point_data();
+    const auto& point   = m_point;
+
+    m_stack.clear();
+    m_stack.push({0,0});
+
+    m_queue.clear();
+    m_queue.push({-1,std::numeric_limits<Scalar>::max()});
+
+    while(!m_stack.empty())
+    {
+        const IndexSquaredDistance qnode = m_stack.top();
+        m_stack.pop();
+        if(qnode.squared_distance >= m_queue.bottom().squared_distance) continue;
+
+        const OctreeNode& node = nodes[qnode.index];
+        if(node.is_leaf())
+        {
+            for(Index pos=node.start; pos<node.end; ++pos)
+            {
+                const Scalar d2 = (point - points[pos]).squaredNorm();
+                if(d2 < m_queue.bottom().squared_distance)
+                    m_queue.push({indices[pos], d2});
+            }
+        }
+        else
+        {
+            m_octree->push_children(m_stack, node, point, m_queue.bottom().squared_distance, true);
+        }
+    }
+    return m_queue;
+}
+
+} // namespace pdpc
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <PDPC/SpacePartitioning/Query/KNearestPointQuery.h>
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeQuery.h>
+#include <PDPC/SpacePartitioning/Octree/Iterator/OctreeKNearestPointIterator.h>
+
+namespace pdpc {
+
+class OctreeKNearestPointQuery : public OctreeQuery,
+                                 public KNearestPointQuery
+{
+public:
+    OctreeKNearestPointQuery();
+    OctreeKNearestPointQuery(const Octree* octree, int k);
+    OctreeKNearestPointQuery(const Octree* octree, int k, const Vector3& point);
+
+public:
+    OctreeKNearestPointIterator begin();
+    OctreeKNearestPointIterator end();
+
+public:
+    const limited_priority_queue<IndexSquaredDistance>& search();
+};
+
+} // namespace pdpc
@@ -0,0 +1,78 @@
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeNearestIndexQuery.h>
+#include <PDPC/SpacePartitioning/Octree.h>
+
+#include <algorithm>
+
+namespace pdpc {
+
+OctreeNearestIndexQuery::OctreeNearestIndexQuery() :
+    OctreeQuery(),
+    NearestIndexQuery()
+{
+}
+
+OctreeNearestIndexQuery::OctreeNearestIndexQuery(const Octree* octree) :
+    OctreeQuery(octree),
+    NearestIndexQuery()
+{
+}
+
+OctreeNearestIndexQuery::OctreeNearestIndexQuery(const Octree* octree, Index index) :
+    OctreeQuery(octree),
+    NearestIndexQuery(index)
+{
+}
+
+OctreeNearestIndexIterator OctreeNearestIndexQuery::begin()
+{
+    this->search();
+    return OctreeNearestIndexIterator(m_nearest);
+}
+
+OctreeNearestIndexIterator OctreeNearestIndexQuery::end()
+{
+    return OctreeNearestIndexIterator(m_nearest+1);
+}
+
+const NearestIndexQuery& OctreeNearestIndexQuery::search()
+{
+    const auto& nodes   = m_octree->node_data();
+    const auto& indices = m_octree->index_data();
+    const auto& points  = m_octree->sorted_point_data();
+    const auto& point   = m_octree->point_data()[m_index];
+
+    m_stack.clear();
+    m_stack.push({0,0});
+
+    m_nearest = -1;
+    m_squared_distance = std::numeric_limits<Scalar>::max();
+
+    while(!m_stack.empty())
+    {
+        const IndexSquaredDistance qnode = m_stack.top();
+        m_stack.pop();
+        if(qnode.squared_distance >= m_squared_distance) continue;
+
+        const OctreeNode& node = nodes[qnode.index];
+        if(node.is_leaf())
+        {
+            for(Index pos=node.start; pos<node.end; ++pos)
+            {
+                if(indices[pos] == m_index) continue;
+                const Scalar d2 = (point - points[pos]).squaredNorm();
+                if(d2 < m_squared_distance)
+                {
+                    m_nearest = indices[pos];
+                    m_squared_distance = d2;
+                }
+            }
+        }
+        else
+        {
+            m_octree->push_children(m_stack, node, point, m_squared_distance, true);
+        }
+    }
+    return *this;
+}
+
+} // namespace pdpc
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <PDPC/SpacePartitioning/Query/NearestIndexQuery.h>
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeQuery.h>
+#include <PDPC/SpacePartitioning/Octree/Iterator/OctreeNearestIndexIterator.h>
+
+namespace pdpc {
+
+class OctreeNearestIndexQuery : public OctreeQuery,
+                                public NearestIndexQuery
+{
+public:
+    OctreeNearestIndexQuery();
+    OctreeNearestIndexQuery(const Octree* octree);
+    OctreeNearestIndexQuery(const Octree* octree, Index index);
+
+public:
+    OctreeNearestIndexIterator begin();
+    OctreeNearestIndexIterator end();
+
+public:
+    const NearestIndexQuery& search();
+};
+
+} // namespace pdpc
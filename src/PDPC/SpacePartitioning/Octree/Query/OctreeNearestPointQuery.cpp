@@ -0,0 +1,76 @@
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeNearestPointQuery.h>
+#include <PDPC/SpacePartitioning/Octree.h>
+
+#include <algorithm>
+
+namespace pdpc {
+
+OctreeNearestPointQuery::OctreeNearestPointQuery() :
+    OctreeQuery(),
+    NearestPointQuery()
+{
+}
+
+OctreeNearestPointQuery::OctreeNearestPointQuery(const Octree* octree) :
+    OctreeQuery(octree),
+    NearestPointQuery()
+{
+}
+
+OctreeNearestPointQuery::OctreeNearestPointQuery(const Octree* octree, const Vector3& point) :
+    OctreeQuery(octree),
+    NearestPointQuery(point)
+{
+}
+
+OctreeNearestPointIterator OctreeNearestPointQuery::begin()
+{
+    this->search();
+    return OctreeNearestPointIterator(m_nearest);
+}
+
+OctreeNearestPointIterator OctreeNearestPointQuery::end()
+{
+    return OctreeNearestPointIterator(m_nearest+1);
+}
+
+void OctreeNearestPointQuery::search()
+{
+    const auto& nodes   = m_octree->node_data();
+    const auto& indices = m_octree->index_data();
+    const auto& points  = m_octree->sorted_point_data();
+    const auto& point   = m_point;
+
+    m_stack.clear();
+    m_stack.push({0,0});
+
+    m_nearest = -1;
+    m_squared_distance = std::numeric_limits<Scalar>::max();
+
+    while(!m_stack.empty())
+    {
+        const IndexSquaredDistance qnode = m_stack.top();
+        m_stack.pop();
+        if(qnode.squared_distance >= m_squared_distance) continue;
+
+        const OctreeNode& node = nodes[qnode.index];
+        if(node.is_leaf())
+        {
+            for(Index pos=node.start; pos<node.end; ++pos)
+            {
+                const Scalar d2 = (point - points[pos]).squaredNorm();
+                if(d2 < m_squared_distance)
+                {
+                    m_nearest = indices[pos];
+                    m_squared_distance = d2;
+                }
+            }
+        }
+        else
+        {
+            m_octree->push_children(m_stack, node, point, m_squared_distance, true);
+        }
+    }
+}
+
+} // namespace pdpc
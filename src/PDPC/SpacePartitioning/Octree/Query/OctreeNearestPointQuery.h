@@ -0,0 +1,25 @@
+#pragma once
+
+#include <PDPC/SpacePartitioning/Query/NearestPointQuery.h>
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeQuery.h>
+#include <PDPC/SpacePartitioning/Octree/Iterator/OctreeNearestPointIterator.h>
+
+namespace pdpc {
+
+class OctreeNearestPointQuery : public OctreeQuery,
+                                public NearestPointQuery
+{
+public:
+    OctreeNearestPointQuery();
+    OctreeNearestPointQuery(const Octree* octree);
+    OctreeNearestPointQuery(const Octree* octree, const Vector3& point);
+
+public:
+    OctreeNearestPointIterator begin();
+    OctreeNearestPointIterator end();
+
+protected:
+    void search();
+};
+
+} // namespace pdpc
@@ -0,0 +1,15 @@
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeQuery.h>
+
+namespace pdpc {
+
+OctreeQuery::OctreeQuery() :
+    m_octree(nullptr)
+{
+}
+
+OctreeQuery::OctreeQuery(const Octree* octree) :
+    m_octree(octree)
+{
+}
+
+} // namespace pdpc
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <PDPC/SpacePartitioning/internal/IndexSquaredDistance.h>
+#include <PDPC/Common/Containers/static_stack.h>
+
+#define PDPC_OCTREE_MAX_DEPTH 21
+
+//! each node of a path pushes at most 8 children
+#define PDPC_OCTREE_STACK_SIZE (8*(PDPC_OCTREE_MAX_DEPTH+1))
+
+namespace pdpc {
+
+class Octree;
+
+class OctreeQuery
+{
+public:
+    OctreeQuery();
+    OctreeQuery(const Octree* octree);
+
+protected:
+    const Octree* m_octree;
+    static_stack<IndexSquaredDistance, PDPC_OCTREE_STACK_SIZE> m_stack;
+};
+
+} // namespace pdpc
@@ -0,0 +1,98 @@
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeRangeIndexQuery.h>
+#include <PDPC/SpacePartitioning/Octree.h>
+
+#include <algorithm>
+
+namespace pdpc {
+
+OctreeRangeIndexQuery::OctreeRangeIndexQuery() :
+    OctreeQuery(),
+    RangeIndexQuery()
+{
+}
+
+OctreeRangeIndexQuery::OctreeRangeIndexQuery(const Octree* octree) :
+    OctreeQuery(octree),
+    RangeIndexQuery()
+{
+}
+
+OctreeRangeIndexQuery::OctreeRangeIndexQuery(const Octree* octree, Scalar radius) :
+    OctreeQuery(octree),
+    RangeIndexQuery(radius)
+{
+}
+
+OctreeRangeIndexQuery::OctreeRangeIndexQuery(const Octree* octree, Scalar radius, Index index) :
+    OctreeQuery(octree),
+    RangeIndexQuery(radius, index)
+{
+}
+
+OctreeRangeIndexIterator OctreeRangeIndexQuery::begin()
+{
+    OctreeRangeIndexIterator it(this);
+    this->initialize(it);
+    this->advance(it);
+    return it;
+}
+
+OctreeRangeIndexIterator OctreeRangeIndexQuery::end()
+{
+    return OctreeRangeIndexIterator(this, m_octree->point_count());
+}
+
+void OctreeRangeIndexQuery::initialize(OctreeRangeIndexIterator& it)
+{
+    const auto& point = m_octree->point_data()[m_index];
+
+    m_stack.clear();
+    if(m_octree->node_data()[0].squared_distance(point) < m_squared_radius)
+        m_stack.push({0,0});
+    it.m_index = -1;
+    it.m_start = 0;
+    it.m_end   = 0;
+    it.m_squared_distance = 0;
+}
+
+void OctreeRangeIndexQuery::advance(OctreeRangeIndexIterator& it)
+{
+    const auto& nodes   = m_octree->node_data();
+    const auto& indices = m_octree->index_data();
+    const auto& points  = m_octree->sorted_point_data();
+    const auto& point   = m_octree->point_data()[m_index];
+
+    while(true)
+    {
+        // remaining points of the current leaf
+        while(it.m_start < it.m_end)
+        {
+            const Index  pos = it.m_start++;
+            const Scalar d2  = (point - points[pos]).squaredNorm();
+            if(d2 < m_squared_radius && indices[pos] != m_index)
+            {
+                it.m_index = indices[pos];
+                it.m_squared_distance = d2;
+                return;
+            }
+        }
+
+        if(m_stack.empty()) break;
+
+        const OctreeNode& node = nodes[m_stack.top().index];
+        m_stack.pop();
+        if(node.is_leaf())
+        {
+            it.m_start = node.start;
+            it.m_end   = node.end;
+        }
+        else
+        {
+            // in the Morton order
+            m_octree->push_children(m_stack, node, point, m_squared_radius, false);
+        }
+    }
+    it.m_index = m_octree->point_count();
+}
+
+} // namespace pdpc
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <PDPC/SpacePartitioning/Query/RangeIndexQuery.h>
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeQuery.h>
+#include <PDPC/SpacePartitioning/Octree/Iterator/OctreeRangeIndexIterator.h>
+
+namespace pdpc {
+
+class OctreeRangeIndexQuery : public OctreeQuery,
+                              public RangeIndexQuery
+{
+protected:
+    friend class OctreeRangeIndexIterator;
+
+public:
+    OctreeRangeIndexQuery();
+    OctreeRangeIndexQuery(const Octree* octree);
+    OctreeRangeIndexQuery(const Octree* octree, Scalar radius);
+    OctreeRangeIndexQuery(const Octree* octree, Scalar radius, Index index);
+
+public:
+    OctreeRangeIndexIterator begin();
+    OctreeRangeIndexIterator end();
+
+protected:
+    void initialize(OctreeRangeIndexIterator& iterator);
+    void advance(OctreeRangeIndexIterator& iterator);
+};
+
+} // namespace pdpc
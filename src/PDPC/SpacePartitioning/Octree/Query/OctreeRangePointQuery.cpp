@@ -0,0 +1,98 @@
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeRangePointQuery.h>
+#include <PDPC/SpacePartitioning/Octree.h>
+
+#include <algorithm>
+
+namespace pdpc {
+
+OctreeRangePointQuery::OctreeRangePointQuery() :
+    OctreeQuery(),
+    RangePointQuery()
+{
+}
+
+OctreeRangePointQuery::OctreeRangePointQuery(const Octree* octree) :
+    OctreeQuery(octree),
+    RangePointQuery()
+{
+}
+
+OctreeRangePointQuery::OctreeRangePointQuery(const Octree* octree, Scalar radius) :
+    OctreeQuery(octree),
+    RangePointQuery(radius)
+{
+}
+
+OctreeRangePointQuery::OctreeRangePointQuery(const Octree* octree, Scalar radius, const Vector3& point) :
+    OctreeQuery(octree),
+    RangePointQuery(radius, point)
+{
+}
+
+OctreeRangePointIterator OctreeRangePointQuery::begin()
+{
+    OctreeRangePointIterator it(this);
+    this->initialize(it);
+    this->advance(it);
+    return it;
+}
+
+OctreeRangePointIterator OctreeRangePointQuery::end()
+{
+    return OctreeRangePointIterator(this, m_octree->point_count());
+}
+
+void OctreeRangePointQuery::initialize(OctreeRangePointIterator& it)
+{
+    const auto& point = m_point;
+
+    m_stack.clear();
+    if(m_octree->node_data()[0].squared_distance(point) < m_squared_radius)
+        m_stack.push({0,0});
+    it.m_index = -1;
+    it.m_start = 0;
+    it.m_end   = 0;
+    it.m_squared_distance = 0;
+}
+
+void OctreeRangePointQuery::advance(OctreeRangePointIterator& it)
+{
+    const auto& nodes   = m_octree->node_data();
+    const auto& indices = m_octree->index_data();
+    const auto& points  = m_octree->sorted_point_data();
+    const auto& point   = m_point;
+
+    while(true)
+    {
+        // remaining points of the current leaf
+        while(it.m_start < it.m_end)
+        {
+            const Index  pos = it.m_start++;
+            const Scalar d2  = (point - points[pos]).squaredNorm();
+            if(d2 < m_squared_radius)
+            {
+                it.m_index = indices[pos];
+                it.m_squared_distance = d2;
+                return;
+            }
+        }
+
+        if(m_stack.empty()) break;
+
+        const OctreeNode& node = nodes[m_stack.top().index];
+        m_stack.pop();
+        if(node.is_leaf())
+        {
+            it.m_start = node.start;
+            it.m_end   = node.end;
+        }
+        else
+        {
+            // in the Morton order
+            m_octree->push_children(m_stack, node, point, m_squared_radius, false);
+        }
+    }
+    it.m_index = m_octree->point_count();
+}
+
+} // namespace pdpc
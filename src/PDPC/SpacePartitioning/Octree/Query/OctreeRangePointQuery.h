@@ -0,0 +1,30 @@
+#pragma once
+
+#include <PDPC/SpacePartitioning/Query/RangePointQuery.h>
+#include <PDPC/SpacePartitioning/Octree/Query/OctreeQuery.h>
+#include <PDPC/SpacePartitioning/Octree/Iterator/OctreeRangePointIterator.h>
+
+namespace pdpc {
+
+class OctreeRangePointQuery : public OctreeQuery,
+                              public RangePointQuery
+{
+protected:
+    friend class OctreeRangePointIterator;
+
+public:
+    OctreeRangePointQuery();
+    OctreeRangePointQuery(const Octree* octree);
+    OctreeRangePointQuery(const Octree* octree, Scalar radius);
+    OctreeRangePointQuery(const Octree* octree, Scalar radius, const Vector3& point);
+
+public:
+    OctreeRangePointIterator begin();
+    OctreeRangePointIterator end();
+
+protected:
+    void initialize(OctreeRangePointIterator& iterator);
+    void advance(OctreeRangePointIterator& iterator);
+};
+
+} // namespace pdpc
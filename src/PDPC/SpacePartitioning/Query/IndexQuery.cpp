@@ -7,17 +7,17 @@ IndexQuery::IndexQuery() :
 {
 }
 
-IndexQuery::IndexQuery(int index) :
+IndexQuery::IndexQuery(Index index) :
     m_index(index)
 {
 }
 
-int IndexQuery::index() const
+Index IndexQuery::index() const
 {
     return m_index;
 }
 
-void IndexQuery::set_index(int index)
+void IndexQuery::set_index(Index index)
 {
     m_index = index;
 }
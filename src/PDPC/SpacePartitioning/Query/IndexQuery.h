@@ -1,18 +1,20 @@
 #pragma once
 
+#include <PDPC/Common/Defines.h>
+
 namespace pdpc {
 
 class IndexQuery
 {
 public:
     IndexQuery();
-    IndexQuery(int index);
+    IndexQuery(Index index);
 
-    int index() const;
-    void set_index(int index);
+    Index index() const;
+    void set_index(Index index);
 
 protected:
-    int m_index;
+    Index m_index;
 };
 
 } // namespace pdpc
@@ -14,7 +14,7 @@ KNearestIndexQuery::KNearestIndexQuery(int k) :
 {
 }
 
-KNearestIndexQuery::KNearestIndexQuery(int k, int index) :
+KNearestIndexQuery::KNearestIndexQuery(int k, Index index) :
     IndexQuery(index),
     KNearestQuery(k)
 {
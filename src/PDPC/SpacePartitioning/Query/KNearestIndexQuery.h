@@ -11,7 +11,7 @@ class KNearestIndexQuery : public IndexQuery,
 public:
     KNearestIndexQuery();
     KNearestIndexQuery(int k);
-    KNearestIndexQuery(int k, int index);
+    KNearestIndexQuery(int k, Index index);
 };
 
 } // namespace pdpc
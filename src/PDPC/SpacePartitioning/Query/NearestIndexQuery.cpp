@@ -8,7 +8,7 @@ NearestIndexQuery::NearestIndexQuery() :
 {
 }
 
-NearestIndexQuery::NearestIndexQuery(int index) :
+NearestIndexQuery::NearestIndexQuery(Index index) :
     IndexQuery(index),
     NearestQuery()
 {
@@ -10,7 +10,7 @@ class NearestIndexQuery : public IndexQuery,
 {
 public:
     NearestIndexQuery();
-    NearestIndexQuery(int index);
+    NearestIndexQuery(Index index);
 };
 
 } // namespace pdpc
@@ -11,11 +11,11 @@ class NearestQuery
 public:
     NearestQuery(){}
 
-    int get() const{return m_nearest;}
+    Index get() const{return m_nearest;}
     Scalar distance() const {return std::sqrt(m_squared_distance);}
 
 protected:
-    int m_nearest;
+    Index m_nearest;
     Scalar m_squared_distance;
 };
 
@@ -14,7 +14,7 @@ RangeIndexQuery::RangeIndexQuery(Scalar radius) :
 {
 }
 
-RangeIndexQuery::RangeIndexQuery(Scalar radius, int index) :
+RangeIndexQuery::RangeIndexQuery(Scalar radius, Index index) :
     IndexQuery(index),
     RangeQuery(radius)
 {
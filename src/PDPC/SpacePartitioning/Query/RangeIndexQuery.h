@@ -11,7 +11,7 @@ class RangeIndexQuery : public IndexQuery,
 public:
     RangeIndexQuery();
     RangeIndexQuery(Scalar radius);
-    RangeIndexQuery(Scalar radius, int index);
+    RangeIndexQuery(Scalar radius, Index index);
 };
 
 } // namespace pdpc
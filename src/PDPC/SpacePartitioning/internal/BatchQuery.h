@@ -0,0 +1,68 @@
+#pragma once
+
+#include <PDPC/SpacePartitioning/NeighborLists.h>
+#include <PDPC/Common/Progress.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace pdpc {
+namespace internal {
+
+//!
+//! \brief batch_query fills the neighbor lists of query_count queries
+//!
+//! The queries are computed by blocks in parallel, each block appending its
+//! neighbors to its own arrays (see fill), which are then copied at their
+//! offset.
+//!
+template<class MakeQuery, class Fill>
+void batch_query(Index query_count, bool squared_distances, bool verbose,
+                 MakeQuery make_query, Fill fill, NeighborLists& lists)
+{
+    constexpr int block_size = 256;
+    const Index block_count = (query_count + block_size - 1) / block_size;
+
+    std::vector<std::vector<Index>>  block_indices(block_count);
+    std::vector<std::vector<Scalar>> block_distances(block_count);
+
+    auto& offsets = lists.offset_data();
+    offsets.assign(query_count + 1, 0);
+
+    auto prog = Progress(query_count, verbose);
+    #pragma omp parallel for schedule(dynamic)
+    for(Index b=0; b<block_count; ++b)
+    {
+        auto query = make_query();
+        const Index end = std::min(query_count, (b+1) * block_size);
+        for(Index q=b*block_size; q<end; ++q)
+        {
+            const std::size_t before = block_indices[b].size();
+            fill(query, q, block_indices[b], block_distances[b]);
+            offsets[q+1] = block_indices[b].size() - before;
+            ++prog;
+        }
+    }
+
+    for(Index q=0; q<query_count; ++q)
+        offsets[q+1] += offsets[q];
+
+    lists.index_data().resize(offsets.back());
+    lists.squared_distance_data().resize(squared_distances ? offsets.back() : 0);
+
+    #pragma omp parallel for
+    for(Index b=0; b<block_count; ++b)
+    {
+        const std::size_t start = offsets[b*block_size];
+        std::copy(block_indices[b].begin(), block_indices[b].end(), lists.index_data().begin() + start);
+        std::vector<Index>().swap(block_indices[b]);
+        if(squared_distances)
+        {
+            std::copy(block_distances[b].begin(), block_distances[b].end(), lists.squared_distance_data().begin() + start);
+            std::vector<Scalar>().swap(block_distances[b]);
+        }
+    }
+}
+
+} // namespace internal
+} // namespace pdpc
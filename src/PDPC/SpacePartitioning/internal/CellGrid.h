@@ -0,0 +1,133 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace pdpc {
+namespace internal {
+
+//!
+//! \brief The CellGrid struct maps the points of a bounding box to the cells
+//! of a uniform grid, whose coordinates are packed into 64-bit keys
+//!
+//! The coordinates have 21 bits each and z varies the fastest in the order
+//! of the keys, so that the cells of a row along z have consecutive keys.
+//! HashGrid and PoissonDiskSampling sort their points by key and find the
+//! points of a cell with cell_ranges.
+//!
+struct CellGrid
+{
+    static constexpr int cell_bits() {return 21;}
+    static constexpr int cell_max()  {return (1 << cell_bits()) - 1;}
+
+    CellGrid() = default;
+
+    //! \brief the cells are at least as large as size, with coordinates fitting the keys
+    inline CellGrid(const Aabb& aabb, Scalar size);
+
+    static inline std::uint64_t key(int x, int y, int z);
+    static inline Vector3i coords(std::uint64_t key);
+
+    //! \brief cell_of returns the coordinates of the cell containing point, clamped to the grid
+    inline Vector3i cell_of(const Vector3& point) const;
+    inline std::uint64_t key_of(const Vector3& point) const;
+
+    Vector3  origin    = Vector3::Zero();
+    Vector3i dims      = Vector3i::Zero(); //!< cell count along each axis
+    Scalar   cell_size = 0;
+};
+
+//! \brief bounding_box computes the bounding box of the points of sampling in parallel
+template<class IndexT>
+Aabb bounding_box(const Vector3Array& points, const std::vector<IndexT>& sampling);
+
+//!
+//! \brief cell_ranges finds the non-empty cells of entries sorted by key:
+//! the cell c has the key keys[c] and holds the entries [starts[c], starts[c+1])
+//!
+template<class EntryT, class IndexT>
+void cell_ranges(const std::vector<EntryT>& entries, std::vector<std::uint64_t>& keys, std::vector<IndexT>& starts);
+
+// CellGrid --------------------------------------------------------------------
+
+CellGrid::CellGrid(const Aabb& aabb, Scalar size) :
+    origin(aabb.min()),
+    dims(Vector3i::Zero()),
+    cell_size(std::max(size, aabb.sizes().maxCoeff() / Scalar(cell_max() - 1)))
+{
+    for(int k=0; k<3; ++k)
+        dims[k] = std::min(int(aabb.sizes()[k] / cell_size), cell_max()) + 1;
+}
+
+std::uint64_t CellGrid::key(int x, int y, int z)
+{
+    return (std::uint64_t(x) << (2*cell_bits())) | (std::uint64_t(y) << cell_bits()) | std::uint64_t(z);
+}
+
+Vector3i CellGrid::coords(std::uint64_t key)
+{
+    return Vector3i(int((key >> (2*cell_bits())) & cell_max()),
+                    int((key >> cell_bits()) & cell_max()),
+                    int(key & cell_max()));
+}
+
+Vector3i CellGrid::cell_of(const Vector3& point) const
+{
+    const Vector3 c = (point - origin) / cell_size;
+
+    Vector3i cell;
+    for(int k=0; k<3; ++k)
+        cell[k] = c[k] <= 0 ? 0 : c[k] >= dims[k] - 1 ? dims[k] - 1 : int(c[k]);
+    return cell;
+}
+
+std::uint64_t CellGrid::key_of(const Vector3& point) const
+{
+    const Vector3i c = this->cell_of(point);
+    return key(c.x(), c.y(), c.z());
+}
+
+// Functions -------------------------------------------------------------------
+
+template<class IndexT>
+Aabb bounding_box(const Vector3Array& points, const std::vector<IndexT>& sampling)
+{
+    const IndexT size = sampling.size();
+
+    Aabb aabb;
+    #pragma omp parallel
+    {
+        Aabb local;
+        #pragma omp for nowait
+        for(IndexT n=0; n<size; ++n)
+            local.extend(points[sampling[n]]);
+
+        #pragma omp critical (CellGrid_bounding_box)
+        aabb.extend(local);
+    }
+    return aabb;
+}
+
+template<class EntryT, class IndexT>
+void cell_ranges(const std::vector<EntryT>& entries, std::vector<std::uint64_t>& keys, std::vector<IndexT>& starts)
+{
+    const IndexT size = entries.size();
+
+    keys.clear();
+    starts.clear();
+    for(IndexT n=0; n<size; ++n)
+    {
+        if(n == 0 || entries[n].key != entries[n-1].key)
+        {
+            keys.push_back(entries[n].key);
+            starts.push_back(n);
+        }
+    }
+    starts.push_back(size);
+}
+
+} // namespace internal
+} // namespace pdpc
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <PDPC/Common/Defines.h>
+
 namespace pdpc {
 
 struct IndexSquaredDistance
 {
-    int index;
+    Index index;
     float squared_distance;
 
     bool operator < (const IndexSquaredDistance& other) const;
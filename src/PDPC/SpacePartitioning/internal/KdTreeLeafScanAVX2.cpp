@@ -0,0 +1,61 @@
+#include <PDPC/SpacePartitioning/internal/KdTreeLeafScanImpl.h>
+
+#ifdef PDPC_SIMD_X86
+
+#include <immintrin.h>
+
+// without fma, so that the squared distances are rounded as the scalar ones
+#define PDPC_TARGET_AVX2 __attribute__((target("avx2")))
+
+namespace pdpc {
+namespace internal {
+
+PDPC_TARGET_AVX2 int kdtree_leaf_scan_avx2(const KdTreeLeafScanArgs& a, int* positions, Scalar* squared_distances)
+{
+    const __m256 qx    = _mm256_set1_ps(a.qx);
+    const __m256 qy    = _mm256_set1_ps(a.qy);
+    const __m256 qz    = _mm256_set1_ps(a.qz);
+    const __m256 bound = _mm256_set1_ps(a.squared_bound);
+
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i end  = _mm256_set1_epi32(a.end);
+
+    alignas(32) Scalar d2s[8];
+    int count = 0;
+
+    for(int i=a.start; i<a.end; i+=8)
+    {
+        const __m256 dx = _mm256_sub_ps(qx, _mm256_loadu_ps(a.xs + i));
+        const __m256 dy = _mm256_sub_ps(qy, _mm256_loadu_ps(a.ys + i));
+        const __m256 dz = _mm256_sub_ps(qz, _mm256_loadu_ps(a.zs + i));
+
+        // same summation order as Eigen's squaredNorm of a Vector3
+        const __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx),
+                                        _mm256_add_ps(_mm256_mul_ps(dy, dy), _mm256_mul_ps(dz, dz)));
+
+        const __m256i idx   = _mm256_add_epi32(lane, _mm256_set1_epi32(i));
+        const __m256  valid = _mm256_castsi256_ps(_mm256_cmpgt_epi32(end, idx));
+        int mask = _mm256_movemask_ps(_mm256_and_ps(valid, _mm256_cmp_ps(d2, bound, _CMP_LT_OQ)));
+        if(mask == 0) continue;
+
+        // compaction of the hits
+        _mm256_store_ps(d2s, d2);
+        while(mask != 0)
+        {
+            const int l = __builtin_ctz(mask);
+            mask &= mask - 1;
+            positions[count]         = i + l;
+            squared_distances[count] = d2s[l];
+            ++count;
+        }
+    }
+
+    // avoid the penalty of the dirty upper state in the non-VEX caller
+    _mm256_zeroupper();
+    return count;
+}
+
+} // namespace internal
+} // namespace pdpc
+
+#endif // PDPC_SIMD_X86
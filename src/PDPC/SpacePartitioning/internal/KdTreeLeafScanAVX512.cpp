@@ -0,0 +1,53 @@
+#include <PDPC/SpacePartitioning/internal/KdTreeLeafScanImpl.h>
+#include <PDPC/Common/internal/SimdAVX512.h>
+
+#ifdef PDPC_SIMD_X86
+
+namespace pdpc {
+namespace internal {
+
+PDPC_TARGET_AVX512 int kdtree_leaf_scan_avx512(const KdTreeLeafScanArgs& a, int* positions, Scalar* squared_distances)
+{
+    const __m512 qx    = _mm512_set1_ps(a.qx);
+    const __m512 qy    = _mm512_set1_ps(a.qy);
+    const __m512 qz    = _mm512_set1_ps(a.qz);
+    const __m512 bound = _mm512_set1_ps(a.squared_bound);
+
+    const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    int count = 0;
+
+    for(int i=a.start; i<a.end; i+=16)
+    {
+        const __m512 dx = _mm512_sub_ps(qx, _mm512_loadu_ps(a.xs + i));
+        const __m512 dy = _mm512_sub_ps(qy, _mm512_loadu_ps(a.ys + i));
+        const __m512 dz = _mm512_sub_ps(qz, _mm512_loadu_ps(a.zs + i));
+
+        // same summation order as Eigen's squaredNorm of a Vector3, without fma
+        // (zero-masked forms, see avx512_all_lanes)
+        constexpr int rounding = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+        const __m512 dy2 = _mm512_maskz_mul_round_ps(avx512_all_lanes, dy, dy, rounding);
+        const __m512 dz2 = _mm512_maskz_mul_round_ps(avx512_all_lanes, dz, dz, rounding);
+        const __m512 dx2 = _mm512_maskz_mul_round_ps(avx512_all_lanes, dx, dx, rounding);
+        const __m512 d2  = _mm512_maskz_add_round_ps(avx512_all_lanes, dx2,
+                                                     _mm512_maskz_add_round_ps(avx512_all_lanes, dy2, dz2, rounding), rounding);
+
+        const __mmask16 valid = a.end - i >= 16 ? __mmask16(0xFFFF) : __mmask16((1u << (a.end - i)) - 1);
+        const __mmask16 mask  = _mm512_mask_cmp_ps_mask(valid, d2, bound, _CMP_LT_OQ);
+        if(mask == 0) continue;
+
+        // compaction of the hits
+        _mm512_mask_compressstoreu_epi32(positions + count, mask, _mm512_add_epi32(lane, _mm512_set1_epi32(i)));
+        _mm512_mask_compressstoreu_ps(squared_distances + count, mask, d2);
+        count += __builtin_popcount(mask);
+    }
+
+    // avoid the penalty of the dirty upper state in the non-VEX caller
+    _mm256_zeroupper();
+    return count;
+}
+
+} // namespace internal
+} // namespace pdpc
+
+#endif // PDPC_SIMD_X86
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+#include <PDPC/Common/Cpu.h>
+
+namespace pdpc {
+namespace internal {
+
+// plain arguments shared by the kernels compiled for each instruction set
+struct KdTreeLeafScanArgs
+{
+    const Scalar* xs;
+    const Scalar* ys;
+    const Scalar* zs;
+    int start; // positions relative to xs, ys and zs, which are readable up
+    int end;   // to end + KdTree::leaf_padding()
+
+    Scalar qx, qy, qz;
+    Scalar squared_bound;
+};
+
+// the kernels return the count of positions and squared distances written
+// (at most end - start)
+int kdtree_leaf_scan_scalar(const KdTreeLeafScanArgs& args, int* positions, Scalar* squared_distances);
+
+#ifdef PDPC_SIMD_X86
+int kdtree_leaf_scan_avx2(  const KdTreeLeafScanArgs& args, int* positions, Scalar* squared_distances);
+int kdtree_leaf_scan_avx512(const KdTreeLeafScanArgs& args, int* positions, Scalar* squared_distances);
+#endif
+
+} // namespace internal
+} // namespace pdpc
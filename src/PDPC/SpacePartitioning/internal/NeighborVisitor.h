@@ -0,0 +1,27 @@
+#pragma once
+
+#include <PDPC/Common/Defines.h>
+
+#include <type_traits>
+
+namespace pdpc {
+namespace internal {
+
+// a visitor returning void always continues
+template<class VisitorT>
+inline auto visit_neighbor(VisitorT& f, Index index, Scalar squared_distance)
+    -> typename std::enable_if<std::is_void<decltype(f(index, squared_distance))>::value, bool>::type
+{
+    f(index, squared_distance);
+    return true;
+}
+
+template<class VisitorT>
+inline auto visit_neighbor(VisitorT& f, Index index, Scalar squared_distance)
+    -> typename std::enable_if<!std::is_void<decltype(f(index, squared_distance))>::value, bool>::type
+{
+    return f(index, squared_distance);
+}
+
+} // namespace internal
+} // namespace pdpc